@@ -0,0 +1,1176 @@
+#include "memoria.h"
+#include "processo.h"
+#include "substituicao.h"
+#include "conjunto_trabalho.h"
+#include "compactacao.h"
+#include "deduplicacao.h"
+#include "cache_comprimido.h"
+#include "carga.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// Mede o tempo de parede em segundos
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Memória residente do processo hospedeiro em bytes (Linux, via /proc)
+static long long memoria_residente(void) {
+    long long paginas_total = 0, paginas_residentes = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) {
+        return 0;
+    }
+    if (fscanf(f, "%lld %lld", &paginas_total, &paginas_residentes) != 2) {
+        paginas_residentes = 0;
+    }
+    fclose(f);
+    return paginas_residentes * sysconf(_SC_PAGESIZE);
+}
+
+// Caminho antigo de cópia: um escrever_na_memoria por byte de cada página
+static void copiar_byte_a_byte(MemoriaFisica *mf, Processo *processo) {
+    for (int pagina = 0; pagina < processo->num_paginas; pagina++) {
+        size_t endereco_fisico_base = (size_t)entrada_quadro(*buscar_entrada_pagina(&processo->tabela_paginas, pagina)) * mf->tamanho_pagina;
+        size_t endereco_logico_base = (size_t)pagina * mf->tamanho_pagina;
+        size_t bytes_para_copiar = mf->tamanho_pagina;
+        if (endereco_logico_base + bytes_para_copiar > processo->tamanho) {
+            bytes_para_copiar = processo->tamanho - endereco_logico_base;
+        }
+        for (size_t i = 0; i < bytes_para_copiar; i++) {
+            escrever_na_memoria(mf, endereco_fisico_base + i, processo->memoria_logica[endereco_logico_base + i]);
+        }
+    }
+}
+
+/**
+ * @brief Compara a cópia da memória lógica para a física byte a byte com a
+ * cópia por páginas (escrever_pagina com sequências de quadros adjacentes).
+ */
+static void benchmark_copia(int tamanho_mb, int tamanho_pagina_kb, int tamanho_processo, int repeticoes) {
+    MemoriaFisica *mf = criar_memoria_fisica(tamanho_mb, tamanho_pagina_kb);
+    if (!mf) {
+        return;
+    }
+    inicializar_memoria_fisica(mf);
+
+    GerenciadorProcessos gp;
+    inicializar_gerenciador_processos(&gp);
+    if (criar_processo(&gp, mf, 1, tamanho_processo, mf->tamanho_pagina, tamanho_processo) == -1) {
+        destruir_memoria_fisica(mf);
+        return;
+    }
+    Processo *processo = encontrar_processo(&gp, 1);
+
+    double inicio = agora_s();
+    for (int r = 0; r < repeticoes; r++) {
+        copiar_byte_a_byte(mf, processo);
+    }
+    double tempo_byte = (agora_s() - inicio) / repeticoes;
+
+    inicio = agora_s();
+    for (int r = 0; r < repeticoes; r++) {
+        copiar_memoria_logica_para_fisica(&gp, mf, 1);
+    }
+    double tempo_pagina = (agora_s() - inicio) / repeticoes;
+
+    // Confere se a imagem física corresponde à lógica
+    int iguais = 1;
+    for (int pagina = 0; pagina < processo->num_paginas && iguais; pagina++) {
+        size_t base = (size_t)pagina * mf->tamanho_pagina;
+        size_t bytes = processo->tamanho - base < (size_t)mf->tamanho_pagina ? processo->tamanho - base : (size_t)mf->tamanho_pagina;
+        iguais = memcmp(mf->memoria + (size_t)entrada_quadro(*buscar_entrada_pagina(&processo->tabela_paginas, pagina)) * mf->tamanho_pagina,
+                        processo->memoria_logica + base, bytes) == 0;
+    }
+
+    double mb = tamanho_processo / (1024.0 * 1024.0);
+    printf("\n=== BENCHMARK DE COPIA (%d bytes, pagina de %d KB) ===\n", tamanho_processo, tamanho_pagina_kb);
+    printf("Byte a byte : %10.3f ms (%8.1f MB/s)\n", tempo_byte * 1e3, mb / tempo_byte);
+    printf("Por paginas : %10.3f ms (%8.1f MB/s)\n", tempo_pagina * 1e3, mb / tempo_pagina);
+    printf("Ganho       : %10.1fx\n", tempo_byte / tempo_pagina);
+    printf("Conteudo    : %s\n", iguais ? "identico" : "DIVERGENTE");
+
+    remover_processo(&gp, mf, 1);
+    destruir_memoria_fisica(mf);
+}
+
+/**
+ * @brief Compara as representações de tabela de páginas em um espaço esparso:
+ * memória ocupada e latência de busca para cada representação.
+ */
+static void benchmark_tabelas(int num_paginas, int passo, int buscas) {
+    // Mapeia regiões de REGIAO_PAGINAS páginas contíguas a cada `passo` páginas
+    const int REGIAO_PAGINAS = 16;
+    printf("\n=== BENCHMARK DE TABELAS DE PAGINAS (%d paginas, %d mapeadas a cada %d) ===\n",
+           num_paginas, REGIAO_PAGINAS, passo);
+    for (int tipo = TABELA_LINEAR; tipo <= TABELA_INVERTIDA; tipo++) {
+        TabelaInvertida *invertida = tipo == TABELA_INVERTIDA ? criar_tabela_invertida() : NULL;
+        TabelaPaginas tabela;
+        if (!criar_tabela_paginas(&tabela, (TipoTabelaPaginas)tipo, num_paginas, invertida, 1)) {
+            printf("Erro: Falha ao criar tabela %s.\n", nome_tipo_tabela_paginas((TipoTabelaPaginas)tipo));
+            destruir_tabela_invertida(invertida);
+            continue;
+        }
+
+        int mapeadas = 0;
+        for (int regiao = 0; regiao < num_paginas; regiao += passo) {
+            for (int k = 0; k < REGIAO_PAGINAS; k++) {
+                EntradaTabelaPagina *entrada = obter_entrada_pagina(&tabela, regiao + k);
+                entrada_definir_quadro(entrada, mapeadas++);
+                entrada_ativar(entrada, TP_PRESENTE);
+            }
+        }
+
+        long long soma = 0;
+        double inicio = agora_s();
+        for (int b = 0; b < buscas; b++) {
+            int m = (int)(((unsigned)b * 2654435761u) % (unsigned)mapeadas);
+            int pagina = m / REGIAO_PAGINAS * passo + m % REGIAO_PAGINAS;
+            soma += entrada_quadro(*buscar_entrada_pagina(&tabela, pagina));
+        }
+        double tempo = agora_s() - inicio;
+
+        size_t bytes = bytes_tabela_paginas(&tabela) + (invertida ? bytes_tabela_invertida(invertida) : 0);
+        printf("%-16s: %10zu bytes, %6.1f ns/busca (soma %lld)\n",
+               nome_tipo_tabela_paginas((TipoTabelaPaginas)tipo), bytes, tempo * 1e9 / buscas, soma);
+
+        destruir_tabela_paginas(&tabela);
+        destruir_tabela_invertida(invertida);
+    }
+}
+
+/**
+ * @brief Mede criação, busca e remoção de processos conforme o número de
+ * processos ativos cresce. Os processos são criados sob demanda, sem quadros.
+ */
+static void benchmark_processos(int max_processos) {
+    MemoriaFisica *mf = criar_memoria_fisica(1, 4);
+    if (!mf) {
+        return;
+    }
+    inicializar_memoria_fisica(mf);
+
+    printf("\n=== BENCHMARK DA TABELA DE PROCESSOS ===\n");
+    printf("%9s | %12s | %12s | %12s\n", "Processos", "Criar (ns)", "Buscar (ns)", "Remover (ns)");
+    for (int n = 10; n <= max_processos; n *= 10) {
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        definir_paginacao_sob_demanda(&gp, 1);
+
+        double inicio = agora_s();
+        for (int i = 0; i < n; i++) {
+            criar_processo(&gp, mf, i * 7 + 1, 64, mf->tamanho_pagina, 64);
+        }
+        double tempo_criar = agora_s() - inicio;
+
+        int buscas = 1 << 20;
+        long long encontrados = 0;
+        inicio = agora_s();
+        for (int b = 0; b < buscas; b++) {
+            int i = (int)(((unsigned)b * 2654435761u) % (unsigned)n);
+            encontrados += encontrar_processo(&gp, i * 7 + 1) != NULL;
+        }
+        double tempo_buscar = agora_s() - inicio;
+
+        inicio = agora_s();
+        for (int i = 0; i < n; i++) {
+            remover_processo(&gp, mf, i * 7 + 1);
+        }
+        double tempo_remover = agora_s() - inicio;
+        finalizar_gerenciador_processos(&gp, mf);
+
+        printf("%9d | %12.1f | %12.1f | %12.1f%s\n", n, tempo_criar * 1e9 / n, tempo_buscar * 1e9 / buscas,
+               tempo_remover * 1e9 / n, encontrados == buscas ? "" : " (BUSCA FALHOU)");
+    }
+
+    destruir_memoria_fisica(mf);
+}
+
+/**
+ * @brief Compara a memória do hospedeiro ocupada por processos com memória
+ * lógica própria e com imagens sem cópia, criados até encher a memória física.
+ */
+static void benchmark_imagens(int tamanho_mb, int tamanho_pagina_kb, int num_processos) {
+    printf("\n=== BENCHMARK DE IMAGENS (%d processos em %d MB) ===\n", num_processos, tamanho_mb);
+    for (int sem_copia = 0; sem_copia <= 1; sem_copia++) {
+        long long antes = memoria_residente();
+        MemoriaFisica *mf = criar_memoria_fisica(tamanho_mb, tamanho_pagina_kb);
+        if (!mf) {
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        definir_imagens_sem_copia(&gp, sem_copia);
+
+        int tamanho_processo = mf->numero_quadros / num_processos * mf->tamanho_pagina;
+        int criados = 0;
+        for (int i = 1; i <= num_processos; i++) {
+            criados += criar_processo(&gp, mf, i, tamanho_processo, mf->tamanho_pagina, tamanho_processo) != -1;
+        }
+        long long depois = memoria_residente();
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+
+        printf("%-18s: %d processos, %8.1f MB residentes (%6.2f MB por processo de %.2f MB)\n",
+               sem_copia ? "Imagens sem copia" : "Com memoria logica", criados,
+               (depois - antes) / (1024.0 * 1024.0), (depois - antes) / (1024.0 * 1024.0) / (criados ? criados : 1),
+               tamanho_processo / (1024.0 * 1024.0));
+    }
+}
+
+/**
+ * @brief Mede o tempo de criar e inicializar a memória física para tamanhos
+ * crescentes; com a área mapeada sob demanda ele não deve crescer com o tamanho.
+ */
+static void benchmark_inicializacao(int tamanho_pagina_kb) {
+    printf("\n=== BENCHMARK DE INICIALIZACAO DA MEMORIA ===\n");
+    for (int tamanho_mb = 64; tamanho_mb <= 1024; tamanho_mb *= 4) {
+        double inicio = agora_s();
+        MemoriaFisica *mf = criar_memoria_fisica(tamanho_mb, tamanho_pagina_kb);
+        if (mf) {
+            inicializar_memoria_fisica(mf);
+        }
+        double tempo = agora_s() - inicio;
+        destruir_memoria_fisica(mf);
+        printf("%5d MB: %8.3f ms\n", tamanho_mb, tempo * 1e3);
+    }
+}
+
+/**
+ * @brief Confere endereços além de 2^31 e 2^32 em uma memória física de 5 GB
+ * (mapeada sob demanda) e em um processo sem cópia com mais de 4 GB.
+ */
+static void verificar_enderecos_64_bits(void) {
+    const size_t limites[] = {(1ULL << 31) - 1, 1ULL << 31, (1ULL << 32) - 1, 1ULL << 32, (1ULL << 32) + 1};
+    const int num_limites = (int)(sizeof(limites) / sizeof(limites[0]));
+
+    printf("\n=== VERIFICACAO DE ENDERECOS DE 64 BITS ===\n");
+    MemoriaFisica *mf = criar_memoria_fisica(5 * 1024, 4);
+    if (!mf) {
+        printf("Memoria de 5 GB indisponivel; verificacao ignorada.\n");
+        return;
+    }
+    inicializar_memoria_fisica(mf);
+
+    // Bytes isolados nos limites
+    int fisica_ok = 1;
+    for (int i = 0; i < num_limites; i++) {
+        escrever_na_memoria(mf, limites[i], (unsigned char)(0xA0 + i));
+    }
+    for (int i = 0; i < num_limites; i++) {
+        fisica_ok &= ler_da_memoria(mf, limites[i]) == (unsigned char)(0xA0 + i);
+    }
+
+    // Sequência de quadros que atravessa 2^32
+    int quadro_limite = (int)((1ULL << 32) / mf->tamanho_pagina);
+    size_t bytes = 4 * (size_t)mf->tamanho_pagina;
+    unsigned char *origem = (unsigned char*)malloc(bytes);
+    unsigned char *destino = (unsigned char*)malloc(bytes);
+    if (origem && destino) {
+        for (size_t i = 0; i < bytes; i++) {
+            origem[i] = (unsigned char)(i * 31 + 7);
+        }
+        fisica_ok &= escrever_pagina(mf, quadro_limite - 2, origem, bytes);
+        fisica_ok &= ler_pagina(mf, quadro_limite - 2, destino, bytes);
+        fisica_ok &= memcmp(origem, destino, bytes) == 0;
+    } else {
+        fisica_ok = 0;
+    }
+    printf("Memoria fisica (2^31, 2^32)    : %s\n", fisica_ok ? "ok" : "FALHOU");
+
+    // Processo de 4 GB + 64 KB com imagem sem cópia, carregado sob demanda
+    GerenciadorProcessos gp;
+    inicializar_gerenciador_processos(&gp);
+    definir_paginacao_sob_demanda(&gp, 1);
+    definir_imagens_sem_copia(&gp, 1);
+    size_t tamanho_processo = (1ULL << 32) + 64 * 1024;
+    int criado = criar_processo(&gp, mf, 1, tamanho_processo, mf->tamanho_pagina, tamanho_processo) != -1;
+
+    int logica_ok = criado;
+    if (criado) {
+        Processo *processo = encontrar_processo(&gp, 1);
+        for (int i = 0; i < num_limites; i++) {
+            unsigned char esperado;
+            gerar_dados_aleatorios_intervalo(processo, &esperado, limites[i], 1);
+            logica_ok &= ler_logico(&gp, mf, 1, limites[i]) == esperado;
+        }
+        for (int i = 0; i < num_limites; i++) {
+            logica_ok &= escrever_logico(&gp, mf, 1, limites[i], (unsigned char)(0x50 + i));
+        }
+        for (int i = 0; i < num_limites; i++) {
+            logica_ok &= ler_logico(&gp, mf, 1, limites[i]) == (unsigned char)(0x50 + i);
+        }
+        logica_ok &= traduzir_endereco(&gp, mf, 1, tamanho_processo) == -1;
+    }
+    printf("Processo de %.0f MB (2^31, 2^32): %s\n", tamanho_processo / (1024.0 * 1024.0), logica_ok ? "ok" : "FALHOU");
+
+    finalizar_gerenciador_processos(&gp, mf);
+    free(origem);
+    free(destino);
+    destruir_memoria_fisica(mf);
+}
+
+/**
+ * @brief Confere que memórias com até TP_SEM_QUADRO - 1 quadros são criadas e
+ * que as maiores são recusadas. O tamanho é dado em MB, então com páginas de
+ * 1 KB o número de quadros anda de 1024 em 1024; os tamanhos exatos do limite
+ * usam páginas de 512 KB e 1 MB. As memórias são mapeadas sob demanda e não
+ * são tocadas, então só o mapa de quadros e os contadores ocupam memória.
+ */
+static void verificar_limite_quadros(void) {
+    const int tamanhos_mb[] = {TP_SEM_QUADRO / 1024, TP_SEM_QUADRO / 1024 + 1,
+                               (TP_SEM_QUADRO - 1) / 2, TP_SEM_QUADRO};
+    const int paginas_kb[] = {1, 1, 512, 1024};
+    const int num_casos = (int)(sizeof(tamanhos_mb) / sizeof(tamanhos_mb[0]));
+
+    printf("\n=== VERIFICACAO DO LIMITE DE QUADROS (TP_SEM_QUADRO = %u) ===\n", TP_SEM_QUADRO);
+    for (int i = 0; i < num_casos; i++) {
+        long long quadros = (long long)tamanhos_mb[i] * 1024 / paginas_kb[i];
+        int deve_criar = quadros < TP_SEM_QUADRO;
+        MemoriaFisica *mf = criar_memoria_fisica(tamanhos_mb[i], paginas_kb[i]);
+        int ok = (mf != NULL) == deve_criar && (!mf || mf->numero_quadros == quadros);
+        printf("%8d MB, paginas de %4d KB: %9lld quadros, %-8s: %s\n", tamanhos_mb[i], paginas_kb[i], quadros,
+               mf ? "criada" : "recusada", ok ? "ok" : "FALHOU");
+        destruir_memoria_fisica(mf);
+    }
+}
+
+/**
+ * @brief Executa uma carga sintética e grava uma linha CSV com o tempo de cada
+ * subsistema: alocação de quadros, tabelas de páginas, geração, cópia e tradução.
+ */
+static void executar_carga(FILE *csv, const ConfiguracaoCarga *config, int tamanho_mb,
+                           int tamanho_pagina_kb, int sob_demanda, long long num_operacoes) {
+    MemoriaFisica *mf = criar_memoria_fisica(tamanho_mb, tamanho_pagina_kb);
+    GeradorCarga gerador;
+    if (!mf || !criar_gerador_carga(&gerador, config)) {
+        destruir_memoria_fisica(mf);
+        return;
+    }
+    inicializar_memoria_fisica(mf);
+    GerenciadorProcessos gp;
+    inicializar_gerenciador_processos(&gp);
+    definir_paginacao_sob_demanda(&gp, sob_demanda);
+    definir_politica_substituicao(obter_substituidor(&gp, mf), SUBSTITUICAO_CLOCK);
+    configurar_tlb(&gp, 64, 4, 0);
+
+    long long tempo_tipo_ns[NUM_TIPOS_OPERACAO] = {0};
+    long long operacoes_tipo[NUM_TIPOS_OPERACAO] = {0};
+    long long falhas = 0;
+    double inicio = agora_s();
+    for (long long i = 0; i < num_operacoes; i++) {
+        OperacaoCarga operacao;
+        proxima_operacao_carga(&gerador, &operacao);
+        double inicio_operacao = agora_s();
+        falhas += !executar_operacao(&gp, mf, operacao.tipo, operacao.pid, operacao.argumento,
+                                     operacao.valor, config->tamanho_processo);
+        tempo_tipo_ns[operacao.tipo] += (long long)((agora_s() - inicio_operacao) * 1e9);
+        operacoes_tipo[operacao.tipo]++;
+    }
+    double tempo = agora_s() - inicio;
+
+    // A tradução é o tempo dos acessos descontado o tratamento das faltas de página
+    long long acessos = operacoes_tipo[OP_LER] + operacoes_tipo[OP_ESCREVER];
+    double acesso_ms = (tempo_tipo_ns[OP_LER] + tempo_tipo_ns[OP_ESCREVER]) / 1e6;
+    EstatisticasProcessos *e = &gp.estatisticas;
+    Substituidor *s = gp.substituicao;
+    fprintf(csv, "%s,%d,%s,%.4f,%lld,%lld,%.4f,%.1f,%.1f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld,%lld,%lld\n",
+            nome_distribuicao_acesso(config->distribuicao), tamanho_pagina_kb,
+            sob_demanda ? "demanda" : "antecipada", config->taxa_rotatividade, num_operacoes, falhas, tempo,
+            num_operacoes / tempo, acessos ? acesso_ms * 1e6 / acessos : 0.0,
+            tempo_tipo_ns[OP_CRIAR] / 1e6, tempo_tipo_ns[OP_REMOVER] / 1e6,
+            mf->estatisticas.tempo_total_ns / 1e6, e->tempo_tabela_ns / 1e6, e->tempo_geracao_ns / 1e6,
+            e->tempo_copia_ns / 1e6, e->tempo_faltas_ns / 1e6, acesso_ms - e->tempo_faltas_ns / 1e6,
+            gp.total_faltas_pagina, s->despejos, s->writebacks);
+    printf("%-10s %3d KB %-10s rot %.3f: %10.0f ops/s, %8.1f ns/acesso, %7lld faltas\n",
+           nome_distribuicao_acesso(config->distribuicao), tamanho_pagina_kb,
+           sob_demanda ? "demanda" : "antecipada", config->taxa_rotatividade, num_operacoes / tempo,
+           acessos ? acesso_ms * 1e6 / acessos : 0.0, gp.total_faltas_pagina);
+
+    finalizar_gerenciador_processos(&gp, mf);
+    destruir_memoria_fisica(mf);
+    destruir_gerador_carga(&gerador);
+}
+
+/**
+ * @brief Executa a matriz de cargas sintéticas (distribuição x tamanho de página x
+ * carregamento/rotatividade) e grava os resultados em CSV, um cenário por linha.
+ * Os processos somam o dobro da memória física, forçando faltas e despejos.
+ */
+static void benchmark_cargas(const char *arquivo_csv, int tamanho_mb, long long num_operacoes) {
+    FILE *csv = fopen(arquivo_csv, "w");
+    if (!csv) {
+        printf("Erro: Nao foi possivel criar o arquivo %s.\n", arquivo_csv);
+        return;
+    }
+    fprintf(csv, "distribuicao,pagina_kb,carregamento,rotatividade,operacoes,falhas,tempo_s,ops_por_segundo,"
+                 "ns_por_acesso,criar_ms,remover_ms,alocacao_ms,tabela_ms,geracao_ms,copia_ms,faltas_ms,"
+                 "traducao_ms,faltas_pagina,despejos,writebacks\n");
+
+    const int paginas_kb[] = {4, 16, 64};
+    // Cenários: sob demanda sem rotatividade, sob demanda com rotatividade e carregamento antecipado com rotatividade
+    const int cenarios_demanda[] = {1, 1, 0};
+    const double cenarios_rotatividade[] = {0.0, 0.001, 0.001};
+
+    printf("\n=== BENCHMARK DE CARGAS SINTETICAS (%lld operacoes, %d MB) ===\n", num_operacoes, tamanho_mb);
+    for (int p = 0; p < 3; p++) {
+        for (int d = ACESSO_UNIFORME; d <= ACESSO_SEQUENCIAL; d++) {
+            for (int c = 0; c < 3; c++) {
+                ConfiguracaoCarga config;
+                config.distribuicao = (DistribuicaoAcesso)d;
+                config.expoente_zipf = 0.99;
+                config.passo_sequencial = 64;
+                config.num_processos = 16;
+                config.tamanho_processo = (size_t)tamanho_mb * 1024 * 1024 * 2 / config.num_processos;
+                config.tamanho_pagina = paginas_kb[p] * 1024;
+                config.fracao_escritas = 0.3;
+                config.taxa_rotatividade = cenarios_rotatividade[c];
+                config.semente = 42;
+                executar_carga(csv, &config, tamanho_mb, paginas_kb[p], cenarios_demanda[c], num_operacoes);
+            }
+        }
+    }
+    fclose(csv);
+    printf("Resultados gravados em %s\n", arquivo_csv);
+}
+
+// Processos mantidos vivos por thread no benchmark de concorrência
+#define PROCESSOS_POR_THREAD 8
+
+// Trabalho de uma thread (CPU) no benchmark de concorrência
+typedef struct {
+    GerenciadorProcessos *gp;
+    MemoriaFisica *mf;
+    int cpu;                          // CPU simulada pela thread
+    int ciclos;                       // Ciclos de criação, acesso e remoção
+    size_t tamanho_processo;          // Tamanho de cada processo em bytes
+    long long falhas;                 // Operações que falharam ou leram um valor inesperado
+} TrabalhoConcorrente;
+
+// Cria um processo, escreve e lê uma página a cada quarto dele e remove o
+// processo criado PROCESSOS_POR_THREAD ciclos antes. Os PIDs de cada thread
+// são disjuntos, mas o índice, os slots e o mapa de quadros são compartilhados.
+static void* executar_trabalho_concorrente(void *argumento) {
+    TrabalhoConcorrente *t = (TrabalhoConcorrente*)argumento;
+    int pids[PROCESSOS_POR_THREAD] = {0};
+    definir_cpu_atual(t->cpu);
+    for (int i = 0; i < t->ciclos; i++) {
+        int posicao = i % PROCESSOS_POR_THREAD;
+        if (pids[posicao] && !remover_processo(t->gp, t->mf, pids[posicao])) {
+            t->falhas++;
+        }
+        int pid = t->cpu * 10000000 + i + 1;
+        pids[posicao] = criar_processo(t->gp, t->mf, pid, t->tamanho_processo, t->mf->tamanho_pagina,
+                                       t->tamanho_processo);
+        if (pids[posicao] == -1) {
+            pids[posicao] = 0;
+            t->falhas++;
+            continue;
+        }
+        for (int k = 0; k < 4; k++) {
+            uint64_t endereco = (uint64_t)k * t->tamanho_processo / 4;
+            if (!escrever_logico(t->gp, t->mf, pid, endereco, (unsigned char)(i + k)) ||
+                ler_logico(t->gp, t->mf, pid, endereco) != (unsigned char)(i + k)) {
+                t->falhas++;
+            }
+        }
+    }
+    for (int posicao = 0; posicao < PROCESSOS_POR_THREAD; posicao++) {
+        if (pids[posicao] && !remover_processo(t->gp, t->mf, pids[posicao])) {
+            t->falhas++;
+        }
+    }
+    definir_cpu_atual(-1);
+    return NULL;
+}
+
+// Próximo ponto da curva: dobra o número de threads, terminando exatamente em max_threads
+static int proximo_numero_threads(int threads, int max_threads) {
+    return threads < max_threads && threads * 2 > max_threads ? max_threads : threads * 2;
+}
+
+/**
+ * @brief Mede a vazão do ciclo de criação e remoção de processos no modo
+ * concorrente com 1 a max_threads threads (dobrando a cada passo), com
+ * carregamento antecipado e sob demanda, e grava a curva de escalabilidade em CSV.
+ * Ao final de cada execução todos os quadros devem ter voltado ao mapa de bits.
+ */
+static void benchmark_concorrencia(const char *arquivo_csv, int max_threads, int ciclos_por_thread) {
+    FILE *csv = fopen(arquivo_csv, "w");
+    if (!csv) {
+        printf("Erro: Nao foi possivel criar %s.\n", arquivo_csv);
+        return;
+    }
+    fprintf(csv, "carregamento,threads,ciclos,falhas,tempo_s,ciclos_por_segundo,aceleracao,eficiencia,"
+                 "alocacoes,latencia_alocacao_ns,consistente\n");
+
+    printf("\n=== BENCHMARK DE CONCORRENCIA (%d ciclos por thread) ===\n", ciclos_por_thread);
+    printf("%-10s | %7s | %12s | %10s | %10s | %6s\n", "Carga", "Threads", "Ciclos/s", "Aceleracao",
+           "Eficiencia", "Falhas");
+    for (int sob_demanda = 0; sob_demanda <= 1; sob_demanda++) {
+        double base = 0;
+        for (int threads = 1; threads <= max_threads; threads = proximo_numero_threads(threads, max_threads)) {
+            MemoriaFisica *mf = criar_memoria_fisica(256, 4);
+            TrabalhoConcorrente *trabalhos = (TrabalhoConcorrente*)calloc(threads, sizeof(TrabalhoConcorrente));
+            pthread_t *ids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+            if (!mf || !trabalhos || !ids) {
+                destruir_memoria_fisica(mf);
+                free(trabalhos);
+                free(ids);
+                break;
+            }
+            inicializar_memoria_fisica(mf);
+            GerenciadorProcessos gp;
+            inicializar_gerenciador_processos(&gp);
+            definir_paginacao_sob_demanda(&gp, sob_demanda);
+            ativar_modo_concorrente(&gp, mf, threads);
+
+            double inicio = agora_s();
+            for (int i = 0; i < threads; i++) {
+                trabalhos[i] = (TrabalhoConcorrente){&gp, mf, i, ciclos_por_thread, 64 * 1024, 0};
+                pthread_create(&ids[i], NULL, executar_trabalho_concorrente, &trabalhos[i]);
+            }
+            long long falhas = 0;
+            for (int i = 0; i < threads; i++) {
+                pthread_join(ids[i], NULL);
+                falhas += trabalhos[i].falhas;
+            }
+            double tempo = agora_s() - inicio;
+            desativar_modo_concorrente(&gp, mf);
+
+            long long ciclos = (long long)ciclos_por_thread * threads;
+            double vazao = ciclos / tempo;
+            if (threads == 1) {
+                base = vazao;
+            }
+            int consistente = mf->quadros_livres == mf->numero_quadros && gp.num_processos == 0;
+            EstatisticasAlocacao *est = &mf->estatisticas;
+            long long chamadas = est->alocacoes + est->falhas;
+            fprintf(csv, "%s,%d,%lld,%lld,%.4f,%.1f,%.3f,%.3f,%lld,%.1f,%d\n", sob_demanda ? "demanda" : "antecipada",
+                    threads, ciclos, falhas, tempo, vazao, base > 0 ? vazao / base : 0.0,
+                    base > 0 ? vazao / base / threads : 0.0, est->alocacoes,
+                    chamadas ? (double)est->tempo_total_ns / chamadas : 0.0, consistente);
+            printf("%-10s | %7d | %12.0f | %9.2fx | %9.1f%% | %6lld%s\n", sob_demanda ? "demanda" : "antecipada",
+                   threads, vazao, base > 0 ? vazao / base : 0.0, base > 0 ? vazao / base / threads * 100 : 0.0,
+                   falhas, consistente ? "" : " (QUADROS PERDIDOS)");
+
+            finalizar_gerenciador_processos(&gp, mf);
+            destruir_memoria_fisica(mf);
+            free(trabalhos);
+            free(ids);
+        }
+    }
+    fclose(csv);
+    printf("Resultados gravados em %s\n", arquivo_csv);
+}
+
+// Resumo (FNV-1a de 64 bits) do conteúdo dos quadros de um processo, na ordem das páginas
+static uint64_t resumo_quadros(MemoriaFisica *mf, Processo *processo) {
+    uint64_t resumo = 0xCBF29CE484222325ULL;
+    for (int pagina = 0; pagina < processo->num_paginas; pagina++) {
+        const unsigned char *dados = mf->memoria +
+            (size_t)entrada_quadro(*buscar_entrada_pagina(&processo->tabela_paginas, pagina)) * mf->tamanho_pagina;
+        size_t inicio = (size_t)pagina * mf->tamanho_pagina;
+        size_t bytes = processo->tamanho - inicio < (size_t)mf->tamanho_pagina ? processo->tamanho - inicio
+                                                                                 : (size_t)mf->tamanho_pagina;
+        for (size_t i = 0; i < bytes; i++) {
+            resumo = (resumo ^ dados[i]) * 0x100000001B3ULL;
+        }
+    }
+    return resumo;
+}
+
+/**
+ * @brief Mede o tempo de criar um processo grande com carregamento antecipado
+ * com 1 a max_threads threads de carga (dobrando a cada passo), com memória
+ * lógica e com imagens sem cópia, e confere que os quadros recebem exatamente
+ * o mesmo conteúdo para qualquer número de threads.
+ */
+static void benchmark_carga_paralela(int max_threads, size_t tamanho_processo) {
+    printf("\n=== BENCHMARK DE CARGA PARALELA (processo de %zu MB) ===\n", tamanho_processo / (1024 * 1024));
+    printf("%-18s | %7s | %10s | %8s | %10s | %s\n", "Imagem", "Threads", "Tempo (ms)", "GB/s", "Aceleracao",
+           "Conteudo");
+    for (int sem_copia = 0; sem_copia <= 1; sem_copia++) {
+        double base = 0;
+        uint64_t resumo_base = 0;
+        for (int threads = 1; threads <= max_threads; threads = proximo_numero_threads(threads, max_threads)) {
+            MemoriaFisica *mf = criar_memoria_fisica((int)(tamanho_processo / (1024 * 1024)) + 1, 4);
+            if (!mf) {
+                return;
+            }
+            inicializar_memoria_fisica(mf);
+            GerenciadorProcessos gp;
+            inicializar_gerenciador_processos(&gp);
+            definir_imagens_sem_copia(&gp, sem_copia);
+            definir_threads_carga(&gp, threads);
+
+            double inicio = agora_s();
+            int criado = criar_processo(&gp, mf, 1, tamanho_processo, mf->tamanho_pagina, tamanho_processo) != -1;
+            double tempo = agora_s() - inicio;
+            if (!criado) {
+                printf("Erro: Falha ao criar o processo com %d threads.\n", threads);
+                finalizar_gerenciador_processos(&gp, mf);
+                destruir_memoria_fisica(mf);
+                break;
+            }
+            uint64_t resumo = resumo_quadros(mf, encontrar_processo(&gp, 1));
+            if (threads == 1) {
+                base = tempo;
+                resumo_base = resumo;
+            }
+            printf("%-18s | %7d | %10.2f | %8.2f | %9.2fx | %s\n", sem_copia ? "Imagens sem copia" : "Com memoria logica",
+                   threads, tempo * 1e3, tamanho_processo / tempo / 1e9, base / tempo,
+                   resumo == resumo_base ? "identico" : "DIFERENTE");
+
+            finalizar_gerenciador_processos(&gp, mf);
+            destruir_memoria_fisica(mf);
+        }
+    }
+}
+
+/**
+ * @brief Compara o custo de criar um processo com o de duplicá-lo por fork com
+ * cópia na escrita, para tamanhos crescentes, e conta os quadros compartilhados
+ * e privados depois que o filho escreve em uma a cada 10 páginas.
+ */
+static void benchmark_fork(void) {
+    printf("\n=== BENCHMARK DE FORK COM COPIA NA ESCRITA ===\n");
+    printf("%8s | %10s | %10s | %10s | %13s | %8s | %8s\n", "Processo", "Criar (ms)", "Fork (ms)", "Criar/Fork",
+           "Copias (ms)", "Compart.", "Privados");
+    for (int tamanho_mb = 16; tamanho_mb <= 256; tamanho_mb *= 4) {
+        size_t tamanho = (size_t)tamanho_mb * 1024 * 1024;
+        MemoriaFisica *mf = criar_memoria_fisica(2 * tamanho_mb + 1, 4);
+        if (!mf) {
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+
+        double inicio = agora_s();
+        int criado = criar_processo(&gp, mf, 1, tamanho, mf->tamanho_pagina, tamanho) != -1;
+        double tempo_criar = agora_s() - inicio;
+        inicio = agora_s();
+        int duplicado = criado && fork_processo(&gp, mf, 1, 2) != -1;
+        double tempo_fork = agora_s() - inicio;
+        if (!duplicado) {
+            printf("Erro: Falha ao criar ou duplicar o processo de %d MB.\n", tamanho_mb);
+            finalizar_gerenciador_processos(&gp, mf);
+            destruir_memoria_fisica(mf);
+            return;
+        }
+
+        int num_paginas = encontrar_processo(&gp, 2)->num_paginas;
+        inicio = agora_s();
+        for (int pagina = 0; pagina < num_paginas; pagina += 10) {
+            escrever_logico(&gp, mf, 2, (uint64_t)pagina * mf->tamanho_pagina, 0xFF);
+        }
+        double tempo_copias = agora_s() - inicio;
+        int ocupados = mf->numero_quadros - mf->quadros_livres;
+
+        printf("%5d MB | %10.2f | %10.3f | %9.0fx | %13.2f | %8d | %8d\n", tamanho_mb, tempo_criar * 1e3,
+               tempo_fork * 1e3, tempo_criar / tempo_fork, tempo_copias * 1e3, mf->quadros_compartilhados,
+               ocupados - mf->quadros_compartilhados);
+
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+    }
+}
+
+/**
+ * @brief Executa uma carga Zipf sob demanda, com processos que somam o dobro da
+ * memória física e metade dos acessos sendo escritas, sem swap e com swaps de
+ * latências e larguras de banda diferentes. Exibe a vazão, as gravações e
+ * escritas do swap, a profundidade máxima da fila e a latência das faltas.
+ */
+static void benchmark_swap(long long num_operacoes) {
+    const char *nomes[] = {"sem swap", "memoria", "arquivo", "memoria 20us 1GB/s", "memoria 100us 200MB/s"};
+    const int em_arquivo[] = {0, 0, 1, 0, 0};
+    const long long latencias_ns[] = {0, 0, 0, 20000, 100000};
+    const long long bandas_mb[] = {0, 0, 0, 1024, 200};
+    const char *arquivo_swap = "benchmark_swap.bin";
+
+    printf("\n=== BENCHMARK DE SWAP (%lld operacoes, 16 MB de memoria, 32 MB de processos) ===\n", num_operacoes);
+    printf("%-22s | %10s | %8s | %8s | %9s | %8s | %16s | %16s\n", "Swap", "Ops/s", "Gravadas", "Escritas",
+           "Pag/escr.", "Fila max", "Swap-in p50/p99", "Outras p50/p99");
+    for (int c = 0; c < 5; c++) {
+        ConfiguracaoCarga config = {ACESSO_ZIPF, 0.8, 64, 4, 8 * 1024 * 1024, 4096, 0.5, 0.0, 42};
+        GeradorCarga gerador;
+        MemoriaFisica *mf = criar_memoria_fisica(16, 4);
+        if (!mf || !criar_gerador_carga(&gerador, &config)) {
+            destruir_memoria_fisica(mf);
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        definir_paginacao_sob_demanda(&gp, 1);
+        definir_politica_substituicao(obter_substituidor(&gp, mf), SUBSTITUICAO_CLOCK);
+        if (c > 0 && !configurar_swap(&gp, mf, 64 * 1024 * 1024, em_arquivo[c] ? arquivo_swap : NULL,
+                                      latencias_ns[c], bandas_mb[c] * 1024 * 1024)) {
+            printf("Erro: Falha ao configurar o swap %s.\n", nomes[c]);
+            finalizar_gerenciador_processos(&gp, mf);
+            destruir_memoria_fisica(mf);
+            destruir_gerador_carga(&gerador);
+            return;
+        }
+
+        long long falhas = 0;
+        double inicio = agora_s();
+        for (long long i = 0; i < num_operacoes; i++) {
+            OperacaoCarga operacao;
+            proxima_operacao_carga(&gerador, &operacao);
+            falhas += !executar_operacao(&gp, mf, operacao.tipo, operacao.pid, operacao.argumento,
+                                         operacao.valor, config.tamanho_processo);
+        }
+        double tempo = agora_s() - inicio;
+
+        if (gp.swap) {
+            EstatisticasSwap e;
+            swap_esperar_gravacoes(gp.swap);
+            swap_obter_estatisticas(gp.swap, &e);
+            printf("%-22s | %10.0f | %8lld | %8lld | %9.2f | %8d | %7lld/%-8lld | %7lld/%-8lld\n", nomes[c],
+                   num_operacoes / tempo, e.paginas_gravadas, e.escritas,
+                   e.escritas ? (double)e.paginas_gravadas / e.escritas : 0.0, e.profundidade_maxima,
+                   swap_percentil(e.latencia_swap_in_ns, 0.50), swap_percentil(e.latencia_swap_in_ns, 0.99),
+                   swap_percentil(e.latencia_outras_ns, 0.50), swap_percentil(e.latencia_outras_ns, 0.99));
+        } else {
+            printf("%-22s | %10.0f | %8lld | %8s | %9s | %8s | %16s | %16s\n", nomes[c], num_operacoes / tempo,
+                   gp.substituicao->writebacks, "-", "-", "-", "-", "-");
+        }
+        if (falhas > 0) {
+            printf("  %lld operacoes falharam\n", falhas);
+        }
+
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+        destruir_gerador_carga(&gerador);
+    }
+    remove(arquivo_swap);
+}
+
+/**
+ * @brief Executa a carga Zipf do benchmark de swap sem o rastreador do
+ * conjunto de trabalho, com amostras a intervalos diferentes e com o controle
+ * PFF. Exibe a vazão, as faltas, o custo das amostras, os processos em
+ * thrashing e os quadros que manteriam todos os conjuntos de trabalho.
+ */
+static void benchmark_conjunto_trabalho(long long num_operacoes) {
+    const int intervalos[] = {0, 1024, 4096, 16384, 4096};
+    const int com_pff[] = {0, 0, 0, 0, 1};
+
+    printf("\n=== BENCHMARK DO CONJUNTO DE TRABALHO (%lld operacoes, 16 MB de memoria, 32 MB de processos) ===\n",
+           num_operacoes);
+    printf("%-18s | %10s | %8s | %8s | %14s | %9s | %9s | %8s\n", "Rastreador", "Ops/s", "Faltas", "Amostras",
+           "Amostragem ms", "Thrashing", "Sugeridos", "Locais");
+    for (int c = 0; c < 5; c++) {
+        ConfiguracaoCarga config = {ACESSO_ZIPF, 0.8, 64, 4, 8 * 1024 * 1024, 4096, 0.5, 0.0, 42};
+        GeradorCarga gerador;
+        MemoriaFisica *mf = criar_memoria_fisica(16, 4);
+        if (!mf || !criar_gerador_carga(&gerador, &config)) {
+            destruir_memoria_fisica(mf);
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        definir_paginacao_sob_demanda(&gp, 1);
+        definir_politica_substituicao(obter_substituidor(&gp, mf), SUBSTITUICAO_CLOCK);
+        if (intervalos[c] > 0) {
+            configurar_conjunto_trabalho(&gp, intervalos[c], TRABALHO_JANELA_PADRAO);
+            if (com_pff[c]) {
+                configurar_controle_pff(gp.conjunto_trabalho, 1, TRABALHO_PFF_INFERIOR_PADRAO,
+                                        TRABALHO_PFF_SUPERIOR_PADRAO, TRABALHO_PFF_PASSO_PADRAO);
+            }
+        }
+
+        double inicio = agora_s();
+        for (long long i = 0; i < num_operacoes; i++) {
+            OperacaoCarga operacao;
+            proxima_operacao_carga(&gerador, &operacao);
+            executar_operacao(&gp, mf, operacao.tipo, operacao.pid, operacao.argumento, operacao.valor,
+                              config.tamanho_processo);
+        }
+        double tempo = agora_s() - inicio;
+
+        char nome[32];
+        snprintf(nome, sizeof(nome), intervalos[c] ? "a cada %d%s" : "desativado", intervalos[c],
+                 com_pff[c] ? " + PFF" : "");
+        RastreadorTrabalho *r = gp.conjunto_trabalho;
+        if (r) {
+            int em_thrashing = 0;
+            long long sugeridos = 0;
+            for (int i = 0; i < gp.capacidade_processos; i++) {
+                Processo *processo = processo_no_slot(&gp, i);
+                if (processo->ativo && processo->trabalho) {
+                    em_thrashing += processo->trabalho->em_thrashing;
+                    sugeridos += processo->trabalho->maior_conjunto;
+                }
+            }
+            printf("%-18s | %10.0f | %8lld | %8d | %14.2f | %9d | %9lld | %8lld\n", nome, num_operacoes / tempo,
+                   gp.total_faltas_pagina, r->amostras, r->tempo_amostragem_ns / 1e6, em_thrashing, sugeridos,
+                   r->despejos_locais);
+        } else {
+            printf("%-18s | %10.0f | %8lld | %8s | %14s | %9s | %9s | %8s\n", nome, num_operacoes / tempo,
+                   gp.total_faltas_pagina, "-", "-", "-", "-", "-");
+        }
+
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+        destruir_gerador_carga(&gerador);
+    }
+}
+
+// Número de sequências de quadros fisicamente contíguos nas páginas presentes de um processo
+static int segmentos_do_processo(Processo *processo) {
+    int segmentos = 0;
+    int anterior = -2;
+    for (int pagina = 0; pagina < processo->num_paginas; pagina++) {
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+        if (entrada && entrada_tem(*entrada, TP_PRESENTE)) {
+            segmentos += entrada_quadro(*entrada) != anterior + 1;
+            anterior = entrada_quadro(*entrada);
+        }
+    }
+    return segmentos;
+}
+
+/**
+ * @brief Fragmenta uma memória de 64 MB criando e removendo processos pequenos
+ * com carregamento antecipado e, a cada 64 operações, cria um processo de 2 MB
+ * e remove o mais antigo de quatro. Com as alocações primeiro livre e buddy,
+ * compara a execução sem compactação, com passos automáticos e com
+ * compactação sob pedido antes de cada processo grande (uma passagem completa
+ * no primeiro livre, que usa os quadros livres mais baixos, e só até haver uma
+ * sequência livre de 2 MB no buddy). Exibe a vazão, os processos grandes
+ * criados, em quantas sequências contíguas seus quadros ficaram, o tempo de
+ * criá-los e o custo da compactação.
+ */
+static void benchmark_compactacao(long long num_operacoes) {
+    const char *nomes[] = {"nenhuma", "32 a cada 16 ops", "128 a cada 16 ops", "sob pedido",
+                           "nenhuma", "32 a cada 16 ops", "sob pedido"};
+    const PoliticaAlocacao politicas[] = {ALOCACAO_PRIMEIRO_LIVRE, ALOCACAO_PRIMEIRO_LIVRE, ALOCACAO_PRIMEIRO_LIVRE,
+                                          ALOCACAO_PRIMEIRO_LIVRE, ALOCACAO_BUDDY, ALOCACAO_BUDDY, ALOCACAO_BUDDY};
+    const int quadros_por_passo[] = {0, 32, 128, 32, 0, 32, 32};
+    const int intervalos[] = {0, 16, 16, 0, 0, 16, 0};
+    const int num_pequenos = 864;
+    const size_t tamanho_grande = 2 * 1024 * 1024;
+
+    printf("\n=== BENCHMARK DE COMPACTACAO (%lld operacoes, 64 MB de memoria, processos de 4 a 256 KB e de 2 MB) ===\n",
+           num_operacoes);
+    printf("%-14s | %-17s | %10s | %9s | %9s | %10s | %11s | %9s | %11s | %14s | %12s\n", "Alocacao", "Compactacao",
+           "Ops/s", "Grandes", "Segmentos", "Criar (us)", "Maior livre", "Migrados", "MB copiados", "Compactacao ms",
+           "Passo max us");
+    for (int c = 0; c < 7; c++) {
+        MemoriaFisica *mf = criar_memoria_fisica(64, 4);
+        if (!mf) {
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        definir_politica_alocacao(mf, politicas[c]);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        if (quadros_por_passo[c] > 0) {
+            configurar_compactacao(&gp, quadros_por_passo[c], intervalos[c]);
+        }
+
+        uint64_t estado = 42;
+        long long segmentos = 0, grandes = 0, tentativas = 0;
+        double tempo_grandes = 0;
+        double inicio = agora_s();
+        for (long long i = 0; i < num_operacoes; i++) {
+            estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint32_t sorteio = (uint32_t)(estado >> 33);
+            if (i % 64 == 63) {
+                // O processo grande mais antigo só sai depois da criação do novo, para
+                // que o buraco deixado por ele seja fragmentado pelas operações seguintes
+                int pid_grande = num_pequenos + 1 + (int)(i / 64 % 4);
+                if (gp.compactacao && intervalos[c] == 0) {
+                    compactar_memoria(gp.compactacao, &gp, mf, politicas[c] == ALOCACAO_BUDDY
+                                      ? (int)(tamanho_grande / mf->tamanho_pagina) : 0);
+                }
+                tentativas++;
+                double inicio_grande = agora_s();
+                if (criar_processo(&gp, mf, pid_grande, tamanho_grande, mf->tamanho_pagina, tamanho_grande) != -1) {
+                    tempo_grandes += agora_s() - inicio_grande;
+                    segmentos += segmentos_do_processo(encontrar_processo(&gp, pid_grande));
+                    grandes++;
+                }
+                int pid_antigo = num_pequenos + 1 + (int)((i / 64 + 1) % 4);
+                if (encontrar_processo(&gp, pid_antigo)) {
+                    remover_processo(&gp, mf, pid_antigo);
+                }
+            } else {
+                int pid = 1 + (int)(sorteio % num_pequenos);
+                if (encontrar_processo(&gp, pid)) {
+                    remover_processo(&gp, mf, pid);
+                } else {
+                    size_t tamanho = (size_t)(1 + (sorteio >> 10) % 64) * mf->tamanho_pagina;
+                    criar_processo(&gp, mf, pid, tamanho, mf->tamanho_pagina, tamanho);
+                }
+            }
+            if (gp.compactacao) {
+                compactacao_registrar_operacao(gp.compactacao, &gp, mf);
+            }
+        }
+        double tempo = agora_s() - inicio;
+
+        int maior_bloco, num_blocos;
+        calcular_fragmentacao(mf, &maior_bloco, &num_blocos);
+        Compactador *compactador = gp.compactacao;
+        char criados[48];
+        snprintf(criados, sizeof(criados), "%lld/%lld", grandes, tentativas);
+        printf("%-14s | %-17s | %10.0f | %9s | %9.1f | %10.1f | %11d | %9lld | %11.1f | %14.2f | %12.1f\n",
+               nome_politica_alocacao(politicas[c]), nomes[c],
+               num_operacoes / tempo, criados, grandes > 0 ? (double)segmentos / grandes : 0.0,
+               grandes > 0 ? tempo_grandes * 1e6 / grandes : 0.0, maior_bloco,
+               compactador ? compactador->quadros_migrados : 0LL,
+               compactador ? compactador->bytes_copiados / (1024.0 * 1024.0) : 0.0,
+               compactador ? compactador->tempo_ns / 1e6 : 0.0,
+               compactador ? compactador->tempo_max_passo_ns / 1e3 : 0.0);
+
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+    }
+}
+
+/**
+ * @brief Cria 48 processos de 1 MB em uma memória de 64 MB, com 0, 25, 50 e
+ * 75% do início das imagens igual em todos ou com imagens só de páginas
+ * zeradas (iguais em qualquer posição), e os deduplica com uma varredura
+ * completa. Exibe os quadros mesclados e economizados, o custo da varredura
+ * (tempo total, por quadro e vazão do hash) e, depois de escritas em
+ * endereços sorteados, a vazão das escritas, as cópias na escrita e os quadros
+ * que continuam economizados. A primeira linha, sem deduplicação, é a
+ * referência da vazão das escritas.
+ */
+static void benchmark_deduplicacao(long long num_escritas) {
+    const int percentuais[] = {50, 0, 25, 50, 75, 0};
+    const int entropias[] = {100, 100, 100, 100, 100, 0};
+    const int num_processos = 48;
+    const size_t tamanho = 1024 * 1024;
+
+    printf("\n=== BENCHMARK DE DEDUPLICACAO (%d processos de 1 MB, 64 MB de memoria, %lld escritas) ===\n",
+           num_processos, num_escritas);
+    printf("%-13s | %-12s | %9s | %9s | %14s | %12s | %10s | %9s | %10s | %15s | %16s\n", "Imagem comum",
+           "Deduplicacao", "Ocupados", "Mesclados", "MB economizados", "Varredura ms", "ns/quadro", "Hash GB/s",
+           "Escritas/s", "Copias escrita", "Economizados fim");
+    for (int c = 0; c < 6; c++) {
+        MemoriaFisica *mf = criar_memoria_fisica(64, 4);
+        if (!mf) {
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        definir_imagem_comum(&gp, percentuais[c]);
+        definir_entropia_imagens(&gp, entropias[c]);
+        if (c > 0) {
+            configurar_deduplicacao(&gp, mf, DEDUPLICACAO_QUADROS_POR_PASSO_PADRAO, 0);
+        }
+        for (int pid = 1; pid <= num_processos; pid++) {
+            criar_processo(&gp, mf, pid, tamanho, mf->tamanho_pagina, tamanho);
+        }
+        int ocupados = mf->numero_quadros - mf->quadros_livres;
+        Deduplicador *d = gp.deduplicacao;
+        if (d) {
+            deduplicar_memoria(d, &gp, mf);
+        }
+        long long economizados = quadros_economizados(mf);
+
+        uint64_t estado = 42;
+        double inicio = agora_s();
+        for (long long i = 0; i < num_escritas; i++) {
+            estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+            int pid = 1 + (int)((estado >> 33) % num_processos);
+            uint64_t endereco = (estado >> 13) % tamanho;
+            escrever_logico(&gp, mf, pid, endereco, (unsigned char)i);
+        }
+        double tempo = agora_s() - inicio;
+
+        char nome[16];
+        if (entropias[c] == 0) {
+            snprintf(nome, sizeof(nome), "zeradas");
+        } else {
+            snprintf(nome, sizeof(nome), "%d%%", percentuais[c]);
+        }
+        printf("%-13s | %-12s | %9d | %9lld | %14.1f | %12.2f | %10.0f | %9.2f | %10.0f | %15lld | %16lld\n",
+               nome, d ? "varredura" : "nenhuma", ocupados, d ? d->quadros_mesclados : 0LL,
+               economizados * mf->tamanho_pagina / (1024.0 * 1024.0), d ? d->tempo_ns / 1e6 : 0.0,
+               d && d->quadros_examinados > 0 ? (double)d->tempo_ns / d->quadros_examinados : 0.0,
+               d && d->tempo_hash_ns > 0 ? (double)d->bytes_hash / d->tempo_hash_ns : 0.0, num_escritas / tempo,
+               gp.total_copias_na_escrita, quadros_economizados(mf));
+
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+    }
+}
+
+/**
+ * @brief Executa a carga Zipf do benchmark de swap, com swap de 20 us, sem o
+ * cache comprimido e com um cache de 4 MB para imagens de entropias
+ * diferentes. Exibe a vazão, a taxa de compressão, as páginas recusadas, as
+ * latências de compressão e descompressão, a capacidade efetiva da memória e
+ * as faltas atendidas pelo cache e pelo swap.
+ */
+static void benchmark_cache_comprimido(long long num_operacoes) {
+    const int entropias[] = {100, 0, 25, 50, 75, 100};
+    const int quadros_cache = 1024;
+
+    printf("\n=== BENCHMARK DO CACHE COMPRIMIDO (%lld operacoes, 16 MB de memoria, 32 MB de processos, "
+           "swap de 20 us) ===\n", num_operacoes);
+    printf("%-8s | %-7s | %9s | %6s | %9s | %9s | %18s | %18s | %10s | %8s | %8s\n", "Entropia", "Cache",
+           "Ops/s", "Taxa", "Guardadas", "Recusadas", "Comprimir p50/p99", "Descomp. p50/p99", "Capacidade",
+           "Acertos", "Swap-in");
+    for (int c = 0; c < 6; c++) {
+        ConfiguracaoCarga config = {ACESSO_ZIPF, 0.8, 64, 4, 8 * 1024 * 1024, 4096, 0.5, 0.0, 42};
+        GeradorCarga gerador;
+        MemoriaFisica *mf = criar_memoria_fisica(16, 4);
+        if (!mf || !criar_gerador_carga(&gerador, &config)) {
+            destruir_memoria_fisica(mf);
+            return;
+        }
+        inicializar_memoria_fisica(mf);
+        GerenciadorProcessos gp;
+        inicializar_gerenciador_processos(&gp);
+        definir_paginacao_sob_demanda(&gp, 1);
+        definir_entropia_imagens(&gp, entropias[c]);
+        definir_politica_substituicao(obter_substituidor(&gp, mf), SUBSTITUICAO_CLOCK);
+        if (!configurar_swap(&gp, mf, 64 * 1024 * 1024, NULL, 20000, 0) ||
+            (c > 0 && !configurar_cache_comprimido(&gp, mf, quadros_cache, CACHE_COMPRIMIDO_LIMITE_PADRAO))) {
+            printf("Erro: Falha ao configurar o swap ou o cache comprimido.\n");
+            finalizar_gerenciador_processos(&gp, mf);
+            destruir_memoria_fisica(mf);
+            destruir_gerador_carga(&gerador);
+            return;
+        }
+
+        long long falhas = 0;
+        double inicio = agora_s();
+        for (long long i = 0; i < num_operacoes; i++) {
+            OperacaoCarga operacao;
+            proxima_operacao_carga(&gerador, &operacao);
+            falhas += !executar_operacao(&gp, mf, operacao.tipo, operacao.pid, operacao.argumento,
+                                         operacao.valor, config.tamanho_processo);
+        }
+        double tempo = agora_s() - inicio;
+
+        EstatisticasSwap es;
+        swap_esperar_gravacoes(gp.swap);
+        swap_obter_estatisticas(gp.swap, &es);
+        char entropia[8];
+        snprintf(entropia, sizeof(entropia), "%d%%", entropias[c]);
+        CacheComprimido *cache = gp.cache_comprimido;
+        if (cache) {
+            EstatisticasCacheComprimido *e = &cache->estatisticas;
+            printf("%-8s | %-7s | %9.0f | %6.2f | %9lld | %9lld | %8lld/%-9lld | %8lld/%-9lld | %10lld | %8lld | %8lld\n",
+                   entropia, "4 MB", num_operacoes / tempo,
+                   e->bytes_comprimidos > 0 ? (double)e->bytes_originais / e->bytes_comprimidos : 0.0,
+                   e->paginas_guardadas, e->recusadas_incompressiveis + e->recusadas_cheio,
+                   swap_percentil(e->latencia_compressao_ns, 0.50), swap_percentil(e->latencia_compressao_ns, 0.99),
+                   swap_percentil(e->latencia_descompressao_ns, 0.50),
+                   swap_percentil(e->latencia_descompressao_ns, 0.99), cache_comprimido_capacidade_efetiva(cache, mf),
+                   e->paginas_carregadas, es.paginas_lidas);
+        } else {
+            printf("%-8s | %-7s | %9.0f | %6s | %9s | %9s | %18s | %18s | %10d | %8s | %8lld\n", entropia, "nenhum",
+                   num_operacoes / tempo, "-", "-", "-", "-", "-", mf->numero_quadros, "-", es.paginas_lidas);
+        }
+        if (falhas > 0) {
+            printf("  %lld operacoes falharam\n", falhas);
+        }
+
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+        destruir_gerador_carga(&gerador);
+    }
+}
+
+// Grava em um arquivo o rastro de uma carga Zipf com rotatividade, para o modo em lote do simulador
+static void gravar_rastro(const char *arquivo, long long num_operacoes) {
+    ConfiguracaoCarga config = {ACESSO_ZIPF, 0.99, 64, 16, 4 * 1024 * 1024, 4096, 0.3, 0.001, 42};
+    GeradorCarga gerador;
+    FILE *saida = fopen(arquivo, "w");
+    if (!saida || !criar_gerador_carga(&gerador, &config)) {
+        printf("Erro: Nao foi possivel gravar o rastro em %s.\n", arquivo);
+        if (saida) {
+            fclose(saida);
+        }
+        return;
+    }
+    fprintf(saida, "# Carga %s, %d processos de %zu bytes\n", nome_distribuicao_acesso(config.distribuicao),
+            config.num_processos, config.tamanho_processo);
+    fprintf(saida, "demanda 1\nsubstituicao %d\n", SUBSTITUICAO_CLOCK);
+    for (long long i = 0; i < num_operacoes; i++) {
+        OperacaoCarga operacao;
+        proxima_operacao_carga(&gerador, &operacao);
+        escrever_operacao_carga(saida, &operacao);
+    }
+    fclose(saida);
+    destruir_gerador_carga(&gerador);
+    printf("Rastro de %lld operacoes gravado em %s\n", num_operacoes, arquivo);
+}
+
+int main(int argc, char *argv[]) {
+    // Opções --csv=arquivo, --operacoes=N, --rastro=arquivo, --threads=N e
+    // --csv-concorrencia=arquivo; os demais argumentos são posicionais
+    const char *arquivo_csv = "benchmark_cargas.csv";
+    const char *arquivo_csv_concorrencia = "benchmark_concorrencia.csv";
+    const char *arquivo_rastro = NULL;
+    long long num_operacoes = 200000;
+    // Por padrão, até o número de CPUs do hospedeiro (no mínimo 4)
+    int max_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (max_threads < 4) {
+        max_threads = 4;
+    }
+    const char *posicionais[4] = {NULL, NULL, NULL, NULL};
+    int num_posicionais = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--csv=", 6) == 0) {
+            arquivo_csv = argv[i] + 6;
+        } else if (strncmp(argv[i], "--operacoes=", 12) == 0) {
+            num_operacoes = atoll(argv[i] + 12);
+        } else if (strncmp(argv[i], "--rastro=", 9) == 0) {
+            arquivo_rastro = argv[i] + 9;
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            max_threads = atoi(argv[i] + 10) > 0 ? atoi(argv[i] + 10) : 1;
+        } else if (strncmp(argv[i], "--csv-concorrencia=", 19) == 0) {
+            arquivo_csv_concorrencia = argv[i] + 19;
+        } else if (num_posicionais < 4) {
+            posicionais[num_posicionais++] = argv[i];
+        }
+    }
+    // As mensagens do simulador são desligadas; só os resultados são exibidos
+    definir_nivel_registro(REGISTRO_DESLIGADO);
+    if (arquivo_rastro) {
+        gravar_rastro(arquivo_rastro, num_operacoes);
+        return 0;
+    }
+    
+    int tamanho_mb = posicionais[0] ? atoi(posicionais[0]) : 64;
+    int tamanho_pagina_kb = posicionais[1] ? atoi(posicionais[1]) : 4;
+    int tamanho_processo = posicionais[2] ? atoi(posicionais[2]) : 32 * 1024 * 1024;
+    int repeticoes = posicionais[3] ? atoi(posicionais[3]) : 5;
+
+    benchmark_copia(tamanho_mb, tamanho_pagina_kb, tamanho_processo, repeticoes);
+    benchmark_tabelas(1 << 20, 1 << 14, 1 << 22);
+    benchmark_inicializacao(tamanho_pagina_kb);
+    benchmark_processos(100000);
+    benchmark_imagens(tamanho_mb, tamanho_pagina_kb, 8);
+    benchmark_cargas(arquivo_csv, 32, num_operacoes);
+    benchmark_concorrencia(arquivo_csv_concorrencia, max_threads, 20000);
+    benchmark_carga_paralela(max_threads, 256 * 1024 * 1024);
+    benchmark_fork();
+    benchmark_swap(num_operacoes / 4);
+    benchmark_conjunto_trabalho(num_operacoes);
+    benchmark_compactacao(num_operacoes / 4);
+    benchmark_deduplicacao(num_operacoes / 20);
+    benchmark_cache_comprimido(num_operacoes / 4);
+    verificar_enderecos_64_bits();
+    verificar_limite_quadros();
+    return 0;
+}
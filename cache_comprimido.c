@@ -0,0 +1,539 @@
+#include "cache_comprimido.h"
+#include <string.h>
+
+// Menor repetição codificada e maior distância que cabe em 2 bytes
+#define LZ_REPETICAO_MINIMA 4
+#define LZ_DISTANCIA_MAXIMA 65535
+
+static inline uint32_t ler32(const unsigned char *p) {
+    uint32_t valor;
+    memcpy(&valor, p, sizeof(valor));
+    return valor;
+}
+
+// Posição de uma sequência de 4 bytes na tabela (hash multiplicativo de Knuth)
+static inline int posicao_sequencia(uint32_t sequencia) {
+    return (int)((sequencia * 2654435761U) >> (32 - CACHE_COMPRIMIDO_BITS_TABELA));
+}
+
+// Tamanho da repetição que começa em i, igual à que começa no candidato.
+// Compara 8 bytes por vez: o primeiro byte diferente sai dos zeros do XOR
+static inline int comprimento_repeticao(const unsigned char *origem, int candidato, int i, int bytes) {
+    int comprimento = LZ_REPETICAO_MINIMA;
+    while (i + comprimento + 8 <= bytes) {
+        uint64_t a, b;
+        memcpy(&a, origem + candidato + comprimento, sizeof(a));
+        memcpy(&b, origem + i + comprimento, sizeof(b));
+        if (a != b) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            return comprimento + (__builtin_ctzll(a ^ b) >> 3);
+#else
+            return comprimento + (__builtin_clzll(a ^ b) >> 3);
+#endif
+        }
+        comprimento += 8;
+    }
+    while (i + comprimento < bytes && origem[candidato + comprimento] == origem[i + comprimento]) {
+        comprimento++;
+    }
+    return comprimento;
+}
+
+// Escreve o excedente de um comprimento que não coube nos 4 bits do byte de
+// controle: bytes 255 enquanto sobrar, e o resto
+static unsigned char* escrever_comprimento(unsigned char *saida, int excedente) {
+    while (excedente >= 255) {
+        *saida++ = 255;
+        excedente -= 255;
+    }
+    *saida++ = (unsigned char)excedente;
+    return saida;
+}
+
+// Bytes de uma sequência no pior caso: controle, comprimentos estendidos, literais e distância
+static inline int bytes_da_sequencia(int literais, int repeticao) {
+    return 1 + (literais / 255 + 1) + literais + 2 + (repeticao / 255 + 1);
+}
+
+int comprimir_lz(const unsigned char *origem, int bytes, unsigned char *destino, int capacidade, int *tabela) {
+    // Posições vazias apontam para o início, que a comparação dos 4 bytes descarta se não repetir
+    memset(tabela, 0, (1 << CACHE_COMPRIMIDO_BITS_TABELA) * sizeof(int));
+    unsigned char *saida = destino;
+    unsigned char *fim_saida = destino + capacidade;
+    int ancora = 0, i = 0;
+    while (i <= bytes - LZ_REPETICAO_MINIMA) {
+        uint32_t sequencia = ler32(origem + i);
+        int h = posicao_sequencia(sequencia);
+        int candidato = tabela[h];
+        tabela[h] = i;
+        if (candidato >= i || i - candidato > LZ_DISTANCIA_MAXIMA || ler32(origem + candidato) != sequencia) {
+            // Literais que já não cabem: a página é incompressível
+            if (i - ancora >= capacidade) {
+                return 0;
+            }
+            // Como a aceleração do LZ4: longe da última repetição, o passo cresce
+            i += 1 + ((i - ancora) >> 6);
+            continue;
+        }
+
+        int comprimento = comprimento_repeticao(origem, candidato, i, bytes);
+        int literais = i - ancora;
+        int repeticao = comprimento - LZ_REPETICAO_MINIMA;
+        if (bytes_da_sequencia(literais, repeticao) > fim_saida - saida) {
+            return 0;
+        }
+        *saida++ = (unsigned char)((literais < 15 ? literais : 15) << 4 | (repeticao < 15 ? repeticao : 15));
+        if (literais >= 15) {
+            saida = escrever_comprimento(saida, literais - 15);
+        }
+        memcpy(saida, origem + ancora, literais);
+        saida += literais;
+        int distancia = i - candidato;
+        *saida++ = (unsigned char)(distancia & 0xFF);
+        *saida++ = (unsigned char)(distancia >> 8);
+        if (repeticao >= 15) {
+            saida = escrever_comprimento(saida, repeticao - 15);
+        }
+        i += comprimento;
+        ancora = i;
+    }
+
+    // A última sequência só tem os literais restantes
+    int literais = bytes - ancora;
+    if (1 + (literais / 255 + 1) + literais > fim_saida - saida) {
+        return 0;
+    }
+    *saida++ = (unsigned char)((literais < 15 ? literais : 15) << 4);
+    if (literais >= 15) {
+        saida = escrever_comprimento(saida, literais - 15);
+    }
+    memcpy(saida, origem + ancora, literais);
+    saida += literais;
+    return (int)(saida - destino);
+}
+
+// Soma a um comprimento o excedente codificado após o byte de controle
+static int ler_comprimento(const unsigned char **p, const unsigned char *fim, int *comprimento) {
+    unsigned char b;
+    do {
+        if (*p >= fim) {
+            return 0;
+        }
+        b = *(*p)++;
+        *comprimento += b;
+    } while (b == 255);
+    return 1;
+}
+
+int descomprimir_lz(const unsigned char *origem, int tamanho, unsigned char *destino, int bytes) {
+    const unsigned char *p = origem;
+    const unsigned char *fim = origem + tamanho;
+    int produzidos = 0;
+    while (p < fim) {
+        int controle = *p++;
+        int literais = controle >> 4;
+        if (literais == 15 && !ler_comprimento(&p, fim, &literais)) {
+            return 0;
+        }
+        if (literais > fim - p || literais > bytes - produzidos) {
+            return 0;
+        }
+        // Poucos literais longe dos finais: uma cópia de tamanho fixo, mais
+        // rápida que a de tamanho variável, que escreve bytes que serão sobrescritos
+        if (literais <= 16 && fim - p >= 16 && bytes - produzidos >= 16) {
+            memcpy(destino + produzidos, p, 16);
+        } else {
+            memcpy(destino + produzidos, p, literais);
+        }
+        p += literais;
+        produzidos += literais;
+        if (p == fim) {
+            break;
+        }
+
+        if (fim - p < 2) {
+            return 0;
+        }
+        int distancia = p[0] | p[1] << 8;
+        p += 2;
+        int comprimento = (controle & 15) + LZ_REPETICAO_MINIMA;
+        if ((controle & 15) == 15 && !ler_comprimento(&p, fim, &comprimento)) {
+            return 0;
+        }
+        if (distancia == 0 || distancia > produzidos || comprimento > bytes - produzidos) {
+            return 0;
+        }
+        unsigned char *copia = destino + produzidos;
+        if (distancia >= 8 && bytes - produzidos >= comprimento + 8) {
+            // Blocos de 8 bytes, cada um lido do que já foi escrito
+            for (int k = 0; k < comprimento; k += 8) {
+                memcpy(copia + k, copia + k - distancia, 8);
+            }
+        } else if (distancia >= comprimento) {
+            memcpy(copia, copia - distancia, comprimento);
+        } else {
+            // Repetição que se sobrepõe à própria saída (por exemplo, uma
+            // sequência de zeros): o padrão de `distancia` bytes é copiado e
+            // depois duplicado, mantendo o período
+            memcpy(copia, copia - distancia, distancia);
+            for (int feitos = distancia; feitos < comprimento; feitos *= 2) {
+                memcpy(copia + feitos, copia, feitos < comprimento - feitos ? feitos : comprimento - feitos);
+            }
+        }
+        produzidos += comprimento;
+    }
+    return produzidos == bytes;
+}
+
+// Endereço de um deslocamento dentro de um slab, no quadro em que ele cai
+static inline unsigned char* endereco_no_slab(CacheComprimido *c, MemoriaFisica *mf, int slab, size_t deslocamento) {
+    int quadro = c->quadros_do_slab[slab * CACHE_COMPRIMIDO_QUADROS_POR_SLAB + (int)(deslocamento / c->tamanho_pagina)];
+    return mf->memoria + (size_t)quadro * c->tamanho_pagina + deslocamento % c->tamanho_pagina;
+}
+
+// Início de um objeto no slab; os objetos de uma classe têm o tamanho do maior passo dela
+static inline size_t deslocamento_do_objeto(CacheComprimido *c, int slab, int indice) {
+    return (size_t)indice * (c->classe_do_slab[slab] + 1) * CACHE_COMPRIMIDO_GRANULARIDADE;
+}
+
+// Copia bytes entre um buffer e um objeto, em duas partes se ele atravessa o limite entre dois quadros do slab
+static void transferir_objeto(CacheComprimido *c, MemoriaFisica *mf, int slab, int indice,
+                              unsigned char *buffer, int bytes, int para_o_slab) {
+    size_t deslocamento = deslocamento_do_objeto(c, slab, indice);
+    while (bytes > 0) {
+        int restante_no_quadro = c->tamanho_pagina - (int)(deslocamento % c->tamanho_pagina);
+        int parte = bytes < restante_no_quadro ? bytes : restante_no_quadro;
+        unsigned char *endereco = endereco_no_slab(c, mf, slab, deslocamento);
+        if (para_o_slab) {
+            memcpy(endereco, buffer, parte);
+        } else {
+            memcpy(buffer, endereco, parte);
+        }
+        buffer += parte;
+        bytes -= parte;
+        deslocamento += parte;
+    }
+}
+
+// Listas duplamente encadeadas de slabs: as de cada classe e a de descritores livres
+static void inserir_slab(CacheComprimido *c, int *lista, int slab) {
+    c->anterior_slab[slab] = -1;
+    c->proximo_slab[slab] = *lista;
+    if (*lista != -1) {
+        c->anterior_slab[*lista] = slab;
+    }
+    *lista = slab;
+}
+
+static void retirar_slab(CacheComprimido *c, int *lista, int slab) {
+    if (c->anterior_slab[slab] != -1) {
+        c->proximo_slab[c->anterior_slab[slab]] = c->proximo_slab[slab];
+    } else {
+        *lista = c->proximo_slab[slab];
+    }
+    if (c->proximo_slab[slab] != -1) {
+        c->anterior_slab[c->proximo_slab[slab]] = c->anterior_slab[slab];
+    }
+}
+
+// Escolhe, para cada passo de tamanho, os quadros do slab que desperdiçam
+// menos (na dúvida, menos quadros) e junta cada passo à classe do seguinte
+// quando os dois têm o mesmo formato de slab
+static void calcular_classes(CacheComprimido *c) {
+    for (int passo = 0; passo < c->num_passos; passo++) {
+        int tamanho = (passo + 1) * CACHE_COMPRIMIDO_GRANULARIDADE;
+        int melhor_quadros = 1;
+        int melhor_objetos = c->tamanho_pagina / tamanho;
+        for (int quadros = 2; quadros <= CACHE_COMPRIMIDO_QUADROS_POR_SLAB; quadros++) {
+            int objetos = quadros * c->tamanho_pagina / tamanho;
+            // Compara as frações ocupadas, objetos * tamanho / (quadros * tamanho_pagina)
+            if ((long long)objetos * melhor_quadros > (long long)melhor_objetos * quadros) {
+                melhor_quadros = quadros;
+                melhor_objetos = objetos;
+            }
+        }
+        c->quadros_da_classe[passo] = melhor_quadros;
+        c->objetos_da_classe[passo] = melhor_objetos;
+        if (melhor_objetos > c->objetos_por_slab) {
+            c->objetos_por_slab = melhor_objetos;
+        }
+    }
+    for (int passo = c->num_passos - 1; passo >= 0; passo--) {
+        int seguinte = passo + 1;
+        if (seguinte < c->num_passos && c->quadros_da_classe[seguinte] == c->quadros_da_classe[passo] &&
+            c->objetos_da_classe[seguinte] == c->objetos_da_classe[passo]) {
+            c->classe_do_passo[passo] = c->classe_do_passo[seguinte];
+        } else {
+            c->classe_do_passo[passo] = passo;
+        }
+    }
+}
+
+CacheComprimido* criar_cache_comprimido(MemoriaFisica *mf, int quadros, int limite_percentual) {
+    if (quadros < 1 || limite_percentual < 1 || limite_percentual > 100) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Quadros (%d) ou limite (%d%%) do cache comprimido invalidos.\n",
+                     quadros, limite_percentual);
+        return NULL;
+    }
+    CacheComprimido *c = (CacheComprimido*)calloc(1, sizeof(CacheComprimido));
+    if (!c) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o cache comprimido.\n");
+        return NULL;
+    }
+    c->tamanho_pagina = mf->tamanho_pagina;
+    c->limite_objeto = (int)((long long)mf->tamanho_pagina * limite_percentual / 100);
+    c->num_passos = (c->limite_objeto + CACHE_COMPRIMIDO_GRANULARIDADE - 1) / CACHE_COMPRIMIDO_GRANULARIDADE;
+    c->classe_do_passo = (int*)malloc(c->num_passos * sizeof(int));
+    c->quadros_da_classe = (int*)malloc(c->num_passos * sizeof(int));
+    c->objetos_da_classe = (int*)malloc(c->num_passos * sizeof(int));
+    c->parciais = (int*)malloc(c->num_passos * sizeof(int));
+    if (!c->classe_do_passo || !c->quadros_da_classe || !c->objetos_da_classe || !c->parciais) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar as classes do cache comprimido.\n");
+        destruir_cache_comprimido(c, mf);
+        return NULL;
+    }
+    calcular_classes(c);
+
+    size_t objetos = (size_t)quadros * c->objetos_por_slab;
+    c->quadros_livres = (int*)malloc(quadros * sizeof(int));
+    c->classe_do_slab = (int*)malloc(quadros * sizeof(int));
+    c->quadros_do_slab = (int*)malloc((size_t)quadros * CACHE_COMPRIMIDO_QUADROS_POR_SLAB * sizeof(int));
+    c->livres_do_slab = (int*)calloc(quadros, sizeof(int));
+    c->primeiro_livre = (int*)malloc(quadros * sizeof(int));
+    c->proximo_slab = (int*)malloc(quadros * sizeof(int));
+    c->anterior_slab = (int*)malloc(quadros * sizeof(int));
+    c->proximo_livre = (int*)malloc(objetos * sizeof(int));
+    c->tamanho_objeto = (int*)calloc(objetos, sizeof(int));
+    c->tabela = (int*)malloc((1 << CACHE_COMPRIMIDO_BITS_TABELA) * sizeof(int));
+    c->buffer = (unsigned char*)malloc(c->limite_objeto);
+    if (!c->quadros_livres || !c->classe_do_slab || !c->quadros_do_slab || !c->livres_do_slab ||
+        !c->primeiro_livre || !c->proximo_slab || !c->anterior_slab || !c->proximo_livre ||
+        !c->tamanho_objeto || !c->tabela || !c->buffer) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar as estruturas do cache comprimido.\n");
+        destruir_cache_comprimido(c, mf);
+        return NULL;
+    }
+    if (!alocar_quadros(mf, quadros, c->quadros_livres)) {
+        destruir_cache_comprimido(c, mf);
+        return NULL;
+    }
+    c->num_quadros = quadros;
+    c->num_quadros_livres = quadros;
+
+    // Todos os descritores de slab começam livres
+    c->descritores_livres = -1;
+    for (int slab = quadros - 1; slab >= 0; slab--) {
+        c->classe_do_slab[slab] = -1;
+        c->primeiro_livre[slab] = -1;
+        inserir_slab(c, &c->descritores_livres, slab);
+    }
+    for (int passo = 0; passo < c->num_passos; passo++) {
+        c->parciais[passo] = -1;
+    }
+    REGISTRAR_INFO("Cache comprimido: %d quadros reservados, objetos de ate %d bytes.\n", quadros, c->limite_objeto);
+    return c;
+}
+
+void destruir_cache_comprimido(CacheComprimido *c, MemoriaFisica *mf) {
+    if (!c) {
+        return;
+    }
+    for (int i = 0; i < c->num_quadros_livres; i++) {
+        liberar_quadro(mf, c->quadros_livres[i]);
+    }
+    for (int slab = 0; slab < c->num_quadros; slab++) {
+        int classe = c->classe_do_slab[slab];
+        for (int k = 0; classe != -1 && k < c->quadros_da_classe[classe]; k++) {
+            liberar_quadro(mf, c->quadros_do_slab[slab * CACHE_COMPRIMIDO_QUADROS_POR_SLAB + k]);
+        }
+    }
+    free(c->classe_do_passo);
+    free(c->quadros_da_classe);
+    free(c->objetos_da_classe);
+    free(c->parciais);
+    free(c->quadros_livres);
+    free(c->classe_do_slab);
+    free(c->quadros_do_slab);
+    free(c->livres_do_slab);
+    free(c->primeiro_livre);
+    free(c->proximo_slab);
+    free(c->anterior_slab);
+    free(c->proximo_livre);
+    free(c->tamanho_objeto);
+    free(c->tabela);
+    free(c->buffer);
+    free(c);
+}
+
+// Monta um slab da classe com quadros da reserva, todos os objetos livres.
+// Retorna o slab, ou -1 se não houver quadros suficientes.
+static int criar_slab(CacheComprimido *c, int classe) {
+    int quadros = c->quadros_da_classe[classe];
+    int slab = c->descritores_livres;
+    if (slab == -1 || c->num_quadros_livres < quadros) {
+        return -1;
+    }
+    retirar_slab(c, &c->descritores_livres, slab);
+    for (int k = 0; k < quadros; k++) {
+        c->quadros_do_slab[slab * CACHE_COMPRIMIDO_QUADROS_POR_SLAB + k] = c->quadros_livres[--c->num_quadros_livres];
+    }
+    int objetos = c->objetos_da_classe[classe];
+    int base = slab * c->objetos_por_slab;
+    for (int k = 0; k < objetos; k++) {
+        c->proximo_livre[base + k] = k + 1 < objetos ? k + 1 : -1;
+    }
+    c->classe_do_slab[slab] = classe;
+    c->livres_do_slab[slab] = objetos;
+    c->primeiro_livre[slab] = 0;
+    inserir_slab(c, &c->parciais[classe], slab);
+    c->slabs_em_uso++;
+    return slab;
+}
+
+// Devolve os quadros de um slab vazio à reserva e libera o descritor
+static void desfazer_slab(CacheComprimido *c, int slab) {
+    int classe = c->classe_do_slab[slab];
+    retirar_slab(c, &c->parciais[classe], slab);
+    for (int k = 0; k < c->quadros_da_classe[classe]; k++) {
+        c->quadros_livres[c->num_quadros_livres++] = c->quadros_do_slab[slab * CACHE_COMPRIMIDO_QUADROS_POR_SLAB + k];
+    }
+    c->classe_do_slab[slab] = -1;
+    c->primeiro_livre[slab] = -1;
+    inserir_slab(c, &c->descritores_livres, slab);
+    c->slabs_em_uso--;
+}
+
+int cache_comprimido_guardar(CacheComprimido *c, MemoriaFisica *mf, const unsigned char *dados) {
+    EstatisticasCacheComprimido *e = &c->estatisticas;
+    long long inicio_ns = agora_ns();
+    int tamanho = comprimir_lz(dados, c->tamanho_pagina, c->buffer, c->limite_objeto, c->tabela);
+    long long duracao = agora_ns() - inicio_ns;
+    e->tempo_compressao_ns += duracao;
+    e->latencia_compressao_ns[swap_faixa_histograma(duracao)]++;
+    if (tamanho == 0) {
+        e->recusadas_incompressiveis++;
+        return -1;
+    }
+
+    int classe = c->classe_do_passo[(tamanho - 1) / CACHE_COMPRIMIDO_GRANULARIDADE];
+    int slab = c->parciais[classe];
+    if (slab == -1) {
+        slab = criar_slab(c, classe);
+        if (slab == -1) {
+            e->recusadas_cheio++;
+            return -1;
+        }
+    }
+    int indice = c->primeiro_livre[slab];
+    int objeto = slab * c->objetos_por_slab + indice;
+    c->primeiro_livre[slab] = c->proximo_livre[objeto];
+    if (--c->livres_do_slab[slab] == 0) {
+        retirar_slab(c, &c->parciais[classe], slab);
+    }
+
+    transferir_objeto(c, mf, slab, indice, c->buffer, tamanho, 1);
+    c->tamanho_objeto[objeto] = tamanho;
+    c->objetos_em_uso++;
+    c->bytes_em_uso += tamanho;
+    e->paginas_guardadas++;
+    e->bytes_originais += c->tamanho_pagina;
+    e->bytes_comprimidos += tamanho;
+    return objeto;
+}
+
+// Slab de um objeto guardado, ou -1 se o identificador não é de um objeto ocupado
+static int slab_do_objeto(CacheComprimido *c, int objeto) {
+    if (objeto < 0 || objeto >= c->num_quadros * c->objetos_por_slab || c->tamanho_objeto[objeto] == 0) {
+        return -1;
+    }
+    return objeto / c->objetos_por_slab;
+}
+
+int cache_comprimido_ler(CacheComprimido *c, MemoriaFisica *mf, int objeto, unsigned char *destino) {
+    int slab = slab_do_objeto(c, objeto);
+    if (slab == -1) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Objeto %d do cache comprimido invalido.\n", objeto);
+        return 0;
+    }
+    int indice = objeto % c->objetos_por_slab;
+    int tamanho = c->tamanho_objeto[objeto];
+    long long inicio_ns = agora_ns();
+
+    // Um objeto dentro de um só quadro é lido no lugar; um que atravessa dois é juntado no buffer
+    size_t deslocamento = deslocamento_do_objeto(c, slab, indice);
+    const unsigned char *origem = c->buffer;
+    if ((int)(deslocamento % c->tamanho_pagina) + tamanho <= c->tamanho_pagina) {
+        origem = endereco_no_slab(c, mf, slab, deslocamento);
+    } else {
+        transferir_objeto(c, mf, slab, indice, c->buffer, tamanho, 0);
+    }
+    int sucesso = descomprimir_lz(origem, tamanho, destino, c->tamanho_pagina);
+    long long duracao = agora_ns() - inicio_ns;
+    if (!sucesso) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Objeto %d do cache comprimido corrompido.\n", objeto);
+        return 0;
+    }
+    EstatisticasCacheComprimido *e = &c->estatisticas;
+    e->tempo_descompressao_ns += duracao;
+    e->latencia_descompressao_ns[swap_faixa_histograma(duracao)]++;
+    e->paginas_carregadas++;
+    return 1;
+}
+
+void cache_comprimido_liberar(CacheComprimido *c, int objeto) {
+    int slab = slab_do_objeto(c, objeto);
+    if (slab == -1) {
+        return;
+    }
+    int classe = c->classe_do_slab[slab];
+    c->objetos_em_uso--;
+    c->bytes_em_uso -= c->tamanho_objeto[objeto];
+    c->tamanho_objeto[objeto] = 0;
+    c->proximo_livre[objeto] = c->primeiro_livre[slab];
+    c->primeiro_livre[slab] = objeto % c->objetos_por_slab;
+
+    // Um slab que estava cheio volta à lista da classe; um que esvaziou é desfeito
+    int livres = ++c->livres_do_slab[slab];
+    if (livres == 1) {
+        inserir_slab(c, &c->parciais[classe], slab);
+    }
+    if (livres == c->objetos_da_classe[classe]) {
+        desfazer_slab(c, slab);
+    }
+}
+
+long long cache_comprimido_capacidade_efetiva(CacheComprimido *c, MemoriaFisica *mf) {
+    return (long long)mf->numero_quadros - c->num_quadros + c->objetos_em_uso;
+}
+
+void exibir_estatisticas_cache_comprimido(CacheComprimido *c, MemoriaFisica *mf) {
+    EstatisticasCacheComprimido *e = &c->estatisticas;
+    long long capacidade = cache_comprimido_capacidade_efetiva(c, mf);
+    long long compressoes = e->paginas_guardadas + e->recusadas_incompressiveis + e->recusadas_cheio;
+    double mb_por_quadro = c->tamanho_pagina / (1024.0 * 1024.0);
+
+    printf("\n=== CACHE COMPRIMIDO ===\n");
+    int classes = 0;
+    for (int passo = 0; passo < c->num_passos; passo++) {
+        classes += c->classe_do_passo[passo] == passo;
+    }
+    printf("Slabs: %d em uso, com %d de %d quadros reservados; objetos de ate %d bytes em %d classes\n",
+           c->slabs_em_uso, c->num_quadros - c->num_quadros_livres, c->num_quadros, c->limite_objeto, classes);
+    printf("Paginas guardadas agora: %d (%.2f MB comprimidos em %.2f MB de slabs)\n", c->objetos_em_uso,
+           c->bytes_em_uso / (1024.0 * 1024.0), (c->num_quadros - c->num_quadros_livres) * mb_por_quadro);
+    printf("Paginas guardadas: %lld, recusadas: %lld incompressiveis e %lld com o cache cheio\n",
+           e->paginas_guardadas, e->recusadas_incompressiveis, e->recusadas_cheio);
+    printf("Paginas descomprimidas: %lld\n", e->paginas_carregadas);
+    printf("Taxa de compressao: %.2f:1 (%lld bytes em %lld)\n",
+           e->bytes_comprimidos > 0 ? (double)e->bytes_originais / e->bytes_comprimidos : 0.0,
+           e->bytes_originais, e->bytes_comprimidos);
+    printf("Capacidade efetiva: %lld paginas em %d quadros (%+.1f%%)\n", capacidade, mf->numero_quadros,
+           100.0 * (capacidade - mf->numero_quadros) / mf->numero_quadros);
+    printf("Compressao: %.2f GB/s, descompressao: %.2f GB/s\n",
+           e->tempo_compressao_ns > 0 ? (double)compressoes * c->tamanho_pagina / e->tempo_compressao_ns : 0.0,
+           e->tempo_descompressao_ns > 0
+               ? (double)e->paginas_carregadas * c->tamanho_pagina / e->tempo_descompressao_ns : 0.0);
+    swap_exibir_histograma("Latencia da compressao", "ns", e->latencia_compressao_ns);
+    swap_exibir_histograma("Latencia da descompressao", "ns", e->latencia_descompressao_ns);
+    printf("========================\n\n");
+}
@@ -0,0 +1,176 @@
+#ifndef CACHE_COMPRIMIDO_H
+#define CACHE_COMPRIMIDO_H
+
+#include "memoria.h"
+#include "swap.h"
+
+// Os objetos ocupam múltiplos da granularidade, em bytes
+#define CACHE_COMPRIMIDO_GRANULARIDADE 64
+// Quadros de um slab no máximo, como nas zspages do zsmalloc
+#define CACHE_COMPRIMIDO_QUADROS_POR_SLAB 4
+// Páginas que comprimidas ocupam mais que este percentual da página são recusadas
+#define CACHE_COMPRIMIDO_LIMITE_PADRAO 75
+// Posições da tabela de sequências do compressor (2^bits)
+#define CACHE_COMPRIMIDO_BITS_TABELA 12
+
+// Contadores do cache comprimido
+typedef struct {
+    long long paginas_guardadas;          // Páginas comprimidas e guardadas em um slab
+    long long recusadas_incompressiveis;  // Páginas que comprimidas passariam do limite
+    long long recusadas_cheio;            // Páginas comprimidas sem objeto livre na classe nem quadros para um slab
+    long long paginas_carregadas;         // Páginas descomprimidas (nas faltas e nas cópias do fork)
+    long long bytes_originais;            // Bytes das páginas guardadas
+    long long bytes_comprimidos;          // Bytes comprimidos das páginas guardadas
+    long long tempo_compressao_ns;        // Tempo comprimindo, incluindo as páginas recusadas
+    long long tempo_descompressao_ns;     // Tempo descomprimindo
+    long long latencia_compressao_ns[SWAP_FAIXAS_HISTOGRAMA];   // Cada compressão, guardada ou recusada
+    long long latencia_descompressao_ns[SWAP_FAIXAS_HISTOGRAMA]; // Cada descompressão
+} EstatisticasCacheComprimido;
+
+// Cache comprimido de páginas despejadas, como o zswap do Linux. As páginas
+// modificadas escolhidas pela substituição são comprimidas com um codec LZ
+// (sequências de 4 bytes procuradas em uma tabela hash, como no LZ4) e
+// guardadas em quadros reservados da própria memória física, antes do swap e
+// da memória do hospedeiro.
+//
+// Os objetos ficam em slabs, como no zsmalloc: um slab tem de 1 a
+// CACHE_COMPRIMIDO_QUADROS_POR_SLAB quadros divididos em objetos de uma
+// classe, e um objeto pode atravessar o limite entre dois quadros do slab.
+// Cada tamanho de objeto usa o número de quadros que menos desperdiça, e
+// tamanhos vizinhos com o mesmo formato de slab (quadros e objetos) formam
+// uma só classe, com o maior deles, para não manter um slab parcial por
+// tamanho. Os quadros de um slab que esvazia voltam à reserva do cache. Os
+// quadros reservados não têm dono no mapa reverso, então a substituição, a
+// compactação e a deduplicação não os tocam.
+typedef struct CacheComprimido {
+    int tamanho_pagina;               // Tamanho das páginas (e dos quadros dos slabs) em bytes
+    int limite_objeto;                // Maior tamanho comprimido aceito, em bytes
+
+    // Classes, indexadas pelo passo do tamanho: o passo k cobre até (k + 1) * GRANULARIDADE bytes
+    int num_passos;                   // Passos até o limite
+    int *classe_do_passo;             // Classe de cada passo: o maior passo do grupo com o mesmo formato de slab
+    int *quadros_da_classe;           // Quadros de um slab da classe
+    int *objetos_da_classe;           // Objetos de um slab da classe
+    int *parciais;                    // Primeiro slab com objeto livre de cada classe (-1 se nenhum)
+    int objetos_por_slab;             // Maior número de objetos de um slab (espaço de índices de cada slab)
+
+    // Quadros reservados
+    int num_quadros;                  // Quadros reservados na memória física
+    int *quadros_livres;              // Pilha dos quadros reservados fora dos slabs
+    int num_quadros_livres;
+
+    // Slabs: no máximo um por quadro reservado
+    int *classe_do_slab;              // Classe de cada slab (-1 se o descritor está livre)
+    int *quadros_do_slab;             // Quadros de cada slab, CACHE_COMPRIMIDO_QUADROS_POR_SLAB posições por slab
+    int *livres_do_slab;              // Objetos livres de cada slab
+    int *primeiro_livre;              // Primeiro objeto livre de cada slab (-1 se cheio)
+    int *proximo_slab;                // Lista dos slabs com objetos livres de cada classe, ou dos descritores livres
+    int *anterior_slab;
+    int descritores_livres;           // Primeiro descritor de slab livre (-1 se nenhum)
+    int *proximo_livre;               // Lista de objetos livres, por identificador de objeto
+    int *tamanho_objeto;              // Bytes comprimidos de cada objeto (0 se livre)
+
+    int slabs_em_uso;                 // Slabs com pelo menos um objeto
+    int objetos_em_uso;               // Páginas guardadas agora
+    long long bytes_em_uso;           // Bytes comprimidos das páginas guardadas agora
+
+    int *tabela;                      // Tabela de sequências do compressor
+    unsigned char *buffer;            // Saída da compressão, ou objeto que atravessa dois quadros
+
+    EstatisticasCacheComprimido estatisticas;
+} CacheComprimido;
+
+/**
+ * @brief Cria o cache comprimido, reservando seus quadros na memória física.
+ *
+ * @param mf Ponteiro para a memória física.
+ * @param quadros Quadros reservados para os slabs (o orçamento do cache).
+ * @param limite_percentual Maior tamanho comprimido aceito, em percentual da página (1 a 100).
+ * @return Ponteiro para o cache, ou NULL se faltarem quadros livres ou memória.
+ */
+CacheComprimido* criar_cache_comprimido(MemoriaFisica *mf, int quadros, int limite_percentual);
+
+/**
+ * @brief Devolve os quadros reservados à memória física e libera o cache.
+ *
+ * As páginas guardadas são perdidas; quem chama deve garantir que não há nenhuma.
+ *
+ * @param c Ponteiro para o cache (pode ser NULL).
+ * @param mf Ponteiro para a memória física.
+ */
+void destruir_cache_comprimido(CacheComprimido *c, MemoriaFisica *mf);
+
+/**
+ * @brief Comprime um bloco com o codec LZ do cache.
+ *
+ * O formato é o de blocos do LZ4: cada sequência tem um byte com os tamanhos
+ * dos literais e da repetição, os literais e a distância da repetição em 2
+ * bytes; a última sequência só tem literais.
+ *
+ * @param origem Bloco a comprimir.
+ * @param bytes Tamanho do bloco.
+ * @param destino Saída comprimida.
+ * @param capacidade Bytes disponíveis em destino.
+ * @param tabela Tabela de trabalho com 2^CACHE_COMPRIMIDO_BITS_TABELA posições.
+ * @return Tamanho comprimido, ou 0 se não couber em capacidade.
+ */
+int comprimir_lz(const unsigned char *origem, int bytes, unsigned char *destino, int capacidade, int *tabela);
+
+/**
+ * @brief Descomprime um bloco produzido por comprimir_lz, conferindo os limites.
+ *
+ * @param origem Bloco comprimido.
+ * @param tamanho Tamanho do bloco comprimido.
+ * @param destino Saída descomprimida.
+ * @param bytes Tamanho esperado da saída.
+ * @return 1 se a saída tem exatamente `bytes` bytes, 0 se o bloco for inválido.
+ */
+int descomprimir_lz(const unsigned char *origem, int tamanho, unsigned char *destino, int bytes);
+
+/**
+ * @brief Comprime uma página e a guarda em um objeto do cache.
+ *
+ * @param c Ponteiro para o cache.
+ * @param mf Ponteiro para a memória física.
+ * @param dados Conteúdo da página (tamanho_pagina bytes).
+ * @return Identificador do objeto, ou -1 se a página for recusada (incompressível ou cache cheio).
+ */
+int cache_comprimido_guardar(CacheComprimido *c, MemoriaFisica *mf, const unsigned char *dados);
+
+/**
+ * @brief Descomprime a página de um objeto, que continua guardado.
+ *
+ * @param c Ponteiro para o cache.
+ * @param mf Ponteiro para a memória física.
+ * @param objeto Identificador do objeto.
+ * @param destino Destino (tamanho_pagina bytes).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int cache_comprimido_ler(CacheComprimido *c, MemoriaFisica *mf, int objeto, unsigned char *destino);
+
+/**
+ * @brief Libera um objeto; os quadros de um slab que fica vazio voltam à reserva do cache.
+ *
+ * @param c Ponteiro para o cache.
+ * @param objeto Identificador do objeto.
+ */
+void cache_comprimido_liberar(CacheComprimido *c, int objeto);
+
+/**
+ * @brief Capacidade efetiva da memória física com o cache.
+ *
+ * @param c Ponteiro para o cache.
+ * @param mf Ponteiro para a memória física.
+ * @return Páginas que a memória comporta agora: os quadros fora do cache mais as páginas guardadas nele.
+ */
+long long cache_comprimido_capacidade_efetiva(CacheComprimido *c, MemoriaFisica *mf);
+
+/**
+ * @brief Exibe a taxa de compressão, a ocupação dos slabs, a capacidade efetiva e os histogramas de latência.
+ *
+ * @param c Ponteiro para o cache.
+ * @param mf Ponteiro para a memória física.
+ */
+void exibir_estatisticas_cache_comprimido(CacheComprimido *c, MemoriaFisica *mf);
+
+#endif // CACHE_COMPRIMIDO_H
@@ -0,0 +1,170 @@
+#include "carga.h"
+#include <string.h>
+#include <math.h>
+
+// Gerador sequencial splitmix64
+static uint64_t proximo_aleatorio(GeradorCarga *gerador) {
+    uint64_t z = (gerador->estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Número uniforme em [0, 1)
+static double aleatorio_unitario(GeradorCarga *gerador) {
+    return (proximo_aleatorio(gerador) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Número uniforme em [0, limite)
+static uint64_t aleatorio_ate(GeradorCarga *gerador, uint64_t limite) {
+    return limite ? proximo_aleatorio(gerador) % limite : 0;
+}
+
+int criar_gerador_carga(GeradorCarga *gerador, const ConfiguracaoCarga *config) {
+    memset(gerador, 0, sizeof(GeradorCarga));
+    if (config->num_processos <= 0 || config->tamanho_processo == 0 || config->tamanho_pagina <= 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Configuracao de carga invalida.\n");
+        return 0;
+    }
+
+    gerador->config = *config;
+    if (gerador->config.passo_sequencial <= 0) {
+        gerador->config.passo_sequencial = 1;
+    }
+    gerador->estado = config->semente;
+    gerador->num_paginas = calcular_num_paginas(config->tamanho_processo, config->tamanho_pagina);
+    gerador->slot_recriar = -1;
+    gerador->proximo_pid = 1;
+
+    gerador->pids_ativos = (int*)malloc(config->num_processos * sizeof(int));
+    if (!gerador->pids_ativos || gerador->num_paginas == -1) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o gerador de carga.\n");
+        destruir_gerador_carga(gerador);
+        return 0;
+    }
+
+    if (config->distribuicao == ACESSO_ZIPF) {
+        // A probabilidade da página de posto k é proporcional a 1 / (k + 1)^s
+        gerador->cdf_zipf = (double*)malloc(gerador->num_paginas * sizeof(double));
+        if (!gerador->cdf_zipf) {
+            RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar a distribuicao de Zipf.\n");
+            destruir_gerador_carga(gerador);
+            return 0;
+        }
+        double soma = 0;
+        for (int k = 0; k < gerador->num_paginas; k++) {
+            soma += 1.0 / pow(k + 1, config->expoente_zipf);
+            gerador->cdf_zipf[k] = soma;
+        }
+        for (int k = 0; k < gerador->num_paginas; k++) {
+            gerador->cdf_zipf[k] /= soma;
+        }
+    }
+    return 1;
+}
+
+void destruir_gerador_carga(GeradorCarga *gerador) {
+    free(gerador->cdf_zipf);
+    free(gerador->pids_ativos);
+    gerador->cdf_zipf = NULL;
+    gerador->pids_ativos = NULL;
+}
+
+// Página sorteada pela lei de Zipf (busca binária na distribuição acumulada)
+static int pagina_zipf(GeradorCarga *gerador) {
+    double u = aleatorio_unitario(gerador);
+    int inicio = 0, fim = gerador->num_paginas - 1;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (gerador->cdf_zipf[meio] < u) {
+            inicio = meio + 1;
+        } else {
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+void proxima_operacao_carga(GeradorCarga *gerador, OperacaoCarga *operacao) {
+    ConfiguracaoCarga *config = &gerador->config;
+    memset(operacao, 0, sizeof(OperacaoCarga));
+
+    // Aquecimento e rotatividade: cria um processo novo na posição vaga
+    if (gerador->num_ativos < config->num_processos || gerador->slot_recriar != -1) {
+        int slot = gerador->slot_recriar != -1 ? gerador->slot_recriar : gerador->num_ativos++;
+        gerador->pids_ativos[slot] = gerador->proximo_pid++;
+        gerador->slot_recriar = -1;
+        operacao->tipo = OP_CRIAR;
+        operacao->pid = gerador->pids_ativos[slot];
+        operacao->argumento = config->tamanho_processo;
+        return;
+    }
+
+    if (config->taxa_rotatividade > 0 && aleatorio_unitario(gerador) < config->taxa_rotatividade) {
+        gerador->slot_recriar = (int)aleatorio_ate(gerador, config->num_processos);
+        operacao->tipo = OP_REMOVER;
+        operacao->pid = gerador->pids_ativos[gerador->slot_recriar];
+        return;
+    }
+
+    // Acesso: escolhe o processo e o endereço conforme a distribuição
+    int slot;
+    uint64_t endereco;
+    switch (config->distribuicao) {
+        case ACESSO_ZIPF: {
+            slot = (int)aleatorio_ate(gerador, config->num_processos);
+            uint64_t base = (uint64_t)pagina_zipf(gerador) * config->tamanho_pagina;
+            uint64_t restante = config->tamanho_processo - base;
+            uint64_t bytes_pagina = (uint64_t)config->tamanho_pagina;
+            endereco = base + aleatorio_ate(gerador, restante < bytes_pagina ? restante : bytes_pagina);
+            break;
+        }
+        case ACESSO_SEQUENCIAL:
+            if (gerador->cursor_sequencial >= config->tamanho_processo) {
+                gerador->cursor_sequencial = 0;
+                gerador->slot_sequencial = (gerador->slot_sequencial + 1) % config->num_processos;
+            }
+            slot = gerador->slot_sequencial;
+            endereco = gerador->cursor_sequencial;
+            gerador->cursor_sequencial += config->passo_sequencial;
+            break;
+        default:
+            slot = (int)aleatorio_ate(gerador, config->num_processos);
+            endereco = aleatorio_ate(gerador, config->tamanho_processo);
+            break;
+    }
+
+    operacao->pid = gerador->pids_ativos[slot];
+    operacao->argumento = endereco;
+    if (aleatorio_unitario(gerador) < config->fracao_escritas) {
+        operacao->tipo = OP_ESCREVER;
+        operacao->valor = (unsigned char)proximo_aleatorio(gerador);
+    } else {
+        operacao->tipo = OP_LER;
+    }
+}
+
+void escrever_operacao_carga(FILE *saida, const OperacaoCarga *operacao) {
+    switch (operacao->tipo) {
+        case OP_REMOVER:
+            fprintf(saida, "remover %d\n", operacao->pid);
+            break;
+        case OP_ESCREVER:
+            fprintf(saida, "escrever %d %llu %u\n", operacao->pid,
+                    (unsigned long long)operacao->argumento, operacao->valor);
+            break;
+        default:
+            fprintf(saida, "%s %d %llu\n", nome_tipo_operacao(operacao->tipo), operacao->pid,
+                    (unsigned long long)operacao->argumento);
+            break;
+    }
+}
+
+const char* nome_distribuicao_acesso(DistribuicaoAcesso distribuicao) {
+    switch (distribuicao) {
+        case ACESSO_UNIFORME:   return "uniforme";
+        case ACESSO_ZIPF:       return "zipf";
+        case ACESSO_SEQUENCIAL: return "sequencial";
+        default:                return "desconhecida";
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef CARGA_H
+#define CARGA_H
+
+#include "lote.h"
+
+// Distribuições dos endereços acessados
+typedef enum {
+    ACESSO_UNIFORME = 0,              // Qualquer byte do processo com a mesma probabilidade
+    ACESSO_ZIPF = 1,                  // Páginas sorteadas pela lei de Zipf (página 0 é a mais acessada)
+    ACESSO_SEQUENCIAL = 2             // Varredura sequencial de um processo por vez
+} DistribuicaoAcesso;
+
+// Parâmetros de uma carga sintética
+typedef struct {
+    DistribuicaoAcesso distribuicao;  // Distribuição dos endereços acessados
+    double expoente_zipf;             // Expoente s da lei de Zipf (ACESSO_ZIPF)
+    int passo_sequencial;             // Bytes entre dois acessos consecutivos (ACESSO_SEQUENCIAL)
+    int num_processos;                // Processos ativos em regime permanente
+    size_t tamanho_processo;          // Tamanho de cada processo em bytes
+    int tamanho_pagina;               // Tamanho da página em bytes (usado por ACESSO_ZIPF)
+    double fracao_escritas;           // Fração dos acessos que são escritas
+    double taxa_rotatividade;         // Probabilidade de uma operação remover um processo (que é recriado em seguida)
+    uint64_t semente;                 // Semente do gerador
+} ConfiguracaoCarga;
+
+// Operação gerada
+typedef struct {
+    TipoOperacao tipo;                // Tipo da operação
+    int pid;                          // Processo alvo
+    uint64_t argumento;               // Tamanho (OP_CRIAR) ou endereço lógico
+    unsigned char valor;              // Byte escrito (OP_ESCREVER)
+} OperacaoCarga;
+
+// Estado do gerador de carga
+typedef struct {
+    ConfiguracaoCarga config;         // Parâmetros da carga
+    uint64_t estado;                  // Estado do gerador pseudoaleatório
+    double *cdf_zipf;                 // ACESSO_ZIPF: distribuição acumulada das páginas
+    int num_paginas;                  // Páginas de cada processo
+    int *pids_ativos;                 // Processos ativos (num_processos posições)
+    int num_ativos;                   // Posições preenchidas durante o aquecimento
+    int slot_recriar;                 // Posição cujo processo foi removido e será recriado (-1 se nenhuma)
+    int proximo_pid;                  // ID do próximo processo criado
+    int slot_sequencial;              // ACESSO_SEQUENCIAL: posição do processo sendo varrido
+    uint64_t cursor_sequencial;       // ACESSO_SEQUENCIAL: próximo endereço da varredura
+} GeradorCarga;
+
+/**
+ * @brief Prepara um gerador de carga. As primeiras operações criam os processos.
+ *
+ * @param gerador Ponteiro para o gerador a ser inicializado.
+ * @param config Parâmetros da carga.
+ * @return 1 se sucesso, 0 se a configuração for inválida ou faltar memória.
+ */
+int criar_gerador_carga(GeradorCarga *gerador, const ConfiguracaoCarga *config);
+
+/**
+ * @brief Libera um gerador de carga.
+ *
+ * @param gerador Ponteiro para o gerador.
+ */
+void destruir_gerador_carga(GeradorCarga *gerador);
+
+/**
+ * @brief Gera a próxima operação da carga.
+ *
+ * @param gerador Ponteiro para o gerador.
+ * @param operacao Estrutura que recebe a operação.
+ */
+void proxima_operacao_carga(GeradorCarga *gerador, OperacaoCarga *operacao);
+
+/**
+ * @brief Escreve uma operação no formato de rastro do modo em lote.
+ *
+ * @param saida Arquivo de saída.
+ * @param operacao A operação.
+ */
+void escrever_operacao_carga(FILE *saida, const OperacaoCarga *operacao);
+
+/**
+ * @brief Retorna o nome legível de uma distribuição de acessos.
+ *
+ * @param distribuicao A distribuição.
+ * @return Nome da distribuição.
+ */
+const char* nome_distribuicao_acesso(DistribuicaoAcesso distribuicao);
+
+#endif // CARGA_H
@@ -0,0 +1,191 @@
+#include "compactacao.h"
+#include "substituicao.h"
+
+Compactador* criar_compactador(int quadros_por_passo, int intervalo) {
+    if (quadros_por_passo < 1 || intervalo < 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Quadros por passo (%d) ou intervalo (%d) da compactacao invalidos.\n",
+                     quadros_por_passo, intervalo);
+        return NULL;
+    }
+    Compactador *c = (Compactador*)calloc(1, sizeof(Compactador));
+    if (!c) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o compactador.\n");
+        return NULL;
+    }
+    c->quadros_por_passo = quadros_por_passo;
+    c->intervalo = intervalo;
+    if (intervalo > 0) {
+        REGISTRAR_INFO("Compactacao: ate %d quadros a cada %d operacoes.\n", quadros_por_passo, intervalo);
+    } else {
+        REGISTRAR_INFO("Compactacao: ate %d quadros por passo, sob pedido.\n", quadros_por_passo);
+    }
+    return c;
+}
+
+void destruir_compactador(Compactador *c) {
+    free(c);
+}
+
+// Começa uma passagem se os quadros livres estiverem espalhados em mais de uma
+// sequência e a fragmentação externa, em %, for de pelo menos `limiar`
+static int iniciar_passagem(Compactador *c, MemoriaFisica *mf, int limiar) {
+    int maior_bloco, num_blocos;
+    calcular_fragmentacao(mf, &maior_bloco, &num_blocos);
+    if (num_blocos <= 1 || (long long)maior_bloco * 100 > (long long)mf->quadros_livres * (100 - limiar)) {
+        return 0;
+    }
+    c->em_passagem = 1;
+    c->cursor_migracao = 0;
+    c->cursor_livre = mf->numero_quadros - 1;
+    c->destino = 0;
+    c->fim_destino = 0;
+    c->maior_bloco_inicio = maior_bloco;
+    return 1;
+}
+
+static void terminar_passagem(Compactador *c, MemoriaFisica *mf) {
+    int num_blocos;
+    calcular_fragmentacao(mf, &c->maior_bloco_fim, &num_blocos);
+    c->em_passagem = 0;
+    c->passagens++;
+    REGISTRAR_DEPURACAO("Compactacao: passagem terminada, maior bloco livre de %d para %d quadros.\n",
+                        c->maior_bloco_inicio, c->maior_bloco_fim);
+}
+
+// Um quadro ocupado só pode ser migrado se o mapa reverso indicar quem o mapeia
+static int quadro_migravel(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadro) {
+    return !quadro_esta_livre(mf, quadro) && gp->substituicao && gp->substituicao->dono_pid[quadro] != -1;
+}
+
+// Próximo quadro de destino: o seguinte da sequência livre atual ou, esgotada
+// ela, o primeiro da próxima sequência abaixo do cursor de livres, com até
+// quadros_por_passo quadros (uma sequência maior seria preenchida a partir de
+// perto do cursor de migração, deslocando os quadros em vez de levá-los para o
+// fim da memória). Retorna -1 se os cursores se encontrarem ou as inspeções
+// do passo acabarem.
+static int proximo_destino(Compactador *c, MemoriaFisica *mf, long long *inspecoes, long long limite) {
+    // Quadros da sequência ocupados entre dois passos são pulados
+    while (c->destino < c->fim_destino) {
+        if (quadro_esta_livre(mf, c->destino)) {
+            return c->destino;
+        }
+        c->destino++;
+    }
+    while (c->cursor_livre > c->cursor_migracao && *inspecoes < limite) {
+        (*inspecoes)++;
+        if (quadro_esta_livre(mf, c->cursor_livre)) {
+            c->fim_destino = c->cursor_livre + 1;
+            while (c->cursor_livre - 1 > c->cursor_migracao && quadro_esta_livre(mf, c->cursor_livre - 1) &&
+                   c->fim_destino - c->cursor_livre < c->quadros_por_passo && *inspecoes < limite) {
+                c->cursor_livre--;
+                (*inspecoes)++;
+            }
+            c->destino = c->cursor_livre--;
+            return c->destino;
+        }
+        c->cursor_livre--;
+    }
+    return -1;
+}
+
+static int executar_passo(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf, int limiar) {
+    if (gp->concorrente) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A compactacao nao e suportada no modo concorrente.\n");
+        return 0;
+    }
+    long long inicio_ns = agora_ns();
+    int migrados = 0;
+    if (c->em_passagem || iniciar_passagem(c, mf, limiar)) {
+        long long limite = (long long)c->quadros_por_passo * COMPACTACAO_INSPECOES_POR_QUADRO;
+        long long inspecoes = 0;
+        while (migrados < c->quadros_por_passo) {
+            int destino = proximo_destino(c, mf, &inspecoes, limite);
+            if (destino == -1 && c->cursor_livre <= c->cursor_migracao) {
+                terminar_passagem(c, mf);
+                break;
+            }
+            while (destino != -1 && c->cursor_migracao < destino && !quadro_migravel(gp, mf, c->cursor_migracao) &&
+                   inspecoes < limite) {
+                if (!quadro_esta_livre(mf, c->cursor_migracao)) {
+                    c->imoveis++;
+                }
+                c->cursor_migracao++;
+                inspecoes++;
+            }
+            if (destino != -1 && c->cursor_migracao >= destino) {
+                terminar_passagem(c, mf);
+                break;
+            }
+            if (destino == -1 || inspecoes >= limite) {
+                break;
+            }
+            if (realocar_quadro(gp, mf, c->cursor_migracao, destino)) {
+                c->destino++;
+                migrados++;
+                c->bytes_copiados += mf->tamanho_pagina;
+            } else {
+                c->imoveis++;
+            }
+            c->cursor_migracao++;
+        }
+        c->quadros_inspecionados += inspecoes;
+        c->quadros_migrados += migrados;
+    }
+
+    long long duracao = agora_ns() - inicio_ns;
+    c->passos++;
+    c->tempo_ns += duracao;
+    if (duracao > c->tempo_max_passo_ns) {
+        c->tempo_max_passo_ns = duracao;
+    }
+    return migrados;
+}
+
+int compactacao_passo(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    return executar_passo(c, gp, mf, COMPACTACAO_LIMIAR_FRAGMENTACAO);
+}
+
+void compactacao_registrar_operacao(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (c->intervalo > 0 && ++c->operacoes_desde_passo >= c->intervalo) {
+        c->operacoes_desde_passo = 0;
+        compactacao_passo(c, gp, mf);
+    }
+}
+
+long long compactar_memoria(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf, int quadros) {
+    long long migrados = 0;
+    do {
+        if (quadros > 0) {
+            int maior_bloco, num_blocos;
+            calcular_fragmentacao(mf, &maior_bloco, &num_blocos);
+            if (maior_bloco >= quadros) {
+                break;
+            }
+        }
+        migrados += executar_passo(c, gp, mf, 0);
+    } while (c->em_passagem && !gp->concorrente);
+    return migrados;
+}
+
+void exibir_estatisticas_compactacao(Compactador *c, MemoriaFisica *mf) {
+    int maior_bloco, num_blocos;
+    calcular_fragmentacao(mf, &maior_bloco, &num_blocos);
+
+    printf("\n=== COMPACTACAO DA MEMORIA ===\n");
+    if (c->intervalo > 0) {
+        printf("Passos: ate %d quadros a cada %d operacoes\n", c->quadros_por_passo, c->intervalo);
+    } else {
+        printf("Passos: ate %d quadros, sob pedido\n", c->quadros_por_passo);
+    }
+    printf("Maior bloco livre: %d de %d quadros livres (%d blocos)\n", maior_bloco, mf->quadros_livres, num_blocos);
+    if (c->passagens > 0) {
+        printf("Ultima passagem: maior bloco livre de %d para %d quadros\n",
+               c->maior_bloco_inicio, c->maior_bloco_fim);
+    }
+    printf("Passagens completas: %lld%s\n", c->passagens, c->em_passagem ? " (uma em andamento)" : "");
+    printf("Quadros migrados: %lld (%.2f MB copiados)\n", c->quadros_migrados, c->bytes_copiados / (1024.0 * 1024.0));
+    printf("Quadros inspecionados: %lld, imoveis: %lld\n", c->quadros_inspecionados, c->imoveis);
+    printf("Passos: %lld, tempo medio: %.1f us, maximo: %.1f us, total: %.2f ms\n", c->passos,
+           c->passos > 0 ? c->tempo_ns / 1e3 / c->passos : 0.0, c->tempo_max_passo_ns / 1e3, c->tempo_ns / 1e6);
+    printf("==============================\n\n");
+}
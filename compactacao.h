@@ -0,0 +1,112 @@
+#ifndef COMPACTACAO_H
+#define COMPACTACAO_H
+
+#include "memoria.h"
+#include "processo.h"
+
+// Quadros inspecionados pelos dois cursores, em um passo, para cada migração permitida
+#define COMPACTACAO_INSPECOES_POR_QUADRO 64
+// Valores padrão da compactação automática
+#define COMPACTACAO_QUADROS_POR_PASSO_PADRAO 32
+#define COMPACTACAO_INTERVALO_PADRAO 16
+// Fragmentação externa (%) a partir da qual os passos automáticos começam uma passagem
+#define COMPACTACAO_LIMIAR_FRAGMENTACAO 50
+
+// Compactação incremental dos quadros físicos. Como a do Linux, usa dois
+// cursores: o de migração sobe a partir do primeiro quadro procurando quadros
+// ocupados e o de livres desce a partir do último procurando sequências de
+// até quadros_por_passo quadros livres, que são preenchidas em ordem
+// crescente para que páginas vizinhas continuem em quadros vizinhos. A
+// passagem termina quando os cursores se encontram; os quadros livres ficam
+// então no início da memória, onde a alocação primeiro livre os procura,
+// salvo os que sobraram na última sequência preenchida. Cada passo migra e
+// inspeciona um número limitado de quadros, retomando dos cursores no passo
+// seguinte, para que possa ser executado entre as operações.
+typedef struct Compactador {
+    int quadros_por_passo;            // Migrações permitidas em um passo
+    int intervalo;                    // Operações entre dois passos automáticos (0 = só manual)
+    int operacoes_desde_passo;        // Operações desde o último passo automático
+
+    int em_passagem;                  // 1 se uma passagem está em andamento
+    int cursor_migracao;              // Próximo quadro inspecionado pelo cursor de migração
+    int cursor_livre;                 // Próximo quadro inspecionado pelo cursor de livres
+    int destino;                      // Próximo quadro da sequência livre sendo preenchida
+    int fim_destino;                  // Fim (exclusivo) dessa sequência
+    int maior_bloco_inicio;           // Maior sequência livre quando a passagem atual (ou a última) começou
+    int maior_bloco_fim;              // Maior sequência livre quando a última passagem terminou
+
+    // Estatísticas
+    long long passos;                 // Passos executados
+    long long passagens;              // Passagens terminadas
+    long long quadros_migrados;       // Quadros migrados
+    long long bytes_copiados;         // Bytes copiados nas migrações
+    long long quadros_inspecionados;  // Quadros visitados pelos cursores
+    long long imoveis;                // Quadros ocupados sem dono no mapa reverso, que não podem ser migrados
+    long long tempo_ns;               // Tempo gasto nos passos
+    long long tempo_max_passo_ns;     // Passo mais demorado
+} Compactador;
+
+/**
+ * @brief Cria o compactador.
+ *
+ * @param quadros_por_passo Migrações permitidas em um passo.
+ * @param intervalo Operações entre dois passos automáticos (0 para só compactar sob pedido).
+ * @return Ponteiro para o compactador, ou NULL em caso de erro.
+ */
+Compactador* criar_compactador(int quadros_por_passo, int intervalo);
+
+/**
+ * @brief Libera o compactador.
+ *
+ * @param c Ponteiro para o compactador (pode ser NULL).
+ */
+void destruir_compactador(Compactador *c);
+
+/**
+ * @brief Executa um passo da compactação.
+ *
+ * Sem passagem em andamento, começa uma se a fragmentação externa dos quadros
+ * livres passar de COMPACTACAO_LIMIAR_FRAGMENTACAO. O passo migra até
+ * quadros_por_passo quadros e inspeciona até COMPACTACAO_INSPECOES_POR_QUADRO
+ * vezes esse número.
+ *
+ * @param c Ponteiro para o compactador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @return Número de quadros migrados no passo.
+ */
+int compactacao_passo(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Conta uma operação e, a cada `intervalo` operações, executa um passo.
+ *
+ * @param c Ponteiro para o compactador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ */
+void compactacao_registrar_operacao(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Compacta sob pedido, com quaisquer quadros livres fora de uma única sequência.
+ *
+ * Como a compactação direta do Linux, para assim que houver uma sequência
+ * livre com o tamanho pedido, ou ao fim da passagem.
+ *
+ * @param c Ponteiro para o compactador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param quadros Tamanho da sequência livre desejada (0 para uma passagem completa).
+ * @return Número de quadros migrados.
+ */
+long long compactar_memoria(Compactador *c, GerenciadorProcessos *gp, MemoriaFisica *mf, int quadros);
+
+/**
+ * @brief Exibe a maior sequência de quadros livres, os quadros migrados, os
+ * bytes copiados e o tempo gasto nos passos.
+ *
+ * @param c Ponteiro para o compactador.
+ * @param mf Ponteiro para a memória física.
+ */
+void exibir_estatisticas_compactacao(Compactador *c, MemoriaFisica *mf);
+
+#endif // COMPACTACAO_H
@@ -0,0 +1,334 @@
+#include "conjunto_trabalho.h"
+#include "substituicao.h"
+#include <string.h>
+
+RastreadorTrabalho* criar_rastreador_trabalho(int intervalo, int janela) {
+    if (intervalo < 1 || janela < 1 || janela >= TRABALHO_MAX_JANELA) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Intervalo (%d) ou janela (%d) do conjunto de trabalho invalidos.\n",
+                     intervalo, janela);
+        return NULL;
+    }
+    RastreadorTrabalho *r = (RastreadorTrabalho*)calloc(1, sizeof(RastreadorTrabalho));
+    if (!r) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o rastreador do conjunto de trabalho.\n");
+        return NULL;
+    }
+    r->intervalo = intervalo;
+    r->janela = janela;
+    r->limite_inferior = TRABALHO_PFF_INFERIOR_PADRAO;
+    r->limite_superior = TRABALHO_PFF_SUPERIOR_PADRAO;
+    r->passo = TRABALHO_PFF_PASSO_PADRAO;
+    REGISTRAR_INFO("Conjunto de trabalho: amostra a cada %d acessos, janela de %d amostras.\n", intervalo, janela);
+    return r;
+}
+
+void destruir_rastreador_trabalho(RastreadorTrabalho *r) {
+    if (r) {
+        free(r->serie);
+        free(r);
+    }
+}
+
+int configurar_controle_pff(RastreadorTrabalho *r, int ativo, double limite_inferior,
+                            double limite_superior, int passo) {
+    if (ativo && (limite_inferior < 0 || limite_superior <= limite_inferior || passo < 1)) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Limites (%.4f, %.4f) ou passo (%d) do PFF invalidos.\n",
+                     limite_inferior, limite_superior, passo);
+        return 0;
+    }
+    r->pff_ativo = ativo ? 1 : 0;
+    if (ativo) {
+        r->limite_inferior = limite_inferior;
+        r->limite_superior = limite_superior;
+        r->passo = passo;
+        REGISTRAR_INFO("Controle PFF ativado: faltas por acesso entre %.4f e %.4f, passo de %d quadros.\n",
+                       limite_inferior, limite_superior, passo);
+    } else {
+        REGISTRAR_INFO("Controle PFF desativado.\n");
+    }
+    return 1;
+}
+
+void liberar_estado_trabalho(EstadoTrabalho *estado) {
+    if (estado) {
+        free(estado->ultima_referencia);
+        free(estado);
+    }
+}
+
+// Histórico do processo, criado no primeiro uso; NULL se faltar memória
+static EstadoTrabalho* estado_do_processo(Processo *processo) {
+    if (processo->trabalho) {
+        return processo->trabalho;
+    }
+    EstadoTrabalho *estado = (EstadoTrabalho*)calloc(1, sizeof(EstadoTrabalho));
+    int *ultima = (int*)malloc((processo->num_paginas > 0 ? processo->num_paginas : 1) * sizeof(int));
+    if (!estado || !ultima) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o historico de referencias do processo %d.\n", processo->id);
+        free(estado);
+        free(ultima);
+        return NULL;
+    }
+    for (int i = 0; i < processo->num_paginas; i++) {
+        ultima[i] = -1;
+    }
+    estado->ultima_referencia = ultima;
+    estado->faltas_amostra = processo->faltas_pagina;
+    processo->trabalho = estado;
+    return estado;
+}
+
+static int registrar_amostra(RastreadorTrabalho *r, const AmostraTrabalho *amostra) {
+    if (r->tamanho_serie == r->capacidade_serie) {
+        int nova_capacidade = r->capacidade_serie ? r->capacidade_serie * 2 : 1024;
+        AmostraTrabalho *nova = (AmostraTrabalho*)realloc(r->serie, nova_capacidade * sizeof(AmostraTrabalho));
+        if (!nova) {
+            return 0;
+        }
+        r->serie = nova;
+        r->capacidade_serie = nova_capacidade;
+    }
+    r->serie[r->tamanho_serie++] = *amostra;
+    return 1;
+}
+
+// Ajusta o orçamento pela taxa de faltas do intervalo. Ao crescer, o
+// orçamento vai pelo menos até o conjunto de trabalho; ao encolher, nunca
+// fica abaixo dele, de modo que só as páginas fora da janela são cortadas.
+static void ajustar_orcamento(RastreadorTrabalho *r, MemoriaFisica *mf, Processo *processo, EstadoTrabalho *estado) {
+    int maximo = processo->num_paginas < mf->numero_quadros ? processo->num_paginas : mf->numero_quadros;
+    if (estado->orcamento == 0) {
+        estado->orcamento = processo->paginas_presentes > 0 ? processo->paginas_presentes : 1;
+    }
+    if (estado->taxa_faltas > r->limite_superior) {
+        int novo = estado->orcamento + r->passo;
+        if (novo < estado->conjunto) {
+            novo = estado->conjunto;
+        }
+        if (novo > maximo) {
+            novo = maximo;
+        }
+        if (novo > estado->orcamento) {
+            estado->orcamento = novo;
+            r->crescimentos++;
+        }
+    } else if (estado->taxa_faltas < r->limite_inferior) {
+        int novo = estado->orcamento - r->passo;
+        if (novo < estado->conjunto) {
+            novo = estado->conjunto;
+        }
+        if (novo < 1) {
+            novo = 1;
+        }
+        if (novo < estado->orcamento) {
+            estado->orcamento = novo;
+            r->reducoes++;
+        }
+    }
+}
+
+// Referência de uma página presente desde a última amostra: o bit da entrada
+// ou, se a página é a dona do quadro, a marca deixada pela política ao limpá-lo.
+// Com consumir, o bit é limpo e a marca é trocada pela que a política consulta.
+static int pagina_referenciada(GerenciadorProcessos *gp, Processo *processo, int pagina,
+                               EntradaTabelaPagina *entrada, int consumir) {
+    Substituidor *s = gp->substituicao;
+    int quadro = entrada_quadro(*entrada);
+    int dona = s && s->dono_pid[quadro] == processo->id && s->dono_pagina[quadro] == pagina;
+    int referenciada = entrada_tem(*entrada, TP_REFERENCIADA);
+    if (!consumir) {
+        return referenciada || (dona && (s->referencias_colhidas[quadro] & REFERENCIA_PARA_AMOSTRA));
+    }
+    if (dona && substituicao_colher_referencia(s, quadro)) {
+        referenciada = 1;
+    }
+    if (entrada_tem(*entrada, TP_REFERENCIADA)) {
+        entrada_desativar(entrada, TP_REFERENCIADA);
+        if (s) {
+            substituicao_marcar_referencia(s, quadro);
+        }
+    }
+    return referenciada;
+}
+
+// Visita as páginas presentes de um processo: as referenciadas desde a última
+// amostra entram na amostra atual e têm o bit de referência limpo.
+static void amostrar_processo(RastreadorTrabalho *r, GerenciadorProcessos *gp, MemoriaFisica *mf,
+                              Processo *processo, long long tempo) {
+    EstadoTrabalho *estado = estado_do_processo(processo);
+    if (!estado) {
+        return;
+    }
+    int t = r->amostras;
+    int posicao = t % TRABALHO_MAX_JANELA;
+    estado->referenciadas[posicao] = 0;
+    for (int pagina = 0; pagina < processo->num_paginas; pagina++) {
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+        if (!entrada || !entrada_tem(*entrada, TP_PRESENTE)) {
+            continue;
+        }
+        r->paginas_inspecionadas++;
+        if (!pagina_referenciada(gp, processo, pagina, entrada, 1)) {
+            continue;
+        }
+        int anterior = estado->ultima_referencia[pagina];
+        if (anterior != -1 && anterior > t - TRABALHO_MAX_JANELA) {
+            estado->referenciadas[anterior % TRABALHO_MAX_JANELA]--;
+        }
+        estado->ultima_referencia[pagina] = t;
+        estado->referenciadas[posicao]++;
+    }
+
+    estado->conjunto = 0;
+    for (int k = 0; k < r->janela && k <= t; k++) {
+        estado->conjunto += estado->referenciadas[(t - k) % TRABALHO_MAX_JANELA];
+    }
+    if (estado->conjunto > estado->maior_conjunto) {
+        estado->maior_conjunto = estado->conjunto;
+    }
+
+    long long acessos = estado->acessos - estado->acessos_amostra;
+    int faltas = processo->faltas_pagina - estado->faltas_amostra;
+    estado->acessos_amostra = estado->acessos;
+    estado->faltas_amostra = processo->faltas_pagina;
+    if (acessos > 0) {
+        estado->taxa_faltas = (double)faltas / acessos;
+    }
+
+    // Em thrashing, o processo falta demais e seu conjunto de trabalho não cabe nas páginas que tem
+    estado->em_thrashing = acessos > 0 && estado->taxa_faltas > r->limite_superior &&
+                           estado->conjunto > processo->paginas_presentes;
+    estado->amostras++;
+    estado->amostras_thrashing += estado->em_thrashing;
+
+    if (r->pff_ativo && acessos > 0) {
+        ajustar_orcamento(r, mf, processo, estado);
+    }
+
+    AmostraTrabalho amostra = {t, tempo, processo->id, acessos, faltas, processo->paginas_presentes,
+                               estado->conjunto, r->pff_ativo ? estado->orcamento : 0, estado->em_thrashing};
+    if (!registrar_amostra(r, &amostra)) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao ampliar a serie do conjunto de trabalho.\n");
+    }
+
+    // Páginas além do orçamento são cortadas já, começando pelas fora da janela
+    if (r->pff_ativo && estado->orcamento > 0 && processo->paginas_presentes > estado->orcamento) {
+        reduzir_paginas_residentes(gp, mf, processo, estado->orcamento);
+    }
+}
+
+static void amostrar(RastreadorTrabalho *r, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    long long inicio_ns = agora_ns();
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo->ativo) {
+            amostrar_processo(r, gp, mf, processo, r->acessos);
+        }
+    }
+    r->amostras++;
+    r->tempo_amostragem_ns += agora_ns() - inicio_ns;
+}
+
+void conjunto_trabalho_registrar_acesso(RastreadorTrabalho *r, GerenciadorProcessos *gp, MemoriaFisica *mf,
+                                        Processo *processo) {
+    EstadoTrabalho *estado = estado_do_processo(processo);
+    if (estado) {
+        estado->acessos++;
+    }
+    r->acessos++;
+    if (++r->acessos_desde_amostra >= r->intervalo) {
+        r->acessos_desde_amostra = 0;
+        amostrar(r, gp, mf);
+    }
+}
+
+int conjunto_trabalho_orcamento(RastreadorTrabalho *r, Processo *processo) {
+    return r->pff_ativo && processo->trabalho ? processo->trabalho->orcamento : 0;
+}
+
+int conjunto_trabalho_escolher_pagina(RastreadorTrabalho *r, GerenciadorProcessos *gp, Processo *processo) {
+    EstadoTrabalho *estado = estado_do_processo(processo);
+    if (!estado || processo->num_paginas == 0) {
+        return -1;
+    }
+    int vitima = -1, recencia_vitima = 0, candidatos = 0;
+    int pagina = estado->ponteiro % processo->num_paginas;
+    for (int passo = 0; passo < processo->num_paginas && candidatos < TRABALHO_CANDIDATOS_DESPEJO; passo++) {
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+        if (entrada && entrada_tem(*entrada, TP_PRESENTE)) {
+            candidatos++;
+            int recencia = pagina_referenciada(gp, processo, pagina, entrada, 0) ? r->amostras
+                                                                                 : estado->ultima_referencia[pagina];
+            if (vitima == -1 || recencia < recencia_vitima) {
+                vitima = pagina;
+                recencia_vitima = recencia;
+            }
+        }
+        pagina = pagina + 1 < processo->num_paginas ? pagina + 1 : 0;
+    }
+    if (vitima != -1) {
+        estado->ponteiro = vitima + 1 < processo->num_paginas ? vitima + 1 : 0;
+    }
+    return vitima;
+}
+
+void exibir_conjunto_trabalho(RastreadorTrabalho *r, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    printf("\n=== CONJUNTO DE TRABALHO ===\n");
+    printf("Amostras: %d (a cada %d acessos), janela de %d amostras\n", r->amostras, r->intervalo, r->janela);
+    if (r->pff_ativo) {
+        printf("Controle PFF: ativo (faltas por acesso entre %.4f e %.4f, passo de %d quadros)\n",
+               r->limite_inferior, r->limite_superior, r->passo);
+        printf("Ajustes: %lld crescimentos, %lld reducoes; despejos locais: %lld\n",
+               r->crescimentos, r->reducoes, r->despejos_locais);
+    } else {
+        printf("Controle PFF: desativado\n");
+    }
+    printf("Custo das amostras: %.2f ms, %lld paginas inspecionadas\n",
+           r->tempo_amostragem_ns / 1e6, r->paginas_inspecionadas);
+
+    printf("%6s | %10s | %8s | %8s | %10s | %8s | %8s | %9s | %9s\n", "PID", "Acessos", "Faltas", "Taxa",
+           "Residentes", "Conjunto", "Sugerido", "Orcamento", "Thrashing");
+    int em_thrashing = 0;
+    long long quadros_sugeridos = 0;
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        EstadoTrabalho *estado = processo->trabalho;
+        if (!processo->ativo || !estado) {
+            continue;
+        }
+        char orcamento[16];
+        if (r->pff_ativo && estado->orcamento > 0) {
+            snprintf(orcamento, sizeof(orcamento), "%d", estado->orcamento);
+        } else {
+            snprintf(orcamento, sizeof(orcamento), "-");
+        }
+        printf("%6d | %10lld | %8d | %8.4f | %10d | %8d | %8d | %9s | %4d/%-4d%s\n", processo->id, estado->acessos,
+               processo->faltas_pagina, estado->taxa_faltas, processo->paginas_presentes, estado->conjunto,
+               estado->maior_conjunto, orcamento, estado->amostras_thrashing, estado->amostras,
+               estado->em_thrashing ? " *" : "");
+        em_thrashing += estado->em_thrashing;
+        quadros_sugeridos += estado->maior_conjunto;
+    }
+    // O maior conjunto de trabalho observado é o tamanho residente que elimina as faltas fora das transições de fase
+    printf("Processos em thrashing (*): %d\n", em_thrashing);
+    printf("Quadros para manter todos os conjuntos de trabalho: %lld de %d\n", quadros_sugeridos, mf->numero_quadros);
+    printf("============================\n\n");
+}
+
+int exportar_serie_trabalho(RastreadorTrabalho *r, const char *arquivo) {
+    FILE *saida = fopen(arquivo, "w");
+    if (!saida) {
+        RELATAR_ERRO(ERRO_ARQUIVO, "Falha ao abrir o arquivo %s para a serie do conjunto de trabalho.\n", arquivo);
+        return 0;
+    }
+    fprintf(saida, "amostra,tempo_virtual,pid,acessos,faltas,taxa_faltas,residentes,conjunto_trabalho,orcamento,thrashing\n");
+    for (int i = 0; i < r->tamanho_serie; i++) {
+        const AmostraTrabalho *a = &r->serie[i];
+        fprintf(saida, "%d,%lld,%d,%lld,%d,%.6f,%d,%d,%d,%d\n", a->amostra, a->tempo, a->pid, a->acessos, a->faltas,
+                a->acessos > 0 ? (double)a->faltas / a->acessos : 0.0, a->residentes, a->conjunto,
+                a->orcamento, a->thrashing);
+    }
+    fclose(saida);
+    REGISTRAR_INFO("Serie do conjunto de trabalho (%d linhas) gravada em %s.\n", r->tamanho_serie, arquivo);
+    return 1;
+}
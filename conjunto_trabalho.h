@@ -0,0 +1,173 @@
+#ifndef CONJUNTO_TRABALHO_H
+#define CONJUNTO_TRABALHO_H
+
+#include "memoria.h"
+#include "processo.h"
+
+// Amostras lembradas por processo (a janela tem no máximo TRABALHO_MAX_JANELA - 1 amostras)
+#define TRABALHO_MAX_JANELA 32
+// Páginas presentes inspecionadas para escolher a vítima de um despejo local
+#define TRABALHO_CANDIDATOS_DESPEJO 64
+// Valores padrão da amostragem e do controle PFF
+#define TRABALHO_INTERVALO_PADRAO 4096
+#define TRABALHO_JANELA_PADRAO 8
+#define TRABALHO_PFF_INFERIOR_PADRAO 0.002
+#define TRABALHO_PFF_SUPERIOR_PADRAO 0.02
+#define TRABALHO_PFF_PASSO_PADRAO 8
+
+// Histórico de referências de um processo, reconstruído a cada amostra a
+// partir dos bits de referência das suas páginas presentes
+typedef struct EstadoTrabalho {
+    int *ultima_referencia;           // Última amostra em que cada página estava referenciada (-1 = nunca)
+    int referenciadas[TRABALHO_MAX_JANELA]; // Páginas cuja última referência foi em cada amostra (anel)
+    long long acessos;                // Acessos do processo (seu tempo virtual)
+    long long acessos_amostra;        // Valor de acessos na amostra anterior
+    int faltas_amostra;               // Valor de faltas_pagina na amostra anterior
+    int conjunto;                     // Tamanho do conjunto de trabalho na última amostra
+    int maior_conjunto;               // Maior conjunto de trabalho observado
+    double taxa_faltas;               // Faltas por acesso no último intervalo com acessos
+    int orcamento;                    // Quadros permitidos pelo controle PFF (0 = sem limite)
+    int ponteiro;                     // Próxima página inspecionada no despejo local
+    int amostras;                     // Amostras em que o processo existia
+    int amostras_thrashing;           // Amostras em que o processo estava em thrashing
+    int em_thrashing;                 // 1 se a última amostra o encontrou em thrashing
+    long long despejos_locais;        // Páginas despejadas para respeitar o orçamento
+} EstadoTrabalho;
+
+// Linha da série temporal: um processo em uma amostra
+typedef struct {
+    int amostra;                      // Número da amostra
+    long long tempo;                  // Acessos de todos os processos até a amostra (tempo virtual global)
+    int pid;                          // Processo
+    long long acessos;                // Acessos do processo no intervalo
+    int faltas;                       // Faltas do processo no intervalo
+    int residentes;                   // Páginas presentes
+    int conjunto;                     // Tamanho do conjunto de trabalho
+    int orcamento;                    // Orçamento de quadros (0 = sem limite)
+    int thrashing;                    // 1 se o processo estava em thrashing
+} AmostraTrabalho;
+
+// Estimativa do conjunto de trabalho dos processos e controle da frequência
+// de faltas (PFF). Como o kernel, o rastreador não vê os acessos: a cada
+// intervalo ele percorre as páginas presentes, anota as referenciadas e limpa
+// o bit de referência, trocando marcas com a política de substituição para
+// que nenhum dos dois perca as referências que o outro colheu. O conjunto de
+// trabalho de um processo são as páginas referenciadas nas últimas `janela` amostras.
+typedef struct RastreadorTrabalho {
+    int intervalo;                    // Acessos (de todos os processos) entre duas amostras
+    int janela;                       // Amostras na janela do conjunto de trabalho
+    long long acessos;                // Acessos desde a criação
+    int acessos_desde_amostra;        // Acessos desde a última amostra
+    int amostras;                     // Amostras feitas (também o número da próxima)
+
+    // Controle PFF: com muitas faltas por acesso o orçamento cresce, com poucas encolhe
+    int pff_ativo;                    // 1 se os orçamentos são ajustados e respeitados
+    double limite_inferior;           // Faltas por acesso abaixo das quais o orçamento encolhe
+    double limite_superior;           // Faltas por acesso acima das quais o orçamento cresce
+    int passo;                        // Quadros acrescentados ou retirados por ajuste
+
+    AmostraTrabalho *serie;           // Série temporal de todas as amostras
+    int tamanho_serie;
+    int capacidade_serie;
+
+    // Estatísticas
+    long long paginas_inspecionadas;  // Entradas visitadas pelas amostras
+    long long tempo_amostragem_ns;    // Tempo gasto nas amostras, incluindo os cortes do PFF
+    long long despejos_locais;        // Páginas despejadas para respeitar os orçamentos
+    long long crescimentos;           // Ajustes do PFF que aumentaram um orçamento
+    long long reducoes;               // Ajustes do PFF que reduziram um orçamento
+} RastreadorTrabalho;
+
+/**
+ * @brief Cria o rastreador do conjunto de trabalho, com o controle PFF desligado.
+ *
+ * @param intervalo Acessos entre duas amostras.
+ * @param janela Amostras na janela do conjunto de trabalho (1 a TRABALHO_MAX_JANELA - 1).
+ * @return Ponteiro para o rastreador, ou NULL em caso de erro.
+ */
+RastreadorTrabalho* criar_rastreador_trabalho(int intervalo, int janela);
+
+/**
+ * @brief Libera o rastreador (os estados dos processos são liberados com eles).
+ *
+ * @param r Ponteiro para o rastreador (pode ser NULL).
+ */
+void destruir_rastreador_trabalho(RastreadorTrabalho *r);
+
+/**
+ * @brief Liga ou desliga o controle PFF dos orçamentos de quadros.
+ *
+ * @param r Ponteiro para o rastreador.
+ * @param ativo 1 para ligar, 0 para desligar (os orçamentos deixam de valer).
+ * @param limite_inferior Faltas por acesso abaixo das quais o orçamento encolhe.
+ * @param limite_superior Faltas por acesso acima das quais o orçamento cresce.
+ * @param passo Quadros acrescentados ou retirados por ajuste.
+ * @return 1 se sucesso, 0 se os parâmetros forem inválidos.
+ */
+int configurar_controle_pff(RastreadorTrabalho *r, int ativo, double limite_inferior,
+                            double limite_superior, int passo);
+
+/**
+ * @brief Conta um acesso de um processo e, ao fim do intervalo, amostra todos os processos.
+ *
+ * Deve ser chamada antes da tradução, pois a amostra pode despejar páginas
+ * de processos acima do orçamento.
+ *
+ * @param r Ponteiro para o rastreador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param processo Processo que fez o acesso.
+ */
+void conjunto_trabalho_registrar_acesso(RastreadorTrabalho *r, GerenciadorProcessos *gp, MemoriaFisica *mf,
+                                        Processo *processo);
+
+/**
+ * @brief Retorna o orçamento de quadros de um processo.
+ *
+ * @param r Ponteiro para o rastreador.
+ * @param processo Ponteiro para o processo.
+ * @return O orçamento, ou 0 se não houver limite (PFF desligado ou processo ainda não amostrado).
+ */
+int conjunto_trabalho_orcamento(RastreadorTrabalho *r, Processo *processo);
+
+/**
+ * @brief Escolhe uma página presente do processo para um despejo local.
+ *
+ * A partir do ponteiro do processo, inspeciona até TRABALHO_CANDIDATOS_DESPEJO
+ * páginas presentes e escolhe a referenciada há mais amostras; as
+ * referenciadas desde a última amostra contam como as mais recentes.
+ *
+ * @param r Ponteiro para o rastreador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param processo Ponteiro para o processo.
+ * @return Número da página, ou -1 se o processo não tiver páginas presentes.
+ */
+int conjunto_trabalho_escolher_pagina(RastreadorTrabalho *r, GerenciadorProcessos *gp, Processo *processo);
+
+/**
+ * @brief Libera o histórico de um processo.
+ *
+ * @param estado Ponteiro para o histórico (pode ser NULL).
+ */
+void liberar_estado_trabalho(EstadoTrabalho *estado);
+
+/**
+ * @brief Exibe, para cada processo, a taxa de faltas, as páginas residentes, o
+ * conjunto de trabalho e o tamanho residente que eliminaria suas faltas.
+ *
+ * @param r Ponteiro para o rastreador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ */
+void exibir_conjunto_trabalho(RastreadorTrabalho *r, GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Grava a série temporal das amostras em CSV, uma linha por processo e amostra.
+ *
+ * @param r Ponteiro para o rastreador.
+ * @param arquivo Caminho do arquivo.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int exportar_serie_trabalho(RastreadorTrabalho *r, const char *arquivo);
+
+#endif // CONJUNTO_TRABALHO_H
@@ -0,0 +1,223 @@
+#include "deduplicacao.h"
+#include "substituicao.h"
+#include <string.h>
+
+// Constantes das rodadas do xxHash64
+#define HASH_PRIMO_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIMO_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIMO_3 0x165667B19E3779F9ULL
+
+static void esvaziar_tabela(Deduplicador *d) {
+    for (int i = 0; i < d->capacidade_tabela; i++) {
+        d->tabela[i].quadro = -1;
+    }
+}
+
+Deduplicador* criar_deduplicador(int numero_quadros, int quadros_por_passo, int intervalo) {
+    if (quadros_por_passo < 1 || intervalo < 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Quadros por passo (%d) ou intervalo (%d) da deduplicacao invalidos.\n",
+                     quadros_por_passo, intervalo);
+        return NULL;
+    }
+    Deduplicador *d = (Deduplicador*)calloc(1, sizeof(Deduplicador));
+    if (!d) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o deduplicador.\n");
+        return NULL;
+    }
+    // Uma varredura insere no máximo um quadro por posição: a tabela fica no máximo meio cheia
+    d->capacidade_tabela = 1;
+    while (d->capacidade_tabela < 2 * numero_quadros) {
+        d->capacidade_tabela *= 2;
+    }
+    d->tabela = (EntradaDeduplicacao*)malloc((size_t)d->capacidade_tabela * sizeof(EntradaDeduplicacao));
+    if (!d->tabela) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar a tabela da deduplicacao.\n");
+        free(d);
+        return NULL;
+    }
+    esvaziar_tabela(d);
+    d->quadros_por_passo = quadros_por_passo;
+    d->intervalo = intervalo;
+    if (intervalo > 0) {
+        REGISTRAR_INFO("Deduplicacao: %d quadros a cada %d operacoes.\n", quadros_por_passo, intervalo);
+    } else {
+        REGISTRAR_INFO("Deduplicacao: %d quadros por passo, sob pedido.\n", quadros_por_passo);
+    }
+    return d;
+}
+
+void destruir_deduplicador(Deduplicador *d) {
+    if (!d) {
+        return;
+    }
+    free(d->tabela);
+    free(d);
+}
+
+static inline uint64_t rotacionar(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// Uma rodada do xxHash64: acumula uma palavra de 8 bytes
+static inline uint64_t rodada_hash(uint64_t acumulador, const unsigned char *dados) {
+    uint64_t palavra;
+    memcpy(&palavra, dados, sizeof(palavra));
+    return rotacionar(acumulador + palavra * HASH_PRIMO_2, 31) * HASH_PRIMO_1;
+}
+
+uint64_t hash_quadro(const unsigned char *dados, size_t bytes) {
+    uint64_t a0 = HASH_PRIMO_1 + HASH_PRIMO_2, a1 = HASH_PRIMO_2, a2 = 0, a3 = -HASH_PRIMO_1;
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        a0 = rodada_hash(a0, dados + i);
+        a1 = rodada_hash(a1, dados + i + 8);
+        a2 = rodada_hash(a2, dados + i + 16);
+        a3 = rodada_hash(a3, dados + i + 24);
+    }
+    uint64_t h = rotacionar(a0, 1) + rotacionar(a1, 7) + rotacionar(a2, 12) + rotacionar(a3, 18);
+    for (; i < bytes; i++) {
+        h = (h ^ dados[i]) * HASH_PRIMO_1;
+    }
+    h ^= (uint64_t)bytes;
+    h = (h ^ (h >> 33)) * HASH_PRIMO_2;
+    h = (h ^ (h >> 29)) * HASH_PRIMO_3;
+    return h ^ (h >> 32);
+}
+
+// Procura na tabela um quadro com o conteúdo do quadro examinado e, se houver,
+// mescla os dois; senão, o quadro examinado entra na tabela. Retorna 1 se o
+// quadro foi mesclado.
+static int examinar_quadro(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf, int quadro) {
+    Substituidor *s = gp->substituicao;
+    if (quadro_esta_livre(mf, quadro) || !s || s->dono_pid[quadro] == -1) {
+        return 0;
+    }
+    const unsigned char *dados = mf->memoria + (size_t)quadro * mf->tamanho_pagina;
+    long long inicio_ns = agora_ns();
+    uint64_t hash = hash_quadro(dados, mf->tamanho_pagina);
+    d->tempo_hash_ns += agora_ns() - inicio_ns;
+    d->quadros_examinados++;
+    d->bytes_hash += mf->tamanho_pagina;
+
+    int mascara = d->capacidade_tabela - 1;
+    for (int i = (int)(hash & (uint64_t)mascara);; i = (i + 1) & mascara) {
+        EntradaDeduplicacao *entrada = &d->tabela[i];
+        if (entrada->quadro == -1) {
+            entrada->hash = hash;
+            entrada->quadro = quadro;
+            return 0;
+        }
+        if (entrada->hash != hash) {
+            continue;
+        }
+        // O quadro da tabela pode ter sido liberado, reaproveitado, migrado
+        // ou escrito desde que foi examinado: nesse caso o examinado o substitui
+        int outro = entrada->quadro;
+        if (outro == quadro) {
+            return 0;
+        }
+        if (quadro_esta_livre(mf, outro) || s->dono_pid[outro] == -1) {
+            entrada->quadro = quadro;
+            return 0;
+        }
+        // Um quadro que já chegou ao limite de mapeamentos deixa a tabela, e
+        // as próximas cópias passam a ser mescladas ao examinado
+        if (referencias_quadro(mf, outro) + referencias_quadro(mf, quadro) > DEDUPLICACAO_MAX_COMPARTILHAMENTO) {
+            d->mesclas_recusadas++;
+            entrada->quadro = quadro;
+            return 0;
+        }
+        d->comparacoes++;
+        if (memcmp(dados, mf->memoria + (size_t)outro * mf->tamanho_pagina, mf->tamanho_pagina) != 0) {
+            d->comparacoes_diferentes++;
+            entrada->quadro = quadro;
+            return 0;
+        }
+        if (!mesclar_quadros(gp, mf, quadro, outro)) {
+            return 0;
+        }
+        d->quadros_mesclados++;
+        return 1;
+    }
+}
+
+int deduplicacao_passo(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (gp->concorrente) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A deduplicacao nao e suportada no modo concorrente.\n");
+        return 0;
+    }
+    long long inicio_ns = agora_ns();
+    int mesclados = 0;
+    for (int i = 0; i < d->quadros_por_passo; i++) {
+        if (d->cursor >= mf->numero_quadros) {
+            d->cursor = 0;
+            d->varreduras++;
+            esvaziar_tabela(d);
+            REGISTRAR_DEPURACAO("Deduplicacao: varredura terminada, %lld quadros mesclados ate agora.\n",
+                                d->quadros_mesclados);
+            break;
+        }
+        mesclados += examinar_quadro(d, gp, mf, d->cursor++);
+    }
+
+    long long duracao = agora_ns() - inicio_ns;
+    d->passos++;
+    d->tempo_ns += duracao;
+    if (duracao > d->tempo_max_passo_ns) {
+        d->tempo_max_passo_ns = duracao;
+    }
+    return mesclados;
+}
+
+void deduplicacao_registrar_operacao(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (d->intervalo > 0 && ++d->operacoes_desde_passo >= d->intervalo) {
+        d->operacoes_desde_passo = 0;
+        deduplicacao_passo(d, gp, mf);
+    }
+}
+
+long long deduplicar_memoria(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    long long mesclados = 0;
+    long long varreduras = d->varreduras;
+    while (d->varreduras == varreduras && !gp->concorrente) {
+        mesclados += deduplicacao_passo(d, gp, mf);
+    }
+    return mesclados;
+}
+
+long long quadros_economizados(MemoriaFisica *mf) {
+    long long economizados = 0;
+    for (int q = 0; q < mf->numero_quadros; q++) {
+        int referencias = referencias_quadro(mf, q);
+        if (referencias > 1) {
+            economizados += referencias - 1;
+        }
+    }
+    return economizados;
+}
+
+void exibir_estatisticas_deduplicacao(Deduplicador *d, MemoriaFisica *mf) {
+    long long economizados = quadros_economizados(mf);
+    double mb_por_quadro = mf->tamanho_pagina / (1024.0 * 1024.0);
+
+    printf("\n=== DEDUPLICACAO DE PAGINAS ===\n");
+    if (d->intervalo > 0) {
+        printf("Varredura: %d quadros a cada %d operacoes\n", d->quadros_por_passo, d->intervalo);
+    } else {
+        printf("Varredura: %d quadros por passo, sob pedido\n", d->quadros_por_passo);
+    }
+    printf("Varreduras completas: %lld (atual no quadro %d de %d)\n", d->varreduras, d->cursor, mf->numero_quadros);
+    printf("Quadros mesclados: %lld (%.2f MB)\n", d->quadros_mesclados, d->quadros_mesclados * mb_por_quadro);
+    printf("Quadros compartilhados agora: %d, economizados: %lld (%.2f MB, %.1f%% da memoria)\n",
+           mf->quadros_compartilhados, economizados, economizados * mb_por_quadro,
+           100.0 * economizados / mf->numero_quadros);
+    printf("Quadros examinados: %lld (%.2f MB, hash a %.2f GB/s)\n", d->quadros_examinados,
+           d->bytes_hash / (1024.0 * 1024.0), d->tempo_hash_ns > 0 ? (double)d->bytes_hash / d->tempo_hash_ns : 0.0);
+    printf("Comparacoes: %lld (%lld com conteudo diferente)\n", d->comparacoes, d->comparacoes_diferentes);
+    printf("Mesclas recusadas pelo limite de %d mapeamentos por quadro: %lld\n", DEDUPLICACAO_MAX_COMPARTILHAMENTO,
+           d->mesclas_recusadas);
+    printf("Passos: %lld, tempo medio: %.1f us, maximo: %.1f us, total: %.2f ms (%.0f ns por quadro examinado)\n",
+           d->passos, d->passos > 0 ? d->tempo_ns / 1e3 / d->passos : 0.0, d->tempo_max_passo_ns / 1e3,
+           d->tempo_ns / 1e6, d->quadros_examinados > 0 ? (double)d->tempo_ns / d->quadros_examinados : 0.0);
+    printf("===============================\n\n");
+}
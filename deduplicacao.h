@@ -0,0 +1,130 @@
+#ifndef DEDUPLICACAO_H
+#define DEDUPLICACAO_H
+
+#include "memoria.h"
+#include "processo.h"
+
+// Valores padrão da varredura automática
+#define DEDUPLICACAO_QUADROS_POR_PASSO_PADRAO 256
+#define DEDUPLICACAO_INTERVALO_PADRAO 16
+
+// Mapeamentos de um quadro mesclado, como o max_page_sharing do KSM. Limita a
+// busca pelas páginas que compartilham um quadro ao despejá-lo ou migrá-lo.
+#define DEDUPLICACAO_MAX_COMPARTILHAMENTO 256
+
+// Posição da tabela de conteúdos (endereçamento aberto com sondagem linear)
+typedef struct {
+    uint64_t hash;                    // Hash do conteúdo do quadro quando foi examinado
+    int quadro;                       // Quadro examinado (-1 se a posição está vazia)
+} EntradaDeduplicacao;
+
+// Deduplicação de páginas idênticas, como o KSM do Linux. Uma varredura
+// percorre os quadros ocupados, alguns a cada passo, calcula o hash do
+// conteúdo de cada um e o procura em uma tabela com os quadros já examinados
+// na varredura. Se um quadro da tabela tiver o mesmo conteúdo (conferido byte
+// a byte), as páginas do quadro examinado passam a mapeá-lo com cópia na
+// escrita, e o quadro examinado é liberado. As páginas mescladas podem ter
+// números diferentes e ser do mesmo processo, como as páginas zeradas e as de
+// uma biblioteca carregada em posições diferentes.
+typedef struct Deduplicador {
+    int quadros_por_passo;            // Quadros examinados em um passo
+    int intervalo;                    // Operações entre dois passos automáticos (0 = só manual)
+    int operacoes_desde_passo;        // Operações desde o último passo automático
+    int cursor;                       // Próximo quadro examinado na varredura
+
+    EntradaDeduplicacao *tabela;      // Quadros examinados na varredura atual, pelo hash
+    int capacidade_tabela;            // Posições da tabela (potência de dois)
+
+    // Estatísticas
+    long long passos;                 // Passos executados
+    long long varreduras;             // Varreduras completas
+    long long quadros_examinados;     // Quadros ocupados cujo hash foi calculado
+    long long bytes_hash;             // Bytes lidos pelo hash
+    long long comparacoes;            // Comparações byte a byte de quadros com o mesmo hash
+    long long comparacoes_diferentes; // Comparações de conteúdos diferentes (colisões ou quadros alterados)
+    long long quadros_mesclados;      // Quadros liberados por terem conteúdo igual ao de outro
+    long long mesclas_recusadas;      // Mesclas que passariam de DEDUPLICACAO_MAX_COMPARTILHAMENTO mapeamentos
+    long long tempo_hash_ns;          // Tempo gasto calculando hashes
+    long long tempo_ns;               // Tempo gasto nos passos
+    long long tempo_max_passo_ns;     // Passo mais demorado
+} Deduplicador;
+
+/**
+ * @brief Cria o deduplicador.
+ *
+ * @param numero_quadros Quadros da memória física.
+ * @param quadros_por_passo Quadros examinados em um passo.
+ * @param intervalo Operações entre dois passos automáticos (0 para só deduplicar sob pedido).
+ * @return Ponteiro para o deduplicador, ou NULL em caso de erro.
+ */
+Deduplicador* criar_deduplicador(int numero_quadros, int quadros_por_passo, int intervalo);
+
+/**
+ * @brief Libera o deduplicador.
+ *
+ * @param d Ponteiro para o deduplicador (pode ser NULL).
+ */
+void destruir_deduplicador(Deduplicador *d);
+
+/**
+ * @brief Calcula o hash do conteúdo de um quadro.
+ *
+ * O quadro é lido em palavras de 64 bits por quatro acumuladores
+ * independentes, cujas multiplicações se sobrepõem no processador e podem
+ * ser vetorizadas, combinados no final.
+ *
+ * @param dados Início do quadro.
+ * @param bytes Tamanho do quadro (múltiplo de 32).
+ * @return Hash de 64 bits do conteúdo.
+ */
+uint64_t hash_quadro(const unsigned char *dados, size_t bytes);
+
+/**
+ * @brief Executa um passo da varredura, examinando até quadros_por_passo quadros.
+ *
+ * Ao chegar ao fim da memória, a varredura termina, a tabela é esvaziada e a
+ * próxima começa do primeiro quadro.
+ *
+ * @param d Ponteiro para o deduplicador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @return Número de quadros mesclados no passo.
+ */
+int deduplicacao_passo(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Conta uma operação e, a cada `intervalo` operações, executa um passo.
+ *
+ * @param d Ponteiro para o deduplicador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ */
+void deduplicacao_registrar_operacao(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Deduplica sob pedido, até o fim da varredura atual (ou de uma completa, se nenhuma estiver em andamento).
+ *
+ * @param d Ponteiro para o deduplicador.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @return Número de quadros mesclados.
+ */
+long long deduplicar_memoria(Deduplicador *d, GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Conta os quadros economizados agora pelo compartilhamento (por fork ou deduplicação).
+ *
+ * @param mf Ponteiro para a memória física.
+ * @return Soma, nos quadros ocupados, dos mapeamentos além do primeiro.
+ */
+long long quadros_economizados(MemoriaFisica *mf);
+
+/**
+ * @brief Exibe os quadros mesclados e economizados e o custo da varredura.
+ *
+ * @param d Ponteiro para o deduplicador.
+ * @param mf Ponteiro para a memória física.
+ */
+void exibir_estatisticas_deduplicacao(Deduplicador *d, MemoriaFisica *mf);
+
+#endif // DEDUPLICACAO_H
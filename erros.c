@@ -0,0 +1,45 @@
+#include "erros.h"
+
+_Thread_local CodigoErro ultimo_erro = ERRO_NENHUM;
+
+CodigoErro obter_ultimo_erro(void) {
+    return ultimo_erro;
+}
+
+void limpar_erro(void) {
+    ultimo_erro = ERRO_NENHUM;
+}
+
+const char* nome_erro(CodigoErro codigo) {
+    switch (codigo) {
+        case ERRO_NENHUM:               return "nenhum";
+        case ERRO_PARAMETRO_INVALIDO:   return "parametro_invalido";
+        case ERRO_SEM_MEMORIA:          return "sem_memoria";
+        case ERRO_ARQUIVO:              return "arquivo";
+        case ERRO_TAMANHO_INVALIDO:     return "tamanho_invalido";
+        case ERRO_SEM_QUADROS:          return "sem_quadros";
+        case ERRO_QUADRO_INVALIDO:      return "quadro_invalido";
+        case ERRO_ENDERECO_INVALIDO:    return "endereco_invalido";
+        case ERRO_PROCESSO_INEXISTENTE: return "processo_inexistente";
+        case ERRO_PROCESSO_EXISTENTE:   return "processo_existente";
+        case ERRO_PROTECAO:             return "protecao";
+        default:                        return "desconhecido";
+    }
+}
+
+const char* descricao_erro(CodigoErro codigo) {
+    switch (codigo) {
+        case ERRO_NENHUM:               return "Nenhum erro";
+        case ERRO_PARAMETRO_INVALIDO:   return "Parametro invalido";
+        case ERRO_SEM_MEMORIA:          return "Memoria insuficiente no hospedeiro";
+        case ERRO_ARQUIVO:              return "Falha no arquivo da memoria fisica";
+        case ERRO_TAMANHO_INVALIDO:     return "Tamanho invalido";
+        case ERRO_SEM_QUADROS:          return "Nao ha quadros livres";
+        case ERRO_QUADRO_INVALIDO:      return "Quadro invalido";
+        case ERRO_ENDERECO_INVALIDO:    return "Endereco invalido";
+        case ERRO_PROCESSO_INEXISTENTE: return "Processo nao encontrado";
+        case ERRO_PROCESSO_EXISTENTE:   return "Processo ja existe";
+        case ERRO_PROTECAO:             return "Violacao de protecao";
+        default:                        return "Erro desconhecido";
+    }
+}
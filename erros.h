@@ -0,0 +1,61 @@
+#ifndef ERROS_H
+#define ERROS_H
+
+#include "registro.h"
+
+// Códigos de erro das operações do simulador. As funções mantêm seus retornos
+// (0 ou -1 em caso de falha) e, como errno, guardam o motivo em ultimo_erro.
+typedef enum {
+    ERRO_NENHUM = 0,
+    ERRO_PARAMETRO_INVALIDO = 1,      // Argumento nulo, estrutura não criada ou opção fora do intervalo
+    ERRO_SEM_MEMORIA = 2,             // Falha ao alocar memória do hospedeiro
+    ERRO_ARQUIVO = 3,                 // Falha ao abrir ou ajustar o arquivo da memória física
+    ERRO_TAMANHO_INVALIDO = 4,        // Tamanho de memória, página ou processo inválido
+    ERRO_SEM_QUADROS = 5,             // Não há quadros livres (nem páginas que possam ser despejadas)
+    ERRO_QUADRO_INVALIDO = 6,         // Índice ou intervalo de quadros fora da memória física
+    ERRO_ENDERECO_INVALIDO = 7,       // Endereço físico ou lógico (ou página) fora dos limites
+    ERRO_PROCESSO_INEXISTENTE = 8,    // Nenhum processo com o ID informado
+    ERRO_PROCESSO_EXISTENTE = 9,      // Já existe um processo com o ID informado
+    ERRO_PROTECAO = 10,               // Acesso não permitido pelos bits de proteção da página
+    NUM_CODIGOS_ERRO = 11
+} CodigoErro;
+
+// Motivo da última falha da thread corrente (não é zerado pelas operações bem-sucedidas)
+extern _Thread_local CodigoErro ultimo_erro;
+
+/**
+ * @brief Retorna o motivo da última falha da thread corrente.
+ *
+ * @return Código do erro (ERRO_NENHUM se nenhuma falha foi registrada desde limpar_erro).
+ */
+CodigoErro obter_ultimo_erro(void);
+
+/**
+ * @brief Zera o último erro, para distinguir as falhas da próxima operação.
+ */
+void limpar_erro(void);
+
+/**
+ * @brief Retorna o identificador de um código de erro (ex.: "sem_quadros").
+ *
+ * @param codigo O código.
+ * @return Identificador do código.
+ */
+const char* nome_erro(CodigoErro codigo);
+
+/**
+ * @brief Retorna a descrição legível de um código de erro.
+ *
+ * @param codigo O código.
+ * @return Descrição do erro.
+ */
+const char* descricao_erro(CodigoErro codigo);
+
+// Registra o motivo da falha e, se o nível permitir, exibe a mensagem de erro
+#define RELATAR_ERRO(codigo, ...) \
+    do { \
+        ultimo_erro = (codigo); \
+        REGISTRAR_ERRO(__VA_ARGS__); \
+    } while (0)
+
+#endif // ERROS_H
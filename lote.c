@@ -0,0 +1,396 @@
+#include "lote.h"
+#include "substituicao.h"
+#include "conjunto_trabalho.h"
+#include "compactacao.h"
+#include "deduplicacao.h"
+#include "cache_comprimido.h"
+#include <string.h>
+
+#define TAMANHO_LINHA_LOTE 256
+
+static const char *nomes_operacoes[NUM_TIPOS_OPERACAO] = {"criar", "remover", "ler", "escrever", "traduzir", "fork"};
+
+// Campos de cada operação na linha do rastro, incluindo o comando
+static const int campos_operacoes[NUM_TIPOS_OPERACAO] = {3, 2, 3, 4, 3, 3};
+
+static int registrar_latencia(ResultadoLote *resultado, long long latencia_ns) {
+    if (resultado->num_latencias == resultado->capacidade_latencias) {
+        long long nova_capacidade = resultado->capacidade_latencias ? resultado->capacidade_latencias * 2 : 4096;
+        long long *novas = (long long*)realloc(resultado->latencias_ns, nova_capacidade * sizeof(long long));
+        if (!novas) {
+            return 0;
+        }
+        resultado->latencias_ns = novas;
+        resultado->capacidade_latencias = nova_capacidade;
+    }
+    resultado->latencias_ns[resultado->num_latencias++] = latencia_ns;
+    return 1;
+}
+
+const char* nome_tipo_operacao(TipoOperacao tipo) {
+    return tipo >= 0 && tipo < NUM_TIPOS_OPERACAO ? nomes_operacoes[tipo] : "desconhecida";
+}
+
+int executar_operacao(GerenciadorProcessos *gp, MemoriaFisica *mf, TipoOperacao tipo, int pid,
+                      uint64_t argumento, unsigned char valor, size_t tamanho_max_processo) {
+    switch (tipo) {
+        case OP_CRIAR:
+            return criar_processo(gp, mf, pid, (size_t)argumento, mf->tamanho_pagina, tamanho_max_processo) != -1;
+        case OP_REMOVER:
+            return remover_processo(gp, mf, pid);
+        case OP_LER:
+            return ler_logico(gp, mf, pid, argumento) != -1;
+        case OP_ESCREVER:
+            return escrever_logico(gp, mf, pid, argumento, valor);
+        case OP_TRADUZIR:
+            return traduzir_endereco(gp, mf, pid, argumento) != -1;
+        case OP_FORK:
+            return fork_processo(gp, mf, pid, (int)argumento) != -1;
+        default:
+            return 0;
+    }
+}
+
+// Aplica uma linha de configuração; retorna 0 se a linha não é de configuração
+static int aplicar_configuracao(GerenciadorProcessos *gp, MemoriaFisica *mf, const char *comando,
+                                int num_campos, long long a, long long b, long long c) {
+    if (strcmp(comando, "demanda") == 0 && num_campos >= 2) {
+        definir_paginacao_sob_demanda(gp, (int)a);
+    } else if (strcmp(comando, "sem_copia") == 0 && num_campos >= 2) {
+        definir_imagens_sem_copia(gp, (int)a);
+    } else if (strcmp(comando, "alocacao") == 0 && num_campos >= 2) {
+        definir_politica_alocacao(mf, (PoliticaAlocacao)a);
+    } else if (strcmp(comando, "substituicao") == 0 && num_campos >= 2) {
+        Substituidor *s = obter_substituidor(gp, mf);
+        if (s) {
+            definir_politica_substituicao(s, (PoliticaSubstituicao)a);
+        }
+    } else if (strcmp(comando, "tlb") == 0 && num_campos >= 2) {
+        configurar_tlb(gp, (int)a, num_campos >= 3 ? (int)b : 1, num_campos >= 4 ? (int)c : 0);
+    } else if (strcmp(comando, "tabela") == 0 && num_campos >= 2) {
+        definir_tipo_tabela_paginas(gp, (TipoTabelaPaginas)a);
+    } else if (strcmp(comando, "threads") == 0 && num_campos >= 2) {
+        definir_threads_carga(gp, (int)a);
+    } else if (strcmp(comando, "swap") == 0 && num_campos >= 2) {
+        // swap <MB> [latência em us] [MB/s], numa região da memória do hospedeiro
+        configurar_swap(gp, mf, (size_t)a * 1024 * 1024, NULL, num_campos >= 3 ? b * 1000 : 0,
+                        num_campos >= 4 ? c * 1024 * 1024 : 0);
+    } else if (strcmp(comando, "cache_comprimido") == 0 && num_campos >= 2) {
+        // cache_comprimido <quadros> [limite em percentual da página]
+        configurar_cache_comprimido(gp, mf, (int)a, num_campos >= 3 ? (int)b : CACHE_COMPRIMIDO_LIMITE_PADRAO);
+    } else if (strcmp(comando, "entropia") == 0 && num_campos >= 2) {
+        definir_entropia_imagens(gp, (int)a);
+    } else if (strcmp(comando, "trabalho") == 0 && num_campos >= 2) {
+        // trabalho <intervalo> [janela]
+        configurar_conjunto_trabalho(gp, (int)a, num_campos >= 3 ? (int)b : TRABALHO_JANELA_PADRAO);
+    } else if (strcmp(comando, "pff") == 0 && num_campos >= 2) {
+        // pff <0|1> [limite inferior] [limite superior], em faltas por mil acessos
+        if (!gp->conjunto_trabalho) {
+            RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O controle PFF exige o conjunto de trabalho ativo.\n");
+        } else {
+            configurar_controle_pff(gp->conjunto_trabalho, (int)a,
+                                    num_campos >= 3 ? b / 1000.0 : TRABALHO_PFF_INFERIOR_PADRAO,
+                                    num_campos >= 4 ? c / 1000.0 : TRABALHO_PFF_SUPERIOR_PADRAO,
+                                    TRABALHO_PFF_PASSO_PADRAO);
+        }
+    } else if (strcmp(comando, "compactacao") == 0 && num_campos >= 2) {
+        // compactacao <quadros por passo> [operações entre passos]
+        configurar_compactacao(gp, (int)a, num_campos >= 3 ? (int)b : COMPACTACAO_INTERVALO_PADRAO);
+    } else if (strcmp(comando, "compactar") == 0) {
+        // Passagem completa sob pedido
+        if (!gp->compactacao) {
+            RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A compactacao nao foi configurada.\n");
+        } else {
+            compactar_memoria(gp->compactacao, gp, mf, 0);
+        }
+    } else if (strcmp(comando, "deduplicacao") == 0 && num_campos >= 2) {
+        // deduplicacao <quadros por passo> [operações entre passos]
+        configurar_deduplicacao(gp, mf, (int)a, num_campos >= 3 ? (int)b : DEDUPLICACAO_INTERVALO_PADRAO);
+    } else if (strcmp(comando, "deduplicar") == 0) {
+        // Varredura completa sob pedido
+        if (!gp->deduplicacao) {
+            RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A deduplicacao nao foi configurada.\n");
+        } else {
+            deduplicar_memoria(gp->deduplicacao, gp, mf);
+        }
+    } else if (strcmp(comando, "imagem_comum") == 0 && num_campos >= 2) {
+        definir_imagem_comum(gp, (int)a);
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int executar_lote(GerenciadorProcessos *gp, MemoriaFisica *mf, FILE *entrada,
+                  size_t tamanho_max_processo, ResultadoLote *resultado) {
+    memset(resultado, 0, sizeof(ResultadoLote));
+
+    char linha[TAMANHO_LINHA_LOTE];
+    long long inicio_lote = agora_ns();
+    long long tempo_operacoes_ns = 0;
+
+    while (fgets(linha, sizeof(linha), entrada)) {
+        char comando[32];
+        long long a = 0, b = 0, c = 0;
+        int num_campos = sscanf(linha, "%31s %lld %lld %lld", comando, &a, &b, &c);
+        if (num_campos < 1 || comando[0] == '#') {
+            continue;
+        }
+
+        // Identifica a operação e confere os argumentos antes de medir
+        int tipo = -1;
+        for (int t = 0; t < NUM_TIPOS_OPERACAO; t++) {
+            if (strcmp(comando, nomes_operacoes[t]) == 0) {
+                tipo = t;
+                break;
+            }
+        }
+        if (tipo == -1) {
+            if (!aplicar_configuracao(gp, mf, comando, num_campos, a, b, c)) {
+                resultado->linhas_invalidas++;
+            }
+            continue;
+        }
+        if (num_campos < campos_operacoes[tipo] || a < 0 || (tipo != OP_REMOVER && b < 0)) {
+            resultado->linhas_invalidas++;
+            continue;
+        }
+
+        limpar_erro();
+        long long inicio = agora_ns();
+        int sucesso = executar_operacao(gp, mf, (TipoOperacao)tipo, (int)a, (uint64_t)b, (unsigned char)c,
+                                        tamanho_max_processo);
+        long long latencia = agora_ns() - inicio;
+
+        tempo_operacoes_ns += latencia;
+        resultado->operacoes[tipo]++;
+        if (!sucesso) {
+            resultado->falhas[tipo]++;
+            resultado->erros[obter_ultimo_erro()]++;
+        }
+        if (!registrar_latencia(resultado, latencia)) {
+            RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o registro de latencias do lote.\n");
+            return 0;
+        }
+        // Os passos da compactação e da deduplicação ficam entre as operações, fora das latências
+        if (gp->compactacao) {
+            compactacao_registrar_operacao(gp->compactacao, gp, mf);
+        }
+        if (gp->deduplicacao) {
+            deduplicacao_registrar_operacao(gp->deduplicacao, gp, mf);
+        }
+    }
+
+    resultado->tempo_operacoes_s = tempo_operacoes_ns / 1e9;
+    resultado->tempo_total_s = (agora_ns() - inicio_lote) / 1e9;
+    return 1;
+}
+
+static int comparar_latencias(const void *a, const void *b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil pelo método do posto mais próximo, sobre latências já ordenadas
+static long long percentil(const long long *ordenadas, long long n, double p) {
+    if (n == 0) {
+        return 0;
+    }
+    long long posto = (long long)(p * n + 0.999999);
+    if (posto < 1) {
+        posto = 1;
+    }
+    return ordenadas[(posto > n ? n : posto) - 1];
+}
+
+// Imprime as faixas não vazias de um histograma do swap, indexadas pelo limite superior de cada faixa
+static void imprimir_histograma_json(const char *nome, const long long *histograma, int ultimo) {
+    printf("    \"%s\": {", nome);
+    int primeiro = 1;
+    for (int k = 0; k < SWAP_FAIXAS_HISTOGRAMA; k++) {
+        if (histograma[k] > 0) {
+            printf("%s\"%lld\": %lld", primeiro ? "" : ", ", swap_limite_faixa(k), histograma[k]);
+            primeiro = 0;
+        }
+    }
+    printf("}%s\n", ultimo ? "}," : ",");
+}
+
+// Resumo do cache comprimido, com a capacidade efetiva no fim do lote
+static void imprimir_cache_comprimido_json(CacheComprimido *c, MemoriaFisica *mf) {
+    EstatisticasCacheComprimido *e = &c->estatisticas;
+    printf("  \"cache_comprimido\": {\"quadros_reservados\": %d, \"quadros_em_uso\": %d, \"slabs_em_uso\": %d, "
+           "\"paginas_guardadas_agora\": %d, "
+           "\"bytes_em_uso\": %lld, \"capacidade_efetiva\": %lld, \"paginas_guardadas\": %lld, "
+           "\"recusadas_incompressiveis\": %lld, \"recusadas_cheio\": %lld, \"paginas_descomprimidas\": %lld, "
+           "\"taxa_compressao\": %.3f, \"tempo_compressao_ns\": %lld, \"tempo_descompressao_ns\": %lld,\n",
+           c->num_quadros, c->num_quadros - c->num_quadros_livres, c->slabs_em_uso, c->objetos_em_uso, c->bytes_em_uso, cache_comprimido_capacidade_efetiva(c, mf),
+           e->paginas_guardadas, e->recusadas_incompressiveis, e->recusadas_cheio, e->paginas_carregadas,
+           e->bytes_comprimidos > 0 ? (double)e->bytes_originais / e->bytes_comprimidos : 0.0,
+           e->tempo_compressao_ns, e->tempo_descompressao_ns);
+    imprimir_histograma_json("latencia_compressao_ns", e->latencia_compressao_ns, 0);
+    imprimir_histograma_json("latencia_descompressao_ns", e->latencia_descompressao_ns, 1);
+}
+
+// Resumo do conjunto de trabalho, com os processos que estiveram em thrashing em alguma amostra
+static void imprimir_conjunto_trabalho_json(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    RastreadorTrabalho *r = gp->conjunto_trabalho;
+    int em_thrashing = 0;
+    long long quadros_sugeridos = 0;
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo->ativo && processo->trabalho) {
+            em_thrashing += processo->trabalho->em_thrashing;
+            quadros_sugeridos += processo->trabalho->maior_conjunto;
+        }
+    }
+    printf("  \"conjunto_trabalho\": {\"amostras\": %d, \"intervalo\": %d, \"janela\": %d, \"pff\": %d, "
+           "\"despejos_locais\": %lld, \"tempo_amostragem_ns\": %lld, \"processos_em_thrashing\": %d, "
+           "\"quadros_sugeridos\": %lld, \"quadros\": %d,\n",
+           r->amostras, r->intervalo, r->janela, r->pff_ativo, r->despejos_locais, r->tempo_amostragem_ns,
+           em_thrashing, quadros_sugeridos, mf->numero_quadros);
+    printf("    \"thrashing\": [");
+    int primeiro = 1;
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        EstadoTrabalho *estado = processo->trabalho;
+        if (!processo->ativo || !estado || estado->amostras_thrashing == 0) {
+            continue;
+        }
+        printf("%s\n      {\"pid\": %d, \"taxa_faltas\": %.6f, \"residentes\": %d, \"conjunto\": %d, "
+               "\"sugerido\": %d, \"amostras_thrashing\": %d, \"amostras\": %d}", primeiro ? "" : ",",
+               processo->id, estado->taxa_faltas, processo->paginas_presentes, estado->conjunto,
+               estado->maior_conjunto, estado->amostras_thrashing, estado->amostras);
+        primeiro = 0;
+    }
+    printf("%s]},\n", primeiro ? "" : "\n    ");
+}
+
+// Resumo da compactação, com a maior sequência de quadros livres no fim do lote
+static void imprimir_compactacao_json(Compactador *c, MemoriaFisica *mf) {
+    int maior_bloco, num_blocos;
+    calcular_fragmentacao(mf, &maior_bloco, &num_blocos);
+    printf("  \"compactacao\": {\"maior_bloco_livre\": %d, \"blocos_livres\": %d, \"passos\": %lld, "
+           "\"passagens\": %lld, \"quadros_migrados\": %lld, \"bytes_copiados\": %lld, "
+           "\"quadros_inspecionados\": %lld, \"imoveis\": %lld, \"tempo_ns\": %lld, \"tempo_max_passo_ns\": %lld},\n",
+           maior_bloco, num_blocos, c->passos, c->passagens, c->quadros_migrados, c->bytes_copiados,
+           c->quadros_inspecionados, c->imoveis, c->tempo_ns, c->tempo_max_passo_ns);
+}
+
+// Resumo da deduplicação, com os quadros economizados no fim do lote
+static void imprimir_deduplicacao_json(Deduplicador *d, MemoriaFisica *mf) {
+    printf("  \"deduplicacao\": {\"quadros_economizados\": %lld, \"quadros_mesclados\": %lld, \"passos\": %lld, "
+           "\"varreduras\": %lld, \"quadros_examinados\": %lld, \"bytes_hash\": %lld, \"comparacoes\": %lld, "
+           "\"comparacoes_diferentes\": %lld, \"tempo_hash_ns\": %lld, \"tempo_ns\": %lld, \"tempo_max_passo_ns\": %lld}\n",
+           quadros_economizados(mf), d->quadros_mesclados, d->passos, d->varreduras, d->quadros_examinados,
+           d->bytes_hash, d->comparacoes, d->comparacoes_diferentes, d->tempo_hash_ns, d->tempo_ns,
+           d->tempo_max_passo_ns);
+}
+
+void exibir_resumo_lote(GerenciadorProcessos *gp, MemoriaFisica *mf, ResultadoLote *resultado) {
+    long long total = 0, falhas = 0, soma_ns = 0;
+    for (int t = 0; t < NUM_TIPOS_OPERACAO; t++) {
+        total += resultado->operacoes[t];
+        falhas += resultado->falhas[t];
+    }
+    for (long long i = 0; i < resultado->num_latencias; i++) {
+        soma_ns += resultado->latencias_ns[i];
+    }
+    qsort(resultado->latencias_ns, resultado->num_latencias, sizeof(long long), comparar_latencias);
+    const long long *ordenadas = resultado->latencias_ns;
+    long long n = resultado->num_latencias;
+
+    size_t bytes_tabelas = gp->tabela_invertida ? bytes_tabela_invertida(gp->tabela_invertida) : 0;
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo->ativo) {
+            bytes_tabelas += bytes_tabela_paginas(&processo->tabela_paginas);
+        }
+    }
+
+    printf("{\n");
+    printf("  \"operacoes\": %lld,\n", total);
+    printf("  \"falhas\": %lld,\n", falhas);
+    printf("  \"linhas_invalidas\": %lld,\n", resultado->linhas_invalidas);
+    printf("  \"tempo_total_s\": %.6f,\n", resultado->tempo_total_s);
+    printf("  \"tempo_operacoes_s\": %.6f,\n", resultado->tempo_operacoes_s);
+    printf("  \"ops_por_segundo\": %.1f,\n", resultado->tempo_total_s > 0 ? total / resultado->tempo_total_s : 0.0);
+    printf("  \"ops_por_segundo_operacoes\": %.1f,\n",
+           resultado->tempo_operacoes_s > 0 ? total / resultado->tempo_operacoes_s : 0.0);
+    printf("  \"latencia_ns\": {\"media\": %.1f, \"p50\": %lld, \"p90\": %lld, \"p99\": %lld, \"p999\": %lld, \"max\": %lld},\n",
+           n > 0 ? (double)soma_ns / n : 0.0, percentil(ordenadas, n, 0.50), percentil(ordenadas, n, 0.90),
+           percentil(ordenadas, n, 0.99), percentil(ordenadas, n, 0.999), n > 0 ? ordenadas[n - 1] : 0);
+    printf("  \"por_tipo\": {");
+    for (int t = 0; t < NUM_TIPOS_OPERACAO; t++) {
+        printf("%s\"%s\": {\"operacoes\": %lld, \"falhas\": %lld}", t ? ", " : "",
+               nomes_operacoes[t], resultado->operacoes[t], resultado->falhas[t]);
+    }
+    printf("},\n");
+    printf("  \"erros\": {");
+    int primeiro = 1;
+    for (int codigo = ERRO_NENHUM; codigo < NUM_CODIGOS_ERRO; codigo++) {
+        if (resultado->erros[codigo] > 0) {
+            printf("%s\"%s\": %lld", primeiro ? "" : ", ", nome_erro((CodigoErro)codigo), resultado->erros[codigo]);
+            primeiro = 0;
+        }
+    }
+    printf("},\n");
+    printf("  \"memoria\": {\"quadros\": %d, \"quadros_livres\": %d, \"tamanho_pagina\": %d, "
+           "\"processos_ativos\": %d, \"bytes_tabelas_paginas\": %zu, \"alocacoes\": %lld, "
+           "\"quadros_compartilhados\": %d, \"falhas_alocacao\": %lld, \"latencia_media_alocacao_ns\": %.1f},\n",
+           mf->numero_quadros, mf->quadros_livres, mf->tamanho_pagina, gp->num_processos, bytes_tabelas,
+           mf->estatisticas.alocacoes, mf->quadros_compartilhados, mf->estatisticas.falhas,
+           mf->estatisticas.alocacoes + mf->estatisticas.falhas > 0
+               ? (double)mf->estatisticas.tempo_total_ns / (mf->estatisticas.alocacoes + mf->estatisticas.falhas) : 0.0);
+    printf("  \"paginacao\": {\"faltas_pagina\": %lld, \"despejos\": %lld, \"writebacks\": %lld, "
+           "\"forks\": %lld, \"copias_na_escrita\": %lld},\n",
+           gp->total_faltas_pagina, gp->substituicao ? gp->substituicao->despejos : 0LL,
+           gp->substituicao ? gp->substituicao->writebacks : 0LL, gp->total_forks, gp->total_copias_na_escrita);
+    if (gp->tlb) {
+        printf("  \"tlb\": {\"acertos\": %lld, \"faltas\": %lld},\n", gp->tlb->acertos, gp->tlb->faltas);
+    } else {
+        printf("  \"tlb\": null,\n");
+    }
+    if (gp->swap) {
+        EstatisticasSwap e;
+        swap_obter_estatisticas(gp->swap, &e);
+        printf("  \"swap\": {\"paginas_gravadas\": %lld, \"paginas_lidas\": %lld, \"acertos_fila\": %lld, "
+               "\"escritas\": %lld, \"esperas_fila_cheia\": %lld, \"profundidade_maxima\": %d, \"slots_em_uso\": %d,\n",
+               e.paginas_gravadas, e.paginas_lidas, e.acertos_fila, e.escritas, e.esperas_fila_cheia,
+               e.profundidade_maxima, gp->swap->slots_em_uso);
+        imprimir_histograma_json("profundidade_fila", e.profundidade, 0);
+        imprimir_histograma_json("latencia_swap_in_ns", e.latencia_swap_in_ns, 0);
+        imprimir_histograma_json("latencia_outras_faltas_ns", e.latencia_outras_ns, 1);
+    } else {
+        printf("  \"swap\": null,\n");
+    }
+    if (gp->cache_comprimido) {
+        imprimir_cache_comprimido_json(gp->cache_comprimido, mf);
+    } else {
+        printf("  \"cache_comprimido\": null,\n");
+    }
+    if (gp->conjunto_trabalho) {
+        imprimir_conjunto_trabalho_json(gp, mf);
+    } else {
+        printf("  \"conjunto_trabalho\": null,\n");
+    }
+    if (gp->compactacao) {
+        imprimir_compactacao_json(gp->compactacao, mf);
+    } else {
+        printf("  \"compactacao\": null,\n");
+    }
+    if (gp->deduplicacao) {
+        imprimir_deduplicacao_json(gp->deduplicacao, mf);
+    } else {
+        printf("  \"deduplicacao\": null\n");
+    }
+    printf("}\n");
+}
+
+void liberar_resultado_lote(ResultadoLote *resultado) {
+    free(resultado->latencias_ns);
+    resultado->latencias_ns = NULL;
+    resultado->num_latencias = 0;
+    resultado->capacidade_latencias = 0;
+}
@@ -0,0 +1,113 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "memoria.h"
+#include "processo.h"
+
+// Execução não interativa de um rastro (arquivo ou entrada padrão), uma operação por linha:
+//
+//   criar <pid> <bytes>                      Cria um processo
+//   remover <pid>                            Remove um processo
+//   ler <pid> <endereco>                     Lê um byte do endereço lógico
+//   escrever <pid> <endereco> <valor>        Escreve um byte no endereço lógico
+//   traduzir <pid> <endereco>                Traduz o endereço lógico para o físico
+//   fork <pid> <novo_pid>                    Duplica o processo com cópia na escrita
+//
+// Linhas de configuração, que não entram nas medições:
+//
+//   demanda <0|1>                            Paginação sob demanda
+//   sem_copia <0|1>                          Imagens sem cópia
+//   alocacao <politica>                      Política de alocação de quadros (0 ou 1)
+//   substituicao <politica>                  Política de substituição de páginas (0 a 4)
+//   tlb <entradas> <associatividade> <limpar> TLB (0 entradas para desativar)
+//   tabela <tipo>                            Representação da tabela de páginas (0 a 2)
+//   trabalho <intervalo> [janela]            Conjunto de trabalho (intervalo 0 para desativar)
+//   pff <0|1> [inferior] [superior]          Controle PFF, limites em faltas por mil acessos
+//   compactacao <quadros> [operacoes]        Compactação: quadros por passo (0 para desativar) e operações entre passos
+//   compactar                                Passagem completa da compactação
+//   deduplicacao <quadros> [operacoes]       Deduplicação: quadros por passo (0 para desativar) e operações entre passos
+//   deduplicar                               Varredura completa da deduplicação
+//   imagem_comum <percentual>                Início das imagens de novos processos igual em todos
+//   entropia <percentual>                    Palavras aleatórias nas imagens de novos processos (as demais são zero)
+//   cache_comprimido <quadros> [limite]      Cache comprimido: quadros reservados (0 para desativar) e maior objeto em % da página
+//
+// Linhas vazias e iniciadas por '#' são ignoradas.
+
+// Tipos de operação medidos
+typedef enum {
+    OP_CRIAR = 0,
+    OP_REMOVER = 1,
+    OP_LER = 2,
+    OP_ESCREVER = 3,
+    OP_TRADUZIR = 4,
+    OP_FORK = 5,
+    NUM_TIPOS_OPERACAO = 6
+} TipoOperacao;
+
+// Medições de uma execução em lote
+typedef struct {
+    long long operacoes[NUM_TIPOS_OPERACAO]; // Operações executadas, por tipo
+    long long falhas[NUM_TIPOS_OPERACAO];    // Operações que falharam, por tipo
+    long long erros[NUM_CODIGOS_ERRO];       // Operações que falharam, por código de erro
+    long long linhas_invalidas;       // Linhas que não puderam ser interpretadas
+    long long *latencias_ns;          // Latência de cada operação, na ordem do rastro
+    long long num_latencias;          // Número de latências registradas
+    long long capacidade_latencias;   // Capacidade do vetor de latências
+    double tempo_operacoes_s;         // Tempo gasto dentro das operações
+    double tempo_total_s;             // Tempo de parede do lote, incluindo a leitura do rastro
+} ResultadoLote;
+
+/**
+ * @brief Executa uma única operação sobre o simulador.
+ *
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param tipo Tipo da operação.
+ * @param pid ID do processo.
+ * @param argumento Tamanho em bytes (OP_CRIAR), endereço lógico (OP_LER, OP_ESCREVER, OP_TRADUZIR) ou ID do novo processo (OP_FORK).
+ * @param valor Byte escrito (OP_ESCREVER).
+ * @param tamanho_max_processo Tamanho máximo de um processo em bytes.
+ * @return 1 se a operação teve sucesso, 0 caso contrário.
+ */
+int executar_operacao(GerenciadorProcessos *gp, MemoriaFisica *mf, TipoOperacao tipo, int pid,
+                      uint64_t argumento, unsigned char valor, size_t tamanho_max_processo);
+
+/**
+ * @brief Retorna o nome de um tipo de operação, como escrito no rastro.
+ *
+ * @param tipo O tipo da operação.
+ * @return Nome da operação.
+ */
+const char* nome_tipo_operacao(TipoOperacao tipo);
+
+/**
+ * @brief Executa as operações de um rastro até o fim da entrada.
+ *
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param entrada Arquivo do rastro (pode ser stdin).
+ * @param tamanho_max_processo Tamanho máximo de um processo em bytes.
+ * @param resultado Estrutura que recebe as medições (liberar com liberar_resultado_lote).
+ * @return 1 se o rastro foi lido até o fim, 0 se faltou memória para as medições.
+ */
+int executar_lote(GerenciadorProcessos *gp, MemoriaFisica *mf, FILE *entrada,
+                  size_t tamanho_max_processo, ResultadoLote *resultado);
+
+/**
+ * @brief Exibe o resumo da execução em JSON: vazão, percentis de latência, falhas
+ * por código de erro e estado da memória.
+ *
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param resultado Medições da execução.
+ */
+void exibir_resumo_lote(GerenciadorProcessos *gp, MemoriaFisica *mf, ResultadoLote *resultado);
+
+/**
+ * @brief Libera as medições de uma execução em lote.
+ *
+ * @param resultado Ponteiro para as medições.
+ */
+void liberar_resultado_lote(ResultadoLote *resultado);
+
+#endif // LOTE_H
@@ -1,11 +1,42 @@
 #include "memoria.h"
 #include "processo.h"
+#include "substituicao.h"
+#include "lote.h"
+#include "conjunto_trabalho.h"
+#include "compactacao.h"
+#include "deduplicacao.h"
+#include "cache_comprimido.h"
+#include <string.h>
 
 void exibir_menu() {
     printf("\n=== MENU PRINCIPAL ===\n");
     printf("1. Visualizar memoria\n");
     printf("2. Criar processo\n");
     printf("3. Visualizar tabela de paginas\n");
+    printf("4. Remover processo\n");
+    printf("5. Estatisticas de alocacao\n");
+    printf("6. Alterar politica de alocacao\n");
+    printf("7. Acessar endereco logico\n");
+    printf("8. Alternar paginacao sob demanda\n");
+    printf("9. Alterar politica de substituicao\n");
+    printf("10. Estatisticas de substituicao\n");
+    printf("11. Escrever em endereco logico\n");
+    printf("12. Configurar TLB\n");
+    printf("13. Estatisticas da TLB\n");
+    printf("14. Alterar tipo de tabela de paginas\n");
+    printf("15. Uso das tabelas de paginas\n");
+    printf("16. Alternar imagens sem copia\n");
+    printf("17. Fork de processo\n");
+    printf("18. Configurar swap\n");
+    printf("19. Estatisticas do swap\n");
+    printf("20. Configurar conjunto de trabalho e PFF\n");
+    printf("21. Relatorio do conjunto de trabalho\n");
+    printf("22. Configurar compactacao\n");
+    printf("23. Compactar memoria\n");
+    printf("24. Configurar deduplicacao\n");
+    printf("25. Deduplicar memoria\n");
+    printf("26. Configurar cache comprimido\n");
+    printf("27. Estatisticas do cache comprimido\n");
     printf("0. Sair\n");
     printf("Escolha uma opcao: ");
 }
@@ -17,19 +48,14 @@ void visualizar_memoria_completa(MemoriaFisica *mf) {
     }
     
     // Calcula o percentual de memória livre
-    int quadros_livres = 0;
-    for (int i = 0; i < mf->numero_quadros; i++) {
-        if (mf->quadro_livre[i]) {
-            quadros_livres++;
-        }
-    }
+    int quadros_livres = mf->quadros_livres;
     
     float percentual_livre = (float)quadros_livres / mf->numero_quadros * 100;
     
     printf("\n=== VISUALIZACAO DA MEMORIA FISICA ===\n");
     printf("Percentual de memoria livre: %.2f%%\n", percentual_livre);
     printf("Quadros livres: %d / %d\n", quadros_livres, mf->numero_quadros);
-    printf("Tamanho total: %d MB (%d bytes)\n", mf->tamanho_memoria / (1024 * 1024), mf->tamanho_memoria);
+    printf("Tamanho total: %zu MB (%zu bytes)\n", mf->tamanho_memoria / (1024 * 1024), mf->tamanho_memoria);
     printf("Tamanho da pagina: %d KB (%d bytes)\n", mf->tamanho_pagina / 1024, mf->tamanho_pagina);
     printf("\nEstado dos quadros (0=Livre, 1=Ocupado):\n");
     
@@ -44,7 +70,7 @@ void visualizar_memoria_completa(MemoriaFisica *mf) {
             int quadro_index = linha * quadros_por_linha + col;
             
             if (quadro_index < mf->numero_quadros) {
-                printf("%d", mf->quadro_livre[quadro_index] ? 0 : 1);
+                printf("%d", quadro_esta_livre(mf, quadro_index) ? 0 : 1);
             } else {
                 printf(" ");
             }
@@ -59,8 +85,9 @@ void visualizar_memoria_completa(MemoriaFisica *mf) {
     printf("==========================================\n\n");
 }
 
-void criar_processo_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf, int tamanho_max_processo) {
-    int id_processo, tamanho_processo;
+void criar_processo_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf, long long tamanho_max_processo) {
+    int id_processo;
+    long long tamanho_processo;
     
     printf("\n=== CRIAR PROCESSO ===\n");
     
@@ -71,11 +98,11 @@ void criar_processo_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf, int
     // Solicita tamanho do processo
     do {
         printf("Digite o tamanho do processo em bytes: ");
-        scanf("%d", &tamanho_processo);
+        scanf("%lld", &tamanho_processo);
         
         if (tamanho_processo > tamanho_max_processo) {
-            printf("Erro: Tamanho maior que o maximo permitido (%d bytes).\n", tamanho_max_processo);
-            printf("Digite um valor menor ou igual a %d bytes.\n", tamanho_max_processo);
+            printf("Erro: Tamanho maior que o maximo permitido (%lld bytes).\n", tamanho_max_processo);
+            printf("Digite um valor menor ou igual a %lld bytes.\n", tamanho_max_processo);
         }
     } while (tamanho_processo > tamanho_max_processo);
     
@@ -85,10 +112,10 @@ void criar_processo_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf, int
     }
     
     // Cria o processo
-    int resultado = criar_processo(gp, mf, id_processo, tamanho_processo, mf->tamanho_pagina, tamanho_max_processo);
+    int resultado = criar_processo(gp, mf, id_processo, (size_t)tamanho_processo, mf->tamanho_pagina, (size_t)tamanho_max_processo);
     
     if (resultado == -1) {
-        printf("Erro: Nao foi possivel criar o processo. Memoria insuficiente ou erro interno.\n");
+        printf("Erro: Nao foi possivel criar o processo (%s).\n", descricao_erro(obter_ultimo_erro()));
     } else {
         printf("Processo %d criado com sucesso!\n", id_processo);
     }
@@ -110,19 +137,370 @@ void visualizar_tabela_paginas_interativo(GerenciadorProcessos *gp) {
     visualizar_tabela_paginas(gp, id_processo);
 }
 
-int main() {
-    int tamanho_mb, tamanho_pagina_kb;
-    int tamanho_max_processo;
+void remover_processo_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int id_processo;
+    
+    printf("\n=== REMOVER PROCESSO ===\n");
+    printf("Digite o ID do processo: ");
+    scanf("%d", &id_processo);
+    
+    remover_processo(gp, mf, id_processo);
+}
+
+void fork_processo_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int id_processo, id_filho;
+    
+    printf("\n=== FORK DE PROCESSO ===\n");
+    printf("Digite o ID do processo original: ");
+    scanf("%d", &id_processo);
+    printf("Digite o ID do novo processo: ");
+    scanf("%d", &id_filho);
+    
+    fork_processo(gp, mf, id_processo, id_filho);
+}
+
+void alterar_politica_alocacao_interativo(MemoriaFisica *mf) {
+    int politica;
+    
+    printf("\n=== POLITICA DE ALOCACAO ===\n");
+    printf("Politica atual: %s\n", nome_politica_alocacao(mf->politica));
+    printf("0. Primeiro livre\n");
+    printf("1. Buddy\n");
+    printf("Escolha a politica: ");
+    scanf("%d", &politica);
+    
+    definir_politica_alocacao(mf, (PoliticaAlocacao)politica);
+}
+
+void acessar_endereco_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int id_processo;
+    long long endereco_logico;
+    
+    printf("\n=== ACESSAR ENDERECO LOGICO ===\n");
+    printf("Digite o ID do processo: ");
+    scanf("%d", &id_processo);
+    printf("Digite o endereco logico: ");
+    scanf("%lld", &endereco_logico);
+    
+    int64_t endereco_fisico = endereco_logico < 0 ? -1 : traduzir_endereco(gp, mf, id_processo, (uint64_t)endereco_logico);
+    if (endereco_fisico == -1) {
+        printf("Erro: Nao foi possivel traduzir o endereco %lld do processo %d (%s).\n", endereco_logico, id_processo,
+               descricao_erro(endereco_logico < 0 ? ERRO_ENDERECO_INVALIDO : obter_ultimo_erro()));
+        return;
+    }
+    
+    printf("Endereco logico %lld -> endereco fisico %lld (quadro %lld, deslocamento %lld)\n",
+           endereco_logico, (long long)endereco_fisico,
+           (long long)(endereco_fisico / mf->tamanho_pagina), (long long)(endereco_fisico % mf->tamanho_pagina));
+    printf("Valor: %u\n", ler_da_memoria(mf, (size_t)endereco_fisico));
+}
+
+void escrever_endereco_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int id_processo, valor;
+    long long endereco_logico;
+    
+    printf("\n=== ESCREVER EM ENDERECO LOGICO ===\n");
+    printf("Digite o ID do processo: ");
+    scanf("%d", &id_processo);
+    printf("Digite o endereco logico: ");
+    scanf("%lld", &endereco_logico);
+    printf("Digite o valor (0 a 255): ");
+    scanf("%d", &valor);
+    
+    if (valor < 0 || valor > 255) {
+        printf("Erro: Valor deve estar entre 0 e 255.\n");
+        return;
+    }
+    
+    if (endereco_logico >= 0 && escrever_logico(gp, mf, id_processo, (uint64_t)endereco_logico, (unsigned char)valor)) {
+        printf("Valor %d escrito no endereco logico %lld do processo %d.\n", valor, endereco_logico, id_processo);
+    } else {
+        printf("Erro: Nao foi possivel escrever no endereco %lld do processo %d (%s).\n", endereco_logico, id_processo,
+               descricao_erro(endereco_logico < 0 ? ERRO_ENDERECO_INVALIDO : obter_ultimo_erro()));
+    }
+}
+
+void configurar_tlb_interativo(GerenciadorProcessos *gp) {
+    int num_entradas, associatividade = 1, limpar_na_troca = 0;
+    
+    printf("\n=== CONFIGURAR TLB ===\n");
+    printf("Digite o numero de entradas (0 desativa a TLB): ");
+    scanf("%d", &num_entradas);
+    if (num_entradas > 0) {
+        printf("Digite a associatividade (vias por conjunto): ");
+        scanf("%d", &associatividade);
+        printf("Esvaziar a TLB na troca de contexto? (1 = sim, 0 = usar ASID): ");
+        scanf("%d", &limpar_na_troca);
+    }
     
-    printf("=== Simulador de Gerenciamento de Memoria ===\n");
-    printf("Digite o tamanho da memoria fisica em MB: ");
+    configurar_tlb(gp, num_entradas, associatividade, limpar_na_troca);
+}
+
+void configurar_swap_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int tamanho_mb, latencia_us = 0, banda_mb = 0;
+    char arquivo[256] = "-";
+    
+    printf("\n=== CONFIGURAR SWAP ===\n");
+    printf("Digite o tamanho do swap em MB (0 desativa o swap): ");
     scanf("%d", &tamanho_mb);
+    if (tamanho_mb > 0) {
+        printf("Digite o arquivo de apoio (- para usar a memoria): ");
+        scanf("%255s", arquivo);
+        printf("Digite a latencia de cada operacao em microssegundos: ");
+        scanf("%d", &latencia_us);
+        printf("Digite a largura de banda em MB/s (0 = ilimitada): ");
+        scanf("%d", &banda_mb);
+    }
+    
+    configurar_swap(gp, mf, (size_t)(tamanho_mb > 0 ? tamanho_mb : 0) * 1024 * 1024,
+                    strcmp(arquivo, "-") == 0 ? NULL : arquivo,
+                    (long long)latencia_us * 1000, (long long)banda_mb * 1024 * 1024);
+}
+
+void configurar_conjunto_trabalho_interativo(GerenciadorProcessos *gp) {
+    int intervalo, janela = TRABALHO_JANELA_PADRAO, pff = 0;
+    double inferior = TRABALHO_PFF_INFERIOR_PADRAO, superior = TRABALHO_PFF_SUPERIOR_PADRAO;
+    
+    printf("\n=== CONJUNTO DE TRABALHO ===\n");
+    printf("Digite o intervalo entre amostras em acessos (0 desativa): ");
+    scanf("%d", &intervalo);
+    if (intervalo > 0) {
+        printf("Digite a janela em amostras (1 a %d): ", TRABALHO_MAX_JANELA - 1);
+        scanf("%d", &janela);
+        printf("Ativar o controle PFF? (1 = sim, 0 = nao): ");
+        scanf("%d", &pff);
+        if (pff) {
+            printf("Digite os limites inferior e superior em faltas por acesso: ");
+            scanf("%lf %lf", &inferior, &superior);
+        }
+    }
+    
+    if (configurar_conjunto_trabalho(gp, intervalo, janela) && gp->conjunto_trabalho && pff) {
+        configurar_controle_pff(gp->conjunto_trabalho, 1, inferior, superior, TRABALHO_PFF_PASSO_PADRAO);
+    }
+}
+
+void relatorio_conjunto_trabalho_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (!gp->conjunto_trabalho) {
+        printf("Conjunto de trabalho desativado. Use a opcao 20 para configura-lo.\n");
+        return;
+    }
+    exibir_conjunto_trabalho(gp->conjunto_trabalho, gp, mf);
     
-    printf("Digite o tamanho da pagina/quadro em KB: ");
-    scanf("%d", &tamanho_pagina_kb);
+    char arquivo[256];
+    printf("Arquivo CSV para a serie temporal (- para nao gravar): ");
+    scanf("%255s", arquivo);
+    if (strcmp(arquivo, "-") != 0 && exportar_serie_trabalho(gp->conjunto_trabalho, arquivo)) {
+        printf("Serie gravada em %s.\n", arquivo);
+    }
+}
+
+void configurar_compactacao_interativo(GerenciadorProcessos *gp) {
+    int quadros_por_passo, intervalo = 0;
     
-    printf("Digite o tamanho maximo de um processo em bytes: ");
-    scanf("%d", &tamanho_max_processo);
+    printf("\n=== COMPACTACAO ===\n");
+    printf("Digite o maximo de quadros migrados por passo (0 desativa): ");
+    scanf("%d", &quadros_por_passo);
+    if (quadros_por_passo > 0) {
+        printf("Digite o intervalo entre passos em operacoes do modo em lote (0 = so sob pedido): ");
+        scanf("%d", &intervalo);
+    }
+    
+    configurar_compactacao(gp, quadros_por_passo, intervalo);
+}
+
+void compactar_memoria_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (!gp->compactacao) {
+        printf("Compactacao desativada. Use a opcao 22 para configura-la.\n");
+        return;
+    }
+    long long passos = gp->compactacao->passos;
+    long long migrados = compactar_memoria(gp->compactacao, gp, mf, 0);
+    printf("%lld quadros migrados em %lld passos.\n", migrados, gp->compactacao->passos - passos);
+    exibir_estatisticas_compactacao(gp->compactacao, mf);
+}
+
+void configurar_deduplicacao_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int quadros_por_passo, intervalo = 0;
+    
+    printf("\n=== DEDUPLICACAO ===\n");
+    printf("Digite os quadros examinados por passo (0 desativa): ");
+    scanf("%d", &quadros_por_passo);
+    if (quadros_por_passo > 0) {
+        printf("Digite o intervalo entre passos em operacoes do modo em lote (0 = so sob pedido): ");
+        scanf("%d", &intervalo);
+    }
+    
+    configurar_deduplicacao(gp, mf, quadros_por_passo, intervalo);
+}
+
+void deduplicar_memoria_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (!gp->deduplicacao) {
+        printf("Deduplicacao desativada. Use a opcao 24 para configura-la.\n");
+        return;
+    }
+    long long passos = gp->deduplicacao->passos;
+    long long mesclados = deduplicar_memoria(gp->deduplicacao, gp, mf);
+    printf("%lld quadros mesclados em %lld passos.\n", mesclados, gp->deduplicacao->passos - passos);
+    exibir_estatisticas_deduplicacao(gp->deduplicacao, mf);
+}
+
+void configurar_cache_comprimido_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    int quadros, limite = CACHE_COMPRIMIDO_LIMITE_PADRAO;
+    
+    printf("\n=== CACHE COMPRIMIDO ===\n");
+    printf("Digite os quadros reservados para o cache (0 desativa): ");
+    scanf("%d", &quadros);
+    if (quadros > 0) {
+        printf("Digite o maior tamanho comprimido aceito, em %% da pagina: ");
+        scanf("%d", &limite);
+    }
+    
+    configurar_cache_comprimido(gp, mf, quadros, limite);
+}
+
+void alterar_politica_substituicao_interativo(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    Substituidor *s = obter_substituidor(gp, mf);
+    if (!s) {
+        return;
+    }
+    
+    int politica;
+    printf("\n=== POLITICA DE SUBSTITUICAO ===\n");
+    printf("Politica atual: %s\n", nome_politica_substituicao(s->politica));
+    printf("0. Nenhuma (falha sem quadros livres)\n");
+    printf("1. FIFO\n");
+    printf("2. Clock (segunda chance)\n");
+    printf("3. LRU aproximado\n");
+    printf("4. ARC\n");
+    printf("Escolha a politica: ");
+    scanf("%d", &politica);
+    
+    definir_politica_substituicao(s, (PoliticaSubstituicao)politica);
+}
+
+void alterar_tipo_tabela_interativo(GerenciadorProcessos *gp) {
+    int tipo;
+    printf("\n=== TIPO DE TABELA DE PAGINAS ===\n");
+    printf("Tipo atual: %s\n", nome_tipo_tabela_paginas(gp->tipo_tabela));
+    printf("0. Linear\n");
+    printf("1. Dois niveis\n");
+    printf("2. Invertida (hash compartilhada)\n");
+    printf("Escolha o tipo (vale para novos processos): ");
+    scanf("%d", &tipo);
+    
+    definir_tipo_tabela_paginas(gp, (TipoTabelaPaginas)tipo);
+}
+
+// Executa um rastro ("-" para a entrada padrão) e exibe o resumo; com serie_trabalho,
+// grava também a série do conjunto de trabalho. Retorna 1 se sucesso
+int executar_modo_lote(GerenciadorProcessos *gp, MemoriaFisica *mf, const char *rastro, size_t tamanho_max_processo,
+                       const char *serie_trabalho) {
+    FILE *entrada = strcmp(rastro, "-") == 0 ? stdin : fopen(rastro, "r");
+    if (!entrada) {
+        printf("Erro: Nao foi possivel abrir o rastro %s.\n", rastro);
+        return 0;
+    }
+    
+    ResultadoLote resultado;
+    int sucesso = executar_lote(gp, mf, entrada, tamanho_max_processo, &resultado);
+    if (entrada != stdin) {
+        fclose(entrada);
+    }
+    if (sucesso) {
+        exibir_resumo_lote(gp, mf, &resultado);
+    }
+    if (sucesso && serie_trabalho) {
+        if (!gp->conjunto_trabalho) {
+            printf("Erro: O rastro nao ativou o conjunto de trabalho; a serie nao foi gravada.\n");
+            sucesso = 0;
+        } else {
+            sucesso = exportar_serie_trabalho(gp->conjunto_trabalho, serie_trabalho);
+        }
+    }
+    liberar_resultado_lote(&resultado);
+    return sucesso;
+}
+
+int main(int argc, char *argv[]) {
+    int tamanho_mb = 0, tamanho_pagina_kb = 0;
+    long long tamanho_max_processo = 0;
+    
+    // Opções de linha de comando: semente, mapeamento da memória física e modo em lote
+    const char *semente = NULL;
+    const char *arquivo_memoria = NULL;
+    const char *rastro = NULL;
+    const char *serie_trabalho = NULL;
+    int paginas_grandes = 0;
+    int nivel = -1;
+    int threads_carga = 1;
+    int imagem_comum = 0;
+    int entropia = 100;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--arquivo=", 10) == 0) {
+            arquivo_memoria = argv[i] + 10;
+        } else if (strcmp(argv[i], "--paginas-grandes") == 0) {
+            paginas_grandes = 1;
+        } else if (strcmp(argv[i], "--lote") == 0) {
+            rastro = "-";
+        } else if (strncmp(argv[i], "--lote=", 7) == 0) {
+            rastro = argv[i] + 7;
+        } else if (strncmp(argv[i], "--memoria=", 10) == 0) {
+            tamanho_mb = atoi(argv[i] + 10);
+        } else if (strncmp(argv[i], "--pagina=", 9) == 0) {
+            tamanho_pagina_kb = atoi(argv[i] + 9);
+        } else if (strncmp(argv[i], "--max-processo=", 15) == 0) {
+            tamanho_max_processo = atoll(argv[i] + 15);
+        } else if (strcmp(argv[i], "--detalhado") == 0) {
+            nivel = REGISTRO_DEPURACAO;
+        } else if (strncmp(argv[i], "--registro=", 11) == 0) {
+            nivel = atoi(argv[i] + 11);
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            threads_carga = atoi(argv[i] + 10);
+        } else if (strncmp(argv[i], "--serie-trabalho=", 17) == 0) {
+            serie_trabalho = argv[i] + 17;
+        } else if (strncmp(argv[i], "--imagem-comum=", 15) == 0) {
+            imagem_comum = atoi(argv[i] + 15);
+        } else if (strncmp(argv[i], "--entropia=", 11) == 0) {
+            entropia = atoi(argv[i] + 11);
+        } else {
+            semente = argv[i];
+        }
+    }
+    
+    if (rastro) {
+        // Modo em lote: parâmetros omitidos recebem valores padrão e só os erros
+        // são registrados, salvo com --detalhado ou --registro
+        if (tamanho_mb == 0) {
+            tamanho_mb = 64;
+        }
+        if (tamanho_pagina_kb == 0) {
+            tamanho_pagina_kb = 4;
+        }
+        if (tamanho_max_processo == 0) {
+            tamanho_max_processo = (long long)tamanho_mb * 1024 * 1024;
+        }
+        definir_nivel_registro(nivel == -1 ? REGISTRO_ERRO : nivel);
+    } else {
+        if (nivel != -1) {
+            definir_nivel_registro(nivel);
+        }
+        printf("=== Simulador de Gerenciamento de Memoria ===\n");
+        if (tamanho_mb == 0) {
+            printf("Digite o tamanho da memoria fisica em MB: ");
+            scanf("%d", &tamanho_mb);
+        }
+        
+        if (tamanho_pagina_kb == 0) {
+            printf("Digite o tamanho da pagina/quadro em KB: ");
+            scanf("%d", &tamanho_pagina_kb);
+        }
+        
+        if (tamanho_max_processo == 0) {
+            printf("Digite o tamanho maximo de um processo em bytes: ");
+            scanf("%lld", &tamanho_max_processo);
+        }
+    }
     
     // Validação básica dos parâmetros
     if (tamanho_mb <= 0) {
@@ -140,9 +518,9 @@ int main() {
     }
     
     // Cria a memória física com o tamanho especificado
-    MemoriaFisica *mf = criar_memoria_fisica(tamanho_mb, tamanho_pagina_kb);
+    MemoriaFisica *mf = criar_memoria_fisica_mapeada(tamanho_mb, tamanho_pagina_kb, paginas_grandes, arquivo_memoria);
     if (!mf) {
-        printf("Erro: Falha ao criar memoria fisica.\n");
+        printf("Erro: Falha ao criar memoria fisica (%s).\n", descricao_erro(obter_ultimo_erro()));
         return 1;
     }
     
@@ -153,6 +531,34 @@ int main() {
     GerenciadorProcessos gp;
     inicializar_gerenciador_processos(&gp);
     
+    // Semente opcional na linha de comando, para reproduzir as imagens dos processos
+    if (semente) {
+        definir_semente_processos(&gp, strtoull(semente, NULL, 0));
+        REGISTRAR_INFO("Semente dos processos: %s\n", semente);
+    }
+    
+    // Início das imagens igual em todos os processos, que a deduplicação pode mesclar
+    if (imagem_comum && !definir_imagem_comum(&gp, imagem_comum)) {
+        printf("Aviso: Imagens dos processos serao geradas sem parte comum.\n");
+    }
+    
+    // Palavras zeradas nas imagens, para que o cache comprimido encontre o que comprimir
+    if (entropia != 100 && !definir_entropia_imagens(&gp, entropia)) {
+        printf("Aviso: Imagens dos processos serao totalmente aleatorias.\n");
+    }
+    
+    // Threads que geram e copiam as imagens dos processos grandes
+    if (threads_carga > 1 && !definir_threads_carga(&gp, threads_carga)) {
+        printf("Aviso: Imagens dos processos serao carregadas com uma thread.\n");
+    }
+    
+    if (rastro) {
+        int sucesso = executar_modo_lote(&gp, mf, rastro, (size_t)tamanho_max_processo, serie_trabalho);
+        finalizar_gerenciador_processos(&gp, mf);
+        destruir_memoria_fisica(mf);
+        return sucesso ? 0 : 1;
+    }
+    
     // Menu interativo
     int opcao;
     do {
@@ -172,6 +578,116 @@ int main() {
                 visualizar_tabela_paginas_interativo(&gp);
                 break;
                 
+            case 4:
+                remover_processo_interativo(&gp, mf);
+                break;
+                
+            case 5:
+                exibir_estatisticas_alocacao(mf);
+                break;
+                
+            case 6:
+                alterar_politica_alocacao_interativo(mf);
+                break;
+                
+            case 7:
+                acessar_endereco_interativo(&gp, mf);
+                break;
+                
+            case 8:
+                definir_paginacao_sob_demanda(&gp, !gp.paginacao_sob_demanda);
+                break;
+                
+            case 9:
+                alterar_politica_substituicao_interativo(&gp, mf);
+                break;
+                
+            case 10:
+                if (obter_substituidor(&gp, mf)) {
+                    exibir_estatisticas_substituicao(gp.substituicao);
+                }
+                break;
+                
+            case 11:
+                escrever_endereco_interativo(&gp, mf);
+                break;
+                
+            case 12:
+                configurar_tlb_interativo(&gp);
+                break;
+                
+            case 13:
+                if (gp.tlb) {
+                    exibir_estatisticas_tlb(gp.tlb);
+                } else {
+                    printf("TLB desativada. Use a opcao 12 para configura-la.\n");
+                }
+                break;
+                
+            case 14:
+                alterar_tipo_tabela_interativo(&gp);
+                break;
+                
+            case 15:
+                exibir_uso_tabelas_paginas(&gp);
+                break;
+                
+            case 16:
+                definir_imagens_sem_copia(&gp, !gp.imagens_sem_copia);
+                break;
+                
+            case 17:
+                fork_processo_interativo(&gp, mf);
+                break;
+                
+            case 18:
+                configurar_swap_interativo(&gp, mf);
+                break;
+                
+            case 19:
+                if (gp.swap) {
+                    exibir_estatisticas_swap(gp.swap);
+                } else {
+                    printf("Swap desativado. Use a opcao 18 para configura-lo.\n");
+                }
+                break;
+                
+            case 20:
+                configurar_conjunto_trabalho_interativo(&gp);
+                break;
+                
+            case 21:
+                relatorio_conjunto_trabalho_interativo(&gp, mf);
+                break;
+                
+            case 22:
+                configurar_compactacao_interativo(&gp);
+                break;
+                
+            case 23:
+                compactar_memoria_interativo(&gp, mf);
+                break;
+                
+            case 24:
+                configurar_deduplicacao_interativo(&gp, mf);
+                break;
+                
+            case 25:
+                deduplicar_memoria_interativo(&gp, mf);
+                break;
+                
+            case 26:
+                configurar_cache_comprimido_interativo(&gp, mf);
+                break;
+                
+            case 27:
+                if (gp.cache_comprimido) {
+                    exibir_estatisticas_cache_comprimido(gp.cache_comprimido, mf);
+                } else {
+                    printf("Cache comprimido desativado. Use a opcao 26 para configura-lo.\n");
+                }
+                break;
+                
             case 0:
                 printf("Saindo do programa...\n");
                 break;
@@ -183,7 +699,8 @@ int main() {
         
     } while (opcao != 0);
     
-    // Libera a memória
+    // Libera os processos e a memória
+    finalizar_gerenciador_processos(&gp, mf);
     destruir_memoria_fisica(mf);
     
     return 0;
@@ -1,44 +1,128 @@
 #include "memoria.h"
-#include <string.h> // Para memset
+#include "tabela_paginas.h"
+#include <string.h>   // Para memset e memcpy
+#include <sys/mman.h> // Para mmap e madvise
+#include <fcntl.h>    // Para open
+#include <unistd.h>   // Para ftruncate e close
+#include <limits.h>   // Para INT_MAX
+
+static void buddy_reconstruir(MemoriaFisica *mf);
+
+// CPU simulada pela thread corrente no modo concorrente (-1 se nenhuma)
+static _Thread_local int cpu_atual = -1;
 
 MemoriaFisica* criar_memoria_fisica(int tamanho_mb, int tamanho_pagina_kb) {
+    return criar_memoria_fisica_mapeada(tamanho_mb, tamanho_pagina_kb, 0, NULL);
+}
+
+// Mapeia a área da memória física: anônima e sem reserva de swap, ou
+// compartilhada com um arquivo. Retorna NULL (MAP_FAILED convertido) se falhar.
+static unsigned char* mapear_memoria(size_t tamanho_bytes, int paginas_grandes, const char *arquivo) {
+    void *area;
+    if (arquivo) {
+        int fd = open(arquivo, O_RDWR | O_CREAT, 0644);
+        if (fd == -1) {
+            RELATAR_ERRO(ERRO_ARQUIVO, "Falha ao abrir o arquivo de memoria %s.\n", arquivo);
+            return NULL;
+        }
+        if (ftruncate(fd, (off_t)tamanho_bytes) == -1) {
+            RELATAR_ERRO(ERRO_ARQUIVO, "Falha ao ajustar o tamanho do arquivo de memoria %s.\n", arquivo);
+            close(fd);
+            return NULL;
+        }
+        area = mmap(NULL, tamanho_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd); // O mapeamento continua válido sem o descritor
+    } else {
+        // As páginas só são reservadas, e zeradas pelo kernel, no primeiro acesso
+        area = mmap(NULL, tamanho_bytes, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    }
+    if (area == MAP_FAILED) {
+        return NULL;
+    }
+    
+#ifdef MADV_HUGEPAGE
+    if (paginas_grandes && !arquivo && madvise(area, tamanho_bytes, MADV_HUGEPAGE) == -1) {
+        REGISTRAR_AVISO("Paginas grandes indisponiveis; usando paginas normais.\n");
+    }
+#else
+    if (paginas_grandes) {
+        REGISTRAR_AVISO("Paginas grandes nao suportadas neste sistema.\n");
+    }
+#endif
+    return (unsigned char*)area;
+}
+
+MemoriaFisica* criar_memoria_fisica_mapeada(int tamanho_mb, int tamanho_pagina_kb, int paginas_grandes, const char *arquivo) {
     // Converte megabytes para bytes
-    int tamanho_bytes = tamanho_mb * 1024 * 1024;
+    size_t tamanho_bytes = (size_t)tamanho_mb * 1024 * 1024;
+    // Validação dos parâmetros
+    if (tamanho_mb <= 0) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Tamanho da memoria deve ser maior que zero.\n");
+        return NULL;
+    }
+    
+    if (tamanho_pagina_kb <= 0) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Tamanho da pagina deve ser maior que zero.\n");
+        return NULL;
+    }
+    
+    // O tamanho da página em bytes é int
+    if (tamanho_pagina_kb > INT_MAX / 1024) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Tamanho da pagina deve ser de no maximo %d KB.\n", INT_MAX / 1024);
+        return NULL;
+    }
     // Converte kilobytes para bytes
     int tamanho_pagina_bytes = tamanho_pagina_kb * 1024;
-    int numero_quadros = tamanho_bytes / tamanho_pagina_bytes;
     
-    // Validação dos parâmetros
-    if (tamanho_pagina_kb <= 0) {
-        printf("Erro: Tamanho da pagina deve ser maior que zero.\n");
+    // A entrada da tabela de páginas guarda o quadro abaixo de TP_SEM_QUADRO
+    // (2^25 - 1 quadros: 128 GB com páginas de 4 KB, 32 GB com páginas de
+    // 1 KB); um quadro maior perderia os bits altos e mapearia outro quadro
+    if (tamanho_bytes / tamanho_pagina_bytes >= TP_SEM_QUADRO) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Memoria com %zu quadros; as tabelas de paginas enderecam menos de %u.\n",
+                     tamanho_bytes / tamanho_pagina_bytes, TP_SEM_QUADRO);
         return NULL;
     }
+    int numero_quadros = (int)(tamanho_bytes / tamanho_pagina_bytes);
     
     if (numero_quadros <= 0) {
-        printf("Erro: Memoria muito pequena para o tamanho de pagina especificado.\n");
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Memoria muito pequena para o tamanho de pagina especificado.\n");
         return NULL;
     }
     
     // Aloca a estrutura da memória física
     MemoriaFisica *mf = (MemoriaFisica*)malloc(sizeof(MemoriaFisica));
     if (!mf) {
-        printf("Erro: Falha ao alocar estrutura da memoria fisica.\n");
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar estrutura da memoria fisica.\n");
         return NULL;
     }
     
-    // Aloca a memória física
-    mf->memoria = (unsigned char*)malloc(tamanho_bytes);
+    // Mapeia a memória física
+    mf->memoria = mapear_memoria(tamanho_bytes, paginas_grandes, arquivo);
     if (!mf->memoria) {
-        printf("Erro: Falha ao alocar memoria fisica de %d MB.\n", tamanho_mb);
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar memoria fisica de %d MB.\n", tamanho_mb);
         free(mf);
         return NULL;
     }
+    mf->paginas_grandes = paginas_grandes ? 1 : 0;
+    mf->em_arquivo = arquivo != NULL;
     
-    // Aloca o mapa de quadros livres
-    mf->quadro_livre = (int*)malloc(numero_quadros * sizeof(int));
+    // Aloca o mapa de quadros livres (um bit por quadro, em palavras de 64 bits)
+    int num_palavras = (numero_quadros + QUADROS_POR_PALAVRA - 1) / QUADROS_POR_PALAVRA;
+    mf->quadro_livre = (uint64_t*)malloc(num_palavras * sizeof(uint64_t));
     if (!mf->quadro_livre) {
-        printf("Erro: Falha ao alocar mapa de quadros livres.\n");
-        free(mf->memoria);
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar mapa de quadros livres.\n");
+        munmap(mf->memoria, tamanho_bytes);
+        free(mf);
+        return NULL;
+    }
+    
+    // Contadores de compartilhamento, todos zerados (nenhum quadro compartilhado)
+    mf->compartilhamentos = (int*)calloc(numero_quadros, sizeof(int));
+    if (!mf->compartilhamentos) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar contadores de compartilhamento dos quadros.\n");
+        free(mf->quadro_livre);
+        munmap(mf->memoria, tamanho_bytes);
         free(mf);
         return NULL;
     }
@@ -47,121 +131,850 @@ MemoriaFisica* criar_memoria_fisica(int tamanho_mb, int tamanho_pagina_kb) {
     mf->tamanho_memoria = tamanho_bytes;
     mf->tamanho_pagina = tamanho_pagina_bytes;
     mf->numero_quadros = numero_quadros;
+    mf->num_palavras = num_palavras;
+    mf->dica_livre = 0;
+    mf->quadros_livres = 0;
+    mf->politica = ALOCACAO_PRIMEIRO_LIVRE;
+    mf->buddy_ordem = NULL;
+    mf->buddy_prox = NULL;
+    mf->buddy_ant = NULL;
+    memset(&mf->estatisticas, 0, sizeof(EstatisticasAlocacao));
+    mf->concorrente = 0;
+    mf->caches = NULL;
+    mf->num_cpus = 0;
+    mf->quadros_compartilhados = 0;
     
-    printf("Memoria fisica criada com sucesso:\n");
-    printf("- Tamanho: %d MB (%d bytes)\n", tamanho_mb, tamanho_bytes);
-    printf("- Tamanho da pagina: %d KB (%d bytes)\n", tamanho_pagina_kb, tamanho_pagina_bytes);
-    printf("- Numero de quadros: %d\n", numero_quadros);
+    REGISTRAR_INFO("Memoria fisica criada com sucesso:\n");
+    REGISTRAR_INFO("- Tamanho: %d MB (%zu bytes)\n", tamanho_mb, tamanho_bytes);
+    REGISTRAR_INFO("- Tamanho da pagina: %d KB (%d bytes)\n", tamanho_pagina_kb, tamanho_pagina_bytes);
+    REGISTRAR_INFO("- Numero de quadros: %d\n", numero_quadros);
+    if (arquivo) {
+        REGISTRAR_INFO("- Mapeada no arquivo: %s\n", arquivo);
+    }
+    if (mf->paginas_grandes) {
+        REGISTRAR_INFO("- Paginas grandes solicitadas\n");
+    }
     
     return mf;
 }
 
 void inicializar_memoria_fisica(MemoriaFisica *mf) {
     if (!mf || !mf->memoria || !mf->quadro_livre) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return;
     }
     
-    // Inicializa toda a memória física com zeros (opcional, mas boa prática)
-    memset(mf->memoria, 0, mf->tamanho_memoria);
+    // Zera a memória física. Em um mapeamento anônimo basta devolver as páginas
+    // ao kernel, que as entrega zeradas no próximo acesso; o custo não depende do
+    // tamanho da memória. Um mapeamento em arquivo preserva o conteúdo gravado.
+    if (!mf->em_arquivo && madvise(mf->memoria, mf->tamanho_memoria, MADV_DONTNEED) == -1) {
+        memset(mf->memoria, 0, mf->tamanho_memoria);
+    }
 
-    // Marca todos os quadros como livres (1)
-    for (int i = 0; i < mf->numero_quadros; i++) {
-        mf->quadro_livre[i] = 1;
+    // Marca todos os quadros como livres (1); os bits além do último quadro ficam em 0
+    for (int i = 0; i < mf->num_palavras; i++) {
+        mf->quadro_livre[i] = ~(uint64_t)0;
     }
-    printf("Memoria fisica inicializada. Total de quadros: %d\n", mf->numero_quadros);
+    int resto = mf->numero_quadros % QUADROS_POR_PALAVRA;
+    if (resto != 0) {
+        mf->quadro_livre[mf->num_palavras - 1] = ((uint64_t)1 << resto) - 1;
+    }
+    mf->quadros_livres = mf->numero_quadros;
+    mf->dica_livre = 0;
+    memset(mf->compartilhamentos, 0, mf->numero_quadros * sizeof(int));
+    mf->quadros_compartilhados = 0;
+    for (int cpu = 0; cpu < mf->num_cpus; cpu++) {
+        mf->caches[cpu].num_quadros = 0;
+    }
+    if (mf->politica == ALOCACAO_BUDDY) {
+        buddy_reconstruir(mf);
+    }
+    REGISTRAR_INFO("Memoria fisica inicializada. Total de quadros: %d\n", mf->numero_quadros);
 }
 
 void destruir_memoria_fisica(MemoriaFisica *mf) {
     if (mf) {
         if (mf->memoria) {
-            free(mf->memoria);
+            munmap(mf->memoria, mf->tamanho_memoria);
         }
         if (mf->quadro_livre) {
             free(mf->quadro_livre);
         }
+        free(mf->buddy_ordem);
+        free(mf->buddy_prox);
+        free(mf->buddy_ant);
+        free(mf->caches);
+        free(mf->compartilhamentos);
         free(mf);
-        printf("Memoria fisica liberada com sucesso.\n");
+        REGISTRAR_INFO("Memoria fisica liberada com sucesso.\n");
+    }
+}
+
+// Cache de quadros da CPU da thread corrente (NULL fora do modo concorrente ou sem CPU)
+static CacheQuadros* cache_atual(MemoriaFisica *mf) {
+    if (!mf->concorrente || cpu_atual < 0 || cpu_atual >= mf->num_cpus) {
+        return NULL;
+    }
+    return &mf->caches[cpu_atual];
+}
+
+// Soma atômica de um contador do alocador, usada por threads sem cache próprio
+static void somar_atomico(long long *contador, long long valor) {
+    __atomic_fetch_add(contador, valor, __ATOMIC_RELAXED);
+}
+
+static void registrar_alocacao(MemoriaFisica *mf, long long inicio_ns, int quadros, int sucesso) {
+    long long duracao = agora_ns() - inicio_ns;
+    CacheQuadros *cache = cache_atual(mf);
+    EstatisticasAlocacao *est = cache ? &cache->estatisticas : &mf->estatisticas;
+    if (mf->concorrente && !cache) {
+        somar_atomico(sucesso ? &est->alocacoes : &est->falhas, 1);
+        somar_atomico(&est->quadros_alocados, sucesso ? quadros : 0);
+        somar_atomico(&est->tempo_total_ns, duracao);
+        long long maximo = __atomic_load_n(&est->tempo_max_ns, __ATOMIC_RELAXED);
+        while (duracao > maximo && !__atomic_compare_exchange_n(&est->tempo_max_ns, &maximo, duracao, 1,
+                                                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        }
+        return;
+    }
+    if (sucesso) {
+        est->alocacoes++;
+        est->quadros_alocados += quadros;
+    } else {
+        est->falhas++;
+    }
+    est->tempo_total_ns += duracao;
+    if (duracao > est->tempo_max_ns) {
+        est->tempo_max_ns = duracao;
+    }
+}
+
+// Marca como ocupados os quadros [inicio, inicio + n) no mapa de bits
+static void marcar_ocupados(MemoriaFisica *mf, int inicio, int n) {
+    for (int i = inicio; i < inicio + n; i++) {
+        mf->quadro_livre[i / QUADROS_POR_PALAVRA] &= ~((uint64_t)1 << (i % QUADROS_POR_PALAVRA));
+    }
+    mf->quadros_livres -= n;
+}
+
+// ---------------------------------------------------------------------------
+// Política primeiro livre (first-fit) sobre o mapa de bits
+// ---------------------------------------------------------------------------
+
+static int alocar_quadro_primeiro_livre(MemoriaFisica *mf) {
+    // Procura uma palavra com algum bit livre, começando pela dica e dando a volta no mapa
+    for (int k = 0; k < mf->num_palavras; k++) {
+        int palavra = (mf->dica_livre + k) % mf->num_palavras;
+        uint64_t bits = mf->quadro_livre[palavra];
+        if (bits != 0) {
+            int bit = __builtin_ctzll(bits); // Primeiro quadro livre da palavra
+            mf->quadro_livre[palavra] = bits & (bits - 1); // Marca como ocupado
+            mf->quadros_livres--;
+            mf->dica_livre = palavra;
+            return palavra * QUADROS_POR_PALAVRA + bit;
+        }
+    }
+    return -1;
+}
+
+static void alocar_quadros_primeiro_livre(MemoriaFisica *mf, int n, int *quadros) {
+    // Percorre o mapa uma única vez, retirando os bits livres de cada palavra
+    int alocados = 0;
+    int palavra = mf->dica_livre;
+    while (alocados < n) {
+        uint64_t bits = mf->quadro_livre[palavra];
+        while (bits != 0 && alocados < n) {
+            int bit = __builtin_ctzll(bits);
+            quadros[alocados++] = palavra * QUADROS_POR_PALAVRA + bit;
+            bits &= bits - 1;
+        }
+        mf->quadro_livre[palavra] = bits;
+        if (bits == 0 && alocados < n) {
+            palavra = (palavra + 1) % mf->num_palavras;
+        }
+    }
+    mf->quadros_livres -= n;
+    mf->dica_livre = palavra;
+}
+
+// ---------------------------------------------------------------------------
+// Modo concorrente: mapa de bits atualizado com compare-and-swap e caches por CPU
+// ---------------------------------------------------------------------------
+
+// Retira até max quadros livres do mapa de bits global, tomando vários bits de
+// uma palavra em um único compare-and-swap. Retorna quantos quadros obteve.
+static int retirar_quadros_atomico(MemoriaFisica *mf, int *quadros, int max) {
+    int obtidos = 0;
+    int inicio = __atomic_load_n(&mf->dica_livre, __ATOMIC_RELAXED);
+    for (int k = 0; k < mf->num_palavras && obtidos < max; k++) {
+        int palavra = (inicio + k) % mf->num_palavras;
+        uint64_t bits = __atomic_load_n(&mf->quadro_livre[palavra], __ATOMIC_RELAXED);
+        while (bits != 0 && obtidos < max) {
+            // Seleciona os bits livres mais baixos, até completar o pedido
+            uint64_t tomados = 0;
+            uint64_t restantes = bits;
+            for (int n = obtidos; n < max && restantes != 0; n++) {
+                tomados |= restantes & (~restantes + 1);
+                restantes &= restantes - 1;
+            }
+            // Se outra thread mudou a palavra, bits recebe o valor atual e a seleção é refeita
+            if (__atomic_compare_exchange_n(&mf->quadro_livre[palavra], &bits, bits & ~tomados, 1,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                __atomic_fetch_sub(&mf->quadros_livres, __builtin_popcountll(tomados), __ATOMIC_RELAXED);
+                while (tomados != 0) {
+                    quadros[obtidos++] = palavra * QUADROS_POR_PALAVRA + __builtin_ctzll(tomados);
+                    tomados &= tomados - 1;
+                }
+                bits = restantes;
+            }
+        }
+        if (bits == 0) {
+            __atomic_store_n(&mf->dica_livre, (palavra + 1) % mf->num_palavras, __ATOMIC_RELAXED);
+        }
+    }
+    return obtidos;
+}
+
+// Devolve quadros ao mapa de bits global. Os bits são ligados com um OU
+// atômico, que também revela liberações duplicadas.
+static void devolver_quadros_atomico(MemoriaFisica *mf, const int *quadros, int n) {
+    for (int i = 0; i < n; i++) {
+        int palavra = quadros[i] / QUADROS_POR_PALAVRA;
+        uint64_t mascara = (uint64_t)1 << (quadros[i] % QUADROS_POR_PALAVRA);
+        uint64_t anterior = __atomic_fetch_or(&mf->quadro_livre[palavra], mascara, __ATOMIC_RELEASE);
+        if (anterior & mascara) {
+            REGISTRAR_AVISO("Tentativa de liberar um quadro que ja estava livre (quadro %d).\n", quadros[i]);
+            continue;
+        }
+        __atomic_fetch_add(&mf->quadros_livres, 1, __ATOMIC_RELAXED);
+        if (palavra < __atomic_load_n(&mf->dica_livre, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&mf->dica_livre, palavra, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int alocar_quadro_concorrente(MemoriaFisica *mf) {
+    CacheQuadros *cache = cache_atual(mf);
+    int quadro = -1;
+    if (!cache) {
+        retirar_quadros_atomico(mf, &quadro, 1);
+        return quadro;
+    }
+    if (cache->num_quadros == 0) {
+        cache->num_quadros = retirar_quadros_atomico(mf, cache->quadros, CACHE_QUADROS_LOTE);
+    }
+    if (cache->num_quadros > 0) {
+        quadro = cache->quadros[--cache->num_quadros];
+    }
+    return quadro;
+}
+
+// Usa primeiro os quadros do cache da CPU e retira o restante diretamente do
+// mapa global; se faltarem quadros, tudo o que foi obtido é devolvido
+static int alocar_quadros_concorrente(MemoriaFisica *mf, int n, int *quadros) {
+    CacheQuadros *cache = cache_atual(mf);
+    int obtidos = 0;
+    while (cache && cache->num_quadros > 0 && obtidos < n) {
+        quadros[obtidos++] = cache->quadros[--cache->num_quadros];
+    }
+    obtidos += retirar_quadros_atomico(mf, quadros + obtidos, n - obtidos);
+    if (obtidos < n) {
+        devolver_quadros_atomico(mf, quadros, obtidos);
+        return 0;
+    }
+    return 1;
+}
+
+static void liberar_quadro_concorrente(MemoriaFisica *mf, int quadro_index) {
+    CacheQuadros *cache = cache_atual(mf);
+    if (!cache) {
+        devolver_quadros_atomico(mf, &quadro_index, 1);
+        return;
+    }
+    // Cache cheio: devolve ao mapa global o lote mais antigo (a base da pilha)
+    if (cache->num_quadros == CACHE_QUADROS_CAPACIDADE) {
+        devolver_quadros_atomico(mf, cache->quadros, CACHE_QUADROS_LOTE);
+        cache->num_quadros -= CACHE_QUADROS_LOTE;
+        memmove(cache->quadros, cache->quadros + CACHE_QUADROS_LOTE, cache->num_quadros * sizeof(int));
+    }
+    cache->quadros[cache->num_quadros++] = quadro_index;
+}
+
+int ativar_alocacao_concorrente(MemoriaFisica *mf, int num_cpus) {
+    if (!mf || !mf->quadro_livre || num_cpus <= 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Parametros invalidos para a alocacao concorrente.\n");
+        return 0;
+    }
+    if (mf->politica != ALOCACAO_PRIMEIRO_LIVRE) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A alocacao concorrente exige a politica primeiro livre.\n");
+        return 0;
+    }
+    if (mf->concorrente) {
+        desativar_alocacao_concorrente(mf);
+    }
+    
+    mf->caches = (CacheQuadros*)aligned_alloc(64, num_cpus * sizeof(CacheQuadros));
+    if (!mf->caches) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar os caches de quadros.\n");
+        return 0;
+    }
+    memset(mf->caches, 0, num_cpus * sizeof(CacheQuadros));
+    mf->num_cpus = num_cpus;
+    mf->concorrente = 1;
+    REGISTRAR_INFO("Alocacao concorrente ativada (%d CPUs).\n", num_cpus);
+    return 1;
+}
+
+void desativar_alocacao_concorrente(MemoriaFisica *mf) {
+    if (!mf || !mf->concorrente) {
+        return;
+    }
+    EstatisticasAlocacao *est = &mf->estatisticas;
+    for (int cpu = 0; cpu < mf->num_cpus; cpu++) {
+        CacheQuadros *cache = &mf->caches[cpu];
+        devolver_quadros_atomico(mf, cache->quadros, cache->num_quadros);
+        est->alocacoes += cache->estatisticas.alocacoes;
+        est->falhas += cache->estatisticas.falhas;
+        est->quadros_alocados += cache->estatisticas.quadros_alocados;
+        est->tempo_total_ns += cache->estatisticas.tempo_total_ns;
+        if (cache->estatisticas.tempo_max_ns > est->tempo_max_ns) {
+            est->tempo_max_ns = cache->estatisticas.tempo_max_ns;
+        }
+    }
+    free(mf->caches);
+    mf->caches = NULL;
+    mf->num_cpus = 0;
+    mf->concorrente = 0;
+    REGISTRAR_INFO("Alocacao concorrente desativada.\n");
+}
+
+void definir_cpu_atual(int cpu) {
+    cpu_atual = cpu;
+}
+
+// ---------------------------------------------------------------------------
+// Política buddy: blocos livres de 2^ordem quadros contíguos e alinhados
+// ---------------------------------------------------------------------------
+
+static void buddy_inserir(MemoriaFisica *mf, int inicio, int ordem) {
+    mf->buddy_ordem[inicio] = (signed char)ordem;
+    mf->buddy_ant[inicio] = -1;
+    mf->buddy_prox[inicio] = mf->buddy_cabeca[ordem];
+    if (mf->buddy_cabeca[ordem] != -1) {
+        mf->buddy_ant[mf->buddy_cabeca[ordem]] = inicio;
+    }
+    mf->buddy_cabeca[ordem] = inicio;
+}
+
+static void buddy_remover(MemoriaFisica *mf, int inicio) {
+    int ordem = mf->buddy_ordem[inicio];
+    int ant = mf->buddy_ant[inicio];
+    int prox = mf->buddy_prox[inicio];
+    if (ant != -1) {
+        mf->buddy_prox[ant] = prox;
+    } else {
+        mf->buddy_cabeca[ordem] = prox;
+    }
+    if (prox != -1) {
+        mf->buddy_ant[prox] = ant;
+    }
+    mf->buddy_ordem[inicio] = -1;
+}
+
+// Reconstrói as listas de blocos livres a partir do mapa de bits, formando
+// os maiores blocos alinhados possíveis com os quadros livres atuais
+static void buddy_reconstruir(MemoriaFisica *mf) {
+    for (int k = 0; k < BUDDY_MAX_ORDENS; k++) {
+        mf->buddy_cabeca[k] = -1;
+    }
+    for (int i = 0; i < mf->numero_quadros; i++) {
+        mf->buddy_ordem[i] = -1;
+    }
+    
+    int i = 0;
+    while (i < mf->numero_quadros) {
+        if (!quadro_esta_livre(mf, i)) {
+            i++;
+            continue;
+        }
+        int ordem = 0;
+        while (ordem + 1 < BUDDY_MAX_ORDENS) {
+            int tamanho = 1 << (ordem + 1);
+            if (i % tamanho != 0 || i + tamanho > mf->numero_quadros) {
+                break;
+            }
+            // A metade superior do bloco candidato precisa estar toda livre
+            int livre = 1;
+            for (int j = i + (tamanho / 2); j < i + tamanho; j++) {
+                if (!quadro_esta_livre(mf, j)) {
+                    livre = 0;
+                    break;
+                }
+            }
+            if (!livre) {
+                break;
+            }
+            ordem++;
+        }
+        buddy_inserir(mf, i, ordem);
+        i += 1 << ordem;
+    }
+}
+
+// Retira um bloco livre de 2^ordem quadros, dividindo blocos maiores se necessário
+static int buddy_alocar_bloco(MemoriaFisica *mf, int ordem) {
+    int k = ordem;
+    while (k < BUDDY_MAX_ORDENS && mf->buddy_cabeca[k] == -1) {
+        k++;
+    }
+    if (k == BUDDY_MAX_ORDENS) {
+        return -1;
+    }
+    
+    int inicio = mf->buddy_cabeca[k];
+    buddy_remover(mf, inicio);
+    // Devolve as metades superiores não usadas às listas de ordem menor
+    while (k > ordem) {
+        k--;
+        buddy_inserir(mf, inicio + (1 << k), k);
+    }
+    marcar_ocupados(mf, inicio, 1 << ordem);
+    return inicio;
+}
+
+static void alocar_quadros_buddy(MemoriaFisica *mf, int n, int *quadros) {
+    // Decompõe n em potências de dois, da maior para a menor; se faltar um
+    // bloco de certa ordem, a parte restante é pedida em blocos menores
+    int alocados = 0;
+    int ordem = BUDDY_MAX_ORDENS - 1;
+    while (alocados < n) {
+        while ((1 << ordem) > n - alocados) {
+            ordem--;
+        }
+        int inicio = buddy_alocar_bloco(mf, ordem);
+        if (inicio == -1) {
+            ordem--;
+            continue;
+        }
+        for (int i = 0; i < (1 << ordem); i++) {
+            quadros[alocados++] = inicio + i;
+        }
+    }
+}
+
+// Retira um quadro livre específico das listas do buddy, devolvendo a elas as
+// partes do bloco que o continha que continuam livres
+static void buddy_reservar_quadro(MemoriaFisica *mf, int quadro_index) {
+    int ordem = 0;
+    int inicio = quadro_index;
+    while (ordem + 1 < BUDDY_MAX_ORDENS && mf->buddy_ordem[inicio] != ordem) {
+        ordem++;
+        inicio = quadro_index & ~((1 << ordem) - 1);
+    }
+    buddy_remover(mf, inicio);
+    while (ordem > 0) {
+        ordem--;
+        int metade = 1 << ordem;
+        if (quadro_index >= inicio + metade) {
+            buddy_inserir(mf, inicio, ordem);
+            inicio += metade;
+        } else {
+            buddy_inserir(mf, inicio + metade, ordem);
+        }
+    }
+}
+
+// Devolve um quadro ao buddy, unindo-o ao seu par enquanto este também estiver livre
+static void buddy_liberar(MemoriaFisica *mf, int quadro_index) {
+    int inicio = quadro_index;
+    int ordem = 0;
+    while (ordem + 1 < BUDDY_MAX_ORDENS) {
+        int par = inicio ^ (1 << ordem);
+        if (par >= mf->numero_quadros || mf->buddy_ordem[par] != ordem) {
+            break;
+        }
+        buddy_remover(mf, par);
+        if (par < inicio) {
+            inicio = par;
+        }
+        ordem++;
+    }
+    buddy_inserir(mf, inicio, ordem);
+}
+
+int definir_politica_alocacao(MemoriaFisica *mf, PoliticaAlocacao politica) {
+    if (!mf || !mf->quadro_livre) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
+        return 0;
+    }
+    
+    if (mf->concorrente && politica != ALOCACAO_PRIMEIRO_LIVRE) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A alocacao concorrente exige a politica primeiro livre.\n");
+        return 0;
+    }
+    
+    if (politica == ALOCACAO_BUDDY) {
+        if (!mf->buddy_ordem) {
+            mf->buddy_ordem = (signed char*)malloc(mf->numero_quadros * sizeof(signed char));
+            mf->buddy_prox = (int*)malloc(mf->numero_quadros * sizeof(int));
+            mf->buddy_ant = (int*)malloc(mf->numero_quadros * sizeof(int));
+            if (!mf->buddy_ordem || !mf->buddy_prox || !mf->buddy_ant) {
+                RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar estruturas do alocador buddy.\n");
+                free(mf->buddy_ordem);
+                free(mf->buddy_prox);
+                free(mf->buddy_ant);
+                mf->buddy_ordem = NULL;
+                mf->buddy_prox = NULL;
+                mf->buddy_ant = NULL;
+                return 0;
+            }
+        }
+        buddy_reconstruir(mf);
+    } else if (politica == ALOCACAO_PRIMEIRO_LIVRE) {
+        mf->dica_livre = 0;
+    } else {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Politica de alocacao invalida (%d).\n", politica);
+        return 0;
+    }
+    
+    mf->politica = politica;
+    memset(&mf->estatisticas, 0, sizeof(EstatisticasAlocacao));
+    REGISTRAR_INFO("Politica de alocacao: %s\n", nome_politica_alocacao(politica));
+    return 1;
+}
+
+const char* nome_politica_alocacao(PoliticaAlocacao politica) {
+    switch (politica) {
+        case ALOCACAO_PRIMEIRO_LIVRE: return "primeiro livre";
+        case ALOCACAO_BUDDY:          return "buddy";
+        default:                      return "desconhecida";
     }
 }
 
 int alocar_quadro(MemoriaFisica *mf) {
     if (!mf || !mf->quadro_livre) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return -1;
     }
     
-    // Procura por um quadro livre
+    long long inicio_ns = agora_ns();
+    if (!mf->concorrente && mf->quadros_livres == 0) {
+        registrar_alocacao(mf, inicio_ns, 0, 0);
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Nao ha quadros livres na memoria fisica.\n");
+        return -1; // Retorna -1 se não houver quadros livres
+    }
+    
+    int i;
+    if (mf->concorrente) {
+        i = alocar_quadro_concorrente(mf);
+    } else if (mf->politica == ALOCACAO_BUDDY) {
+        i = buddy_alocar_bloco(mf, 0);
+    } else {
+        i = alocar_quadro_primeiro_livre(mf);
+    }
+    registrar_alocacao(mf, inicio_ns, 1, i != -1);
+    
+    if (i == -1) {
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Nao ha quadros livres na memoria fisica.\n");
+        return -1;
+    }
+    REGISTRAR_DEPURACAO("Quadro %d alocado.\n", i);
+    return i; // Retorna o índice do quadro alocado
+}
+
+int alocar_quadros(MemoriaFisica *mf, int n, int *quadros) {
+    if (!mf || !mf->quadro_livre) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
+        return 0;
+    }
+    
+    long long inicio_ns = agora_ns();
+    if (mf->concorrente) {
+        int sucesso = alocar_quadros_concorrente(mf, n, quadros);
+        registrar_alocacao(mf, inicio_ns, n, sucesso);
+        if (!sucesso) {
+            RELATAR_ERRO(ERRO_SEM_QUADROS, "Nao ha quadros livres suficientes (%d solicitados).\n", n);
+        }
+        return sucesso;
+    }
+    
+    // Verifica antes de tocar no mapa, para que a falha não deixe alocações parciais
+    if (n > mf->quadros_livres) {
+        registrar_alocacao(mf, inicio_ns, 0, 0);
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Nao ha quadros livres suficientes (%d solicitados, %d livres).\n",
+                     n, mf->quadros_livres);
+        return 0;
+    }
+    
+    if (mf->politica == ALOCACAO_BUDDY) {
+        alocar_quadros_buddy(mf, n, quadros);
+    } else {
+        alocar_quadros_primeiro_livre(mf, n, quadros);
+    }
+    registrar_alocacao(mf, inicio_ns, n, 1);
+    
+    return 1;
+}
+
+// Retira um dos mapeamentos extras de um quadro compartilhado; retorna 0 se o quadro não era compartilhado
+static int retirar_compartilhamento(MemoriaFisica *mf, int quadro_index) {
+    int extras = __atomic_load_n(&mf->compartilhamentos[quadro_index], __ATOMIC_RELAXED);
+    while (extras > 0) {
+        if (__atomic_compare_exchange_n(&mf->compartilhamentos[quadro_index], &extras, extras - 1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            if (extras == 1) {
+                __atomic_fetch_sub(&mf->quadros_compartilhados, 1, __ATOMIC_RELAXED);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int liberar_quadro(MemoriaFisica *mf, int quadro_index) {
+    if (!mf || !mf->quadro_livre) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
+        return 0;
+    }
+    
+    if (quadro_index >= 0 && quadro_index < mf->numero_quadros && retirar_compartilhamento(mf, quadro_index)) {
+        REGISTRAR_DEPURACAO("Quadro %d continua compartilhado.\n", quadro_index);
+        return 0;
+    }
+    
+    if (mf->concorrente && quadro_index >= 0 && quadro_index < mf->numero_quadros) {
+        liberar_quadro_concorrente(mf, quadro_index);
+        REGISTRAR_DEPURACAO("Quadro %d liberado.\n", quadro_index);
+        return 1;
+    } else if (quadro_index >= 0 && quadro_index < mf->numero_quadros) {
+        int palavra = quadro_index / QUADROS_POR_PALAVRA;
+        uint64_t mascara = (uint64_t)1 << (quadro_index % QUADROS_POR_PALAVRA);
+        if (!(mf->quadro_livre[palavra] & mascara)) {
+            mf->quadro_livre[palavra] |= mascara; // Marca como livre
+            mf->quadros_livres++;
+            if (palavra < mf->dica_livre) {
+                mf->dica_livre = palavra; // Mantém a busca pelo quadro livre mais baixo
+            }
+            if (mf->politica == ALOCACAO_BUDDY) {
+                buddy_liberar(mf, quadro_index);
+            }
+            REGISTRAR_DEPURACAO("Quadro %d liberado.\n", quadro_index);
+            return 1;
+        }
+        REGISTRAR_AVISO("Tentativa de liberar um quadro que ja estava livre (quadro %d).\n", quadro_index);
+    } else {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "Indice de quadro invalido para liberacao (%d).\n", quadro_index);
+    }
+    return 0;
+}
+
+// 1 se o quadro é válido e está ocupado; o mapa é lido atomicamente, pois outras CPUs podem alterá-lo
+static int quadro_ocupado(MemoriaFisica *mf, int quadro_index) {
+    if (!mf || quadro_index < 0 || quadro_index >= mf->numero_quadros) {
+        return 0;
+    }
+    uint64_t palavra = __atomic_load_n(&mf->quadro_livre[quadro_index / QUADROS_POR_PALAVRA], __ATOMIC_RELAXED);
+    return !((palavra >> (quadro_index % QUADROS_POR_PALAVRA)) & 1);
+}
+
+int compartilhar_quadro(MemoriaFisica *mf, int quadro_index) {
+    if (!quadro_ocupado(mf, quadro_index)) {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "Quadro %d invalido para compartilhamento.\n", quadro_index);
+        return 0;
+    }
+    if (__atomic_fetch_add(&mf->compartilhamentos[quadro_index], 1, __ATOMIC_RELAXED) == 0) {
+        __atomic_fetch_add(&mf->quadros_compartilhados, 1, __ATOMIC_RELAXED);
+    }
+    return 1;
+}
+
+int referencias_quadro(MemoriaFisica *mf, int quadro_index) {
+    if (!quadro_ocupado(mf, quadro_index)) {
+        return 0;
+    }
+    return 1 + __atomic_load_n(&mf->compartilhamentos[quadro_index], __ATOMIC_ACQUIRE);
+}
+
+int migrar_quadro(MemoriaFisica *mf, int origem, int destino) {
+    if (mf->concorrente || !quadro_ocupado(mf, origem) || !quadro_esta_livre(mf, destino)) {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "Nao e possivel migrar o quadro %d para o quadro %d.\n", origem, destino);
+        return 0;
+    }
+    
+    if (mf->politica == ALOCACAO_BUDDY) {
+        buddy_reservar_quadro(mf, destino);
+    }
+    marcar_ocupados(mf, destino, 1);
+    memcpy(mf->memoria + (size_t)destino * mf->tamanho_pagina, mf->memoria + (size_t)origem * mf->tamanho_pagina,
+           mf->tamanho_pagina);
+    
+    // Os mapeamentos extras acompanham o conteúdo, e a origem é liberada como um quadro privado
+    mf->compartilhamentos[destino] = mf->compartilhamentos[origem];
+    mf->compartilhamentos[origem] = 0;
+    liberar_quadro(mf, origem);
+    REGISTRAR_DEPURACAO("Quadro %d migrado para o quadro %d.\n", origem, destino);
+    return 1;
+}
+
+// Valida que [quadro_index * tamanho_pagina, + bytes) está dentro da memória física
+static int intervalo_quadros_valido(MemoriaFisica *mf, int quadro_index, size_t bytes) {
+    if (quadro_index < 0 || quadro_index >= mf->numero_quadros) {
+        return 0;
+    }
+    size_t base = (size_t)quadro_index * mf->tamanho_pagina;
+    return bytes <= mf->tamanho_memoria - base;
+}
+
+int escrever_pagina(MemoriaFisica *mf, int quadro_index, const unsigned char *origem, size_t bytes) {
+    if (!mf || !mf->memoria) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
+        return 0;
+    }
+    
+    if (!intervalo_quadros_valido(mf, quadro_index, bytes)) {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "Tentativa de escrita de %zu bytes em intervalo invalido (quadro %d).\n",
+                     bytes, quadro_index);
+        return 0;
+    }
+    
+    memcpy(mf->memoria + (size_t)quadro_index * mf->tamanho_pagina, origem, bytes);
+    return 1;
+}
+
+int ler_pagina(MemoriaFisica *mf, int quadro_index, unsigned char *destino, size_t bytes) {
+    if (!mf || !mf->memoria) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
+        return 0;
+    }
+    
+    if (!intervalo_quadros_valido(mf, quadro_index, bytes)) {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "Tentativa de leitura de %zu bytes em intervalo invalido (quadro %d).\n",
+                     bytes, quadro_index);
+        return 0;
+    }
+    
+    memcpy(destino, mf->memoria + (size_t)quadro_index * mf->tamanho_pagina, bytes);
+    return 1;
+}
+
+void calcular_fragmentacao(MemoriaFisica *mf, int *maior_bloco_livre, int *num_blocos_livres) {
+    int maior = 0, blocos = 0, atual = 0;
     for (int i = 0; i < mf->numero_quadros; i++) {
-        if (mf->quadro_livre[i] == 1) {
-            mf->quadro_livre[i] = 0; // Marca como ocupado
-            printf("Quadro %d alocado.\n", i);
-            return i; // Retorna o índice do quadro alocado
+        // Palavras inteiramente livres ou ocupadas são tratadas de uma vez
+        if (i % QUADROS_POR_PALAVRA == 0 && i + QUADROS_POR_PALAVRA <= mf->numero_quadros) {
+            uint64_t bits = mf->quadro_livre[i / QUADROS_POR_PALAVRA];
+            if (bits == 0 || bits == ~(uint64_t)0) {
+                if (bits == 0) {
+                    if (atual > maior) maior = atual;
+                    atual = 0;
+                } else {
+                    if (atual == 0) blocos++;
+                    atual += QUADROS_POR_PALAVRA;
+                }
+                i += QUADROS_POR_PALAVRA - 1;
+                continue;
+            }
+        }
+        if (quadro_esta_livre(mf, i)) {
+            if (atual == 0) blocos++;
+            atual++;
+        } else {
+            if (atual > maior) maior = atual;
+            atual = 0;
         }
     }
-    printf("Erro: Nao ha quadros livres na memoria fisica.\n");
-    return -1; // Retorna -1 se não houver quadros livres
+    if (atual > maior) maior = atual;
+    
+    *maior_bloco_livre = maior;
+    *num_blocos_livres = blocos;
 }
 
-void liberar_quadro(MemoriaFisica *mf, int quadro_index) {
+void exibir_estatisticas_alocacao(MemoriaFisica *mf) {
     if (!mf || !mf->quadro_livre) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return;
     }
     
-    if (quadro_index >= 0 && quadro_index < mf->numero_quadros) {
-        if (mf->quadro_livre[quadro_index] == 0) {
-            mf->quadro_livre[quadro_index] = 1; // Marca como livre
-            printf("Quadro %d liberado.\n", quadro_index);
-        } else {
-            printf("Atencao: Tentativa de liberar um quadro que ja estava livre (quadro %d).\n", quadro_index);
+    int maior_bloco, num_blocos;
+    calcular_fragmentacao(mf, &maior_bloco, &num_blocos);
+    EstatisticasAlocacao *est = &mf->estatisticas;
+    long long chamadas = est->alocacoes + est->falhas;
+    
+    printf("\n=== ESTATISTICAS DE ALOCACAO ===\n");
+    printf("Politica: %s\n", nome_politica_alocacao(mf->politica));
+    printf("Quadros livres: %d / %d\n", mf->quadros_livres, mf->numero_quadros);
+    printf("Blocos livres contiguos: %d\n", num_blocos);
+    printf("Maior bloco livre: %d quadros\n", maior_bloco);
+    printf("Fragmentacao externa: %.2f%%\n",
+           mf->quadros_livres > 0 ? (1.0 - (double)maior_bloco / mf->quadros_livres) * 100 : 0.0);
+    if (mf->politica == ALOCACAO_BUDDY) {
+        printf("Blocos livres por ordem:");
+        for (int k = 0; k < BUDDY_MAX_ORDENS; k++) {
+            int count = 0;
+            for (int b = mf->buddy_cabeca[k]; b != -1; b = mf->buddy_prox[b]) {
+                count++;
+            }
+            if (count > 0) {
+                printf(" [%d]=%d", k, count);
+            }
         }
-    } else {
-        printf("Erro: Indice de quadro invalido para liberacao (%d).\n", quadro_index);
+        printf("\n");
     }
+    int ocupados = mf->numero_quadros - mf->quadros_livres;
+    printf("Quadros ocupados: %d privados, %d compartilhados\n",
+           ocupados - mf->quadros_compartilhados, mf->quadros_compartilhados);
+    printf("Alocacoes: %lld (%lld quadros), falhas: %lld\n",
+           est->alocacoes, est->quadros_alocados, est->falhas);
+    printf("Latencia media: %.1f ns, maxima: %lld ns\n",
+           chamadas > 0 ? (double)est->tempo_total_ns / chamadas : 0.0, est->tempo_max_ns);
+    printf("================================\n\n");
 }
 
-void escrever_na_memoria(MemoriaFisica *mf, int endereco_fisico, unsigned char valor) {
+int quadro_esta_livre(MemoriaFisica *mf, int quadro_index) {
+    if (quadro_index < 0 || quadro_index >= mf->numero_quadros) {
+        return 0;
+    }
+    return (mf->quadro_livre[quadro_index / QUADROS_POR_PALAVRA] >> (quadro_index % QUADROS_POR_PALAVRA)) & 1;
+}
+
+void escrever_na_memoria(MemoriaFisica *mf, size_t endereco_fisico, unsigned char valor) {
     if (!mf || !mf->memoria) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return;
     }
     
-    if (endereco_fisico >= 0 && endereco_fisico < mf->tamanho_memoria) {
+    if (endereco_fisico < mf->tamanho_memoria) {
         mf->memoria[endereco_fisico] = valor;
     } else {
-        printf("Erro: Tentativa de escrita em endereco fisico invalido (%d).\n", endereco_fisico);
+        RELATAR_ERRO(ERRO_ENDERECO_INVALIDO, "Tentativa de escrita em endereco fisico invalido (%zu).\n", endereco_fisico);
     }
 }
 
-unsigned char ler_da_memoria(MemoriaFisica *mf, int endereco_fisico) {
+unsigned char ler_da_memoria(MemoriaFisica *mf, size_t endereco_fisico) {
     if (!mf || !mf->memoria) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return 0;
     }
     
-    if (endereco_fisico >= 0 && endereco_fisico < mf->tamanho_memoria) {
+    if (endereco_fisico < mf->tamanho_memoria) {
         return mf->memoria[endereco_fisico];
     } else {
-        printf("Erro: Tentativa de leitura de endereco fisico invalido (%d).\n", endereco_fisico);
+        RELATAR_ERRO(ERRO_ENDERECO_INVALIDO, "Tentativa de leitura de endereco fisico invalido (%zu).\n", endereco_fisico);
         return 0; // Retorna 0 em caso de erro
     }
 }
 
 void exibir_status_memoria(MemoriaFisica *mf) {
     if (!mf || !mf->quadro_livre) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return;
     }
     
-    int livres = 0, ocupados = 0;
-    for (int i = 0; i < mf->numero_quadros; i++) {
-        if (mf->quadro_livre[i]) livres++;
-        else ocupados++;
-    }
+    int livres = mf->quadros_livres;
+    int ocupados = mf->numero_quadros - livres;
     
     printf("\n=== Status da Memoria Fisica ===\n");
-    printf("Tamanho total: %d MB (%d bytes)\n", mf->tamanho_memoria / (1024 * 1024), mf->tamanho_memoria);
+    printf("Tamanho total: %zu MB (%zu bytes)\n", mf->tamanho_memoria / (1024 * 1024), mf->tamanho_memoria);
     printf("Tamanho da pagina: %d KB (%d bytes)\n", mf->tamanho_pagina / 1024, mf->tamanho_pagina);
     printf("Numero total de quadros: %d\n", mf->numero_quadros);
     printf("Quadros livres: %d\n", livres);
@@ -172,7 +985,7 @@ void exibir_status_memoria(MemoriaFisica *mf) {
 
 void visualizar_quadros_memoria(MemoriaFisica *mf, int quadros_por_linha) {
     if (!mf || !mf->quadro_livre) {
-        printf("Erro: Memoria fisica nao foi criada corretamente.\n");
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Memoria fisica nao foi criada corretamente.\n");
         return;
     }
     
@@ -195,7 +1008,7 @@ void visualizar_quadros_memoria(MemoriaFisica *mf, int quadros_por_linha) {
             int quadro_index = linha * quadros_por_linha + col;
             
             if (quadro_index < mf->numero_quadros) {
-                printf("%d", mf->quadro_livre[quadro_index] ? 0 : 1);
+                printf("%d", quadro_esta_livre(mf, quadro_index) ? 0 : 1);
             } else {
                 printf(" "); // Espaço vazio para completar a linha
             }
@@ -209,11 +1022,8 @@ void visualizar_quadros_memoria(MemoriaFisica *mf, int quadros_por_linha) {
     }
     
     // Estatísticas visuais
-    int livres = 0, ocupados = 0;
-    for (int i = 0; i < mf->numero_quadros; i++) {
-        if (mf->quadro_livre[i]) livres++;
-        else ocupados++;
-    }
+    int livres = mf->quadros_livres;
+    int ocupados = mf->numero_quadros - livres;
     
     printf("\nResumo:\n");
     printf("Quadros livres (0): %d\n", livres);
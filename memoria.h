@@ -1,16 +1,68 @@
 #ifndef MEMORIA_H
 #define MEMORIA_H
 
+#include "erros.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+// Número de quadros representados por cada palavra do mapa de bits
+#define QUADROS_POR_PALAVRA 64
+
+// Quadros guardados no cache de cada CPU no modo concorrente, e quantos são
+// trocados de uma vez com o mapa de bits global ao reabastecer ou esvaziar o cache
+#define CACHE_QUADROS_CAPACIDADE 64
+#define CACHE_QUADROS_LOTE 32
+
+// Número de ordens do alocador buddy (blocos de 2^0 até 2^(BUDDY_MAX_ORDENS-1) quadros)
+#define BUDDY_MAX_ORDENS 31
+
+// Políticas de alocação de quadros físicos
+typedef enum {
+    ALOCACAO_PRIMEIRO_LIVRE = 0,      // Primeiro quadro livre no mapa de bits (first-fit)
+    ALOCACAO_BUDDY = 1                // Sistema buddy, com blocos contíguos de 2^k quadros
+} PoliticaAlocacao;
+
+// Contadores de desempenho do alocador de quadros
+typedef struct {
+    long long alocacoes;              // Chamadas de alocação bem-sucedidas
+    long long falhas;                 // Chamadas de alocação que falharam
+    long long quadros_alocados;       // Total de quadros entregues
+    long long tempo_total_ns;         // Tempo acumulado nas chamadas de alocação
+    long long tempo_max_ns;           // Maior latência observada em uma chamada
+} EstatisticasAlocacao;
+
+// Cache de quadros livres de uma CPU (modo concorrente). Só a thread registrada
+// com o número da CPU o usa, portanto nenhuma operação sobre ele precisa de trava.
+typedef struct {
+    int quadros[CACHE_QUADROS_CAPACIDADE]; // Pilha de quadros livres (o topo é o liberado mais recentemente)
+    int num_quadros;                  // Quadros na pilha
+    EstatisticasAlocacao estatisticas; // Contadores das alocações feitas por esta CPU
+} __attribute__((aligned(64))) CacheQuadros;
 
 // Estrutura para representar a memória física
 typedef struct {
-    unsigned char *memoria;           // Ponteiro para a memória física alocada dinamicamente
-    int *quadro_livre;                // Um mapa de bits para rastrear quadros livres/ocupados (1 para livre, 0 para ocupado)
-    int tamanho_memoria;              // Tamanho total da memória em bytes
+    unsigned char *memoria;           // Ponteiro para a memória física (área mapeada com mmap)
+    int em_arquivo;                   // 1 se a memória está mapeada em um arquivo (conteúdo persistente)
+    int paginas_grandes;              // 1 se foram pedidas páginas grandes do hospedeiro (MADV_HUGEPAGE)
+    uint64_t *quadro_livre;           // Mapa de bits compactado dos quadros (bit 1 para livre, 0 para ocupado)
+    int num_palavras;                 // Número de palavras de 64 bits no mapa de quadros
+    int dica_livre;                   // Palavra a partir da qual a próxima busca por quadro livre começa
+    int quadros_livres;               // Contador de quadros livres, mantido a cada alocação/liberação
+    size_t tamanho_memoria;           // Tamanho total da memória em bytes
     int tamanho_pagina;               // Tamanho de cada página/quadro em bytes
-    int numero_quadros;               // Número total de quadros na memória física
+    int numero_quadros;               // Número total de quadros na memória física (menos que TP_SEM_QUADRO)
+    PoliticaAlocacao politica;        // Política de alocação de quadros em uso
+    int buddy_cabeca[BUDDY_MAX_ORDENS]; // Primeiro bloco livre de cada ordem (-1 se a lista está vazia)
+    signed char *buddy_ordem;         // Ordem do bloco livre que começa em cada quadro (-1 se não começa um)
+    int *buddy_prox;                  // Próximo bloco livre da mesma ordem
+    int *buddy_ant;                   // Bloco livre anterior da mesma ordem
+    EstatisticasAlocacao estatisticas; // Latência e contadores do alocador
+    int concorrente;                  // 1 se o mapa de bits é atualizado com operações atômicas (várias threads)
+    CacheQuadros *caches;             // Cache de quadros de cada CPU no modo concorrente
+    int num_cpus;                     // Número de caches
+    int *compartilhamentos;           // Mapeamentos de cada quadro além do primeiro (fork com cópia na escrita)
+    int quadros_compartilhados;       // Quadros mapeados por mais de uma página
 } MemoriaFisica;
 
 // Funções de gerenciamento da memória física
@@ -24,9 +76,27 @@ typedef struct {
  */
 MemoriaFisica* criar_memoria_fisica(int tamanho_mb, int tamanho_pagina_kb);
 
+/**
+ * @brief Cria a memória física com opções de mapeamento.
+ * 
+ * A área é reservada com mmap: sem arquivo, é um mapeamento anônimo com
+ * MAP_NORESERVE cujas páginas só ocupam memória do hospedeiro quando tocadas;
+ * com arquivo, é compartilhada com ele e o conteúdo persiste entre execuções.
+ * 
+ * @param tamanho_mb Tamanho da memória em megabytes.
+ * @param tamanho_pagina_kb Tamanho de cada página/quadro em kilobytes.
+ * @param paginas_grandes 1 para pedir páginas grandes ao kernel (apenas sem arquivo).
+ * @param arquivo Caminho do arquivo de apoio, ou NULL para memória anônima.
+ * @return Ponteiro para a estrutura da Memória Física alocada, ou NULL em caso de erro.
+ */
+MemoriaFisica* criar_memoria_fisica_mapeada(int tamanho_mb, int tamanho_pagina_kb, int paginas_grandes, const char *arquivo);
+
 /**
  * @brief Inicializa a memória física, marcando todos os quadros como livres.
  * 
+ * A memória anônima é zerada de forma preguiçosa pelo kernel; a mapeada em
+ * arquivo mantém o conteúdo do arquivo.
+ * 
  * @param mf Ponteiro para a estrutura da Memória Física.
  */
 void inicializar_memoria_fisica(MemoriaFisica *mf);
@@ -46,13 +116,134 @@ void destruir_memoria_fisica(MemoriaFisica *mf);
  */
 int alocar_quadro(MemoriaFisica *mf);
 
+/**
+ * @brief Aloca vários quadros livres de uma só vez.
+ * 
+ * A operação é atômica: se não houver quadros livres suficientes, nenhum
+ * quadro é alocado e o estado da memória física não é alterado.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param n Número de quadros a alocar.
+ * @param quadros Vetor de saída com pelo menos n posições, preenchido com os índices alocados.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int alocar_quadros(MemoriaFisica *mf, int n, int *quadros);
+
+/**
+ * @brief Seleciona a política de alocação de quadros.
+ * 
+ * As listas do buddy são reconstruídas a partir dos quadros livres atuais,
+ * portanto a troca pode ser feita com processos em memória. Os contadores
+ * de alocação são zerados para permitir comparar as políticas.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param politica A política desejada.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int definir_politica_alocacao(MemoriaFisica *mf, PoliticaAlocacao politica);
+
+/**
+ * @brief Ativa a alocação concorrente, em que várias threads alocam e liberam quadros ao mesmo tempo.
+ * 
+ * Cada CPU (uma thread de trabalho, registrada com definir_cpu_atual) tem um
+ * cache de até CACHE_QUADROS_CAPACIDADE quadros, reabastecido e esvaziado em
+ * lotes de CACHE_QUADROS_LOTE; o mapa de bits global é atualizado com
+ * compare-and-swap e o contador de quadros livres com somas atômicas. Os
+ * quadros guardados nos caches contam como ocupados no mapa, portanto uma
+ * alocação pode falhar com até num_cpus * CACHE_QUADROS_CAPACIDADE quadros
+ * ainda retidos nos caches das outras CPUs. Só a política primeiro livre é
+ * suportada, pois as listas do buddy são globais.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param num_cpus Número de CPUs (caches de quadros).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int ativar_alocacao_concorrente(MemoriaFisica *mf, int num_cpus);
+
+/**
+ * @brief Desativa a alocação concorrente, devolvendo os quadros dos caches ao
+ * mapa de bits e somando os contadores de cada CPU aos globais.
+ * 
+ * Deve ser chamada depois que todas as threads de trabalho terminaram.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ */
+void desativar_alocacao_concorrente(MemoriaFisica *mf);
+
+/**
+ * @brief Define a CPU simulada pela thread corrente, cujo cache de quadros ela passa a usar.
+ * 
+ * Cada CPU deve ser usada por uma única thread. Threads sem CPU (-1, o padrão)
+ * alocam e liberam diretamente no mapa de bits global.
+ * 
+ * @param cpu Número da CPU, de 0 a num_cpus - 1, ou -1 para nenhuma.
+ */
+void definir_cpu_atual(int cpu);
+
+/**
+ * @brief Retorna o nome legível de uma política de alocação.
+ * 
+ * @param politica A política de alocação.
+ * @return Nome da política.
+ */
+const char* nome_politica_alocacao(PoliticaAlocacao politica);
+
 /**
  * @brief Libera um quadro previamente alocado na memória física.
  * 
+ * Em um quadro compartilhado, só um dos mapeamentos é retirado; o quadro
+ * volta ao mapa de livres quando o último deles for liberado.
+ * 
  * @param mf Ponteiro para a estrutura da Memória Física.
  * @param quadro_index O índice do quadro a ser liberado.
+ * @return 1 se o quadro voltou ao mapa de livres, 0 se ainda tem mapeamentos ou em caso de erro.
+ */
+int liberar_quadro(MemoriaFisica *mf, int quadro_index);
+
+/**
+ * @brief Acrescenta um mapeamento a um quadro ocupado, que passa a ser compartilhado.
+ * 
+ * Os contadores são atualizados com operações atômicas, pois no modo
+ * concorrente processos diferentes liberam o mesmo quadro.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param quadro_index O índice do quadro.
+ * @return 1 se sucesso, 0 se o quadro for inválido ou estiver livre.
+ */
+int compartilhar_quadro(MemoriaFisica *mf, int quadro_index);
+
+/**
+ * @brief Retorna quantos mapeamentos um quadro tem.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param quadro_index O índice do quadro.
+ * @return 0 se o quadro está livre (ou é inválido), 1 se é privado, mais de 1 se é compartilhado.
+ */
+int referencias_quadro(MemoriaFisica *mf, int quadro_index);
+
+/**
+ * @brief Move o conteúdo e os mapeamentos de um quadro ocupado para um quadro livre.
+ * 
+ * O destino passa a ocupado, com os compartilhamentos da origem, e a origem
+ * volta ao mapa de livres. As entradas das tabelas de páginas que apontam para
+ * a origem devem ser atualizadas por quem chama (veja realocar_quadro).
+ * Não é suportada no modo concorrente.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param origem Quadro ocupado.
+ * @param destino Quadro livre.
+ * @return 1 se sucesso, 0 se a origem estiver livre ou o destino ocupado.
  */
-void liberar_quadro(MemoriaFisica *mf, int quadro_index);
+int migrar_quadro(MemoriaFisica *mf, int origem, int destino);
+
+/**
+ * @brief Verifica se um quadro está livre consultando o mapa de bits.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param quadro_index O índice do quadro.
+ * @return 1 se o quadro está livre, 0 se está ocupado ou o índice é inválido.
+ */
+int quadro_esta_livre(MemoriaFisica *mf, int quadro_index);
 
 /**
  * @brief Escreve dados em um endereço físico específico.
@@ -61,7 +252,7 @@ void liberar_quadro(MemoriaFisica *mf, int quadro_index);
  * @param endereco_fisico O endereço físico onde escrever.
  * @param valor O byte a ser escrito.
  */
-void escrever_na_memoria(MemoriaFisica *mf, int endereco_fisico, unsigned char valor);
+void escrever_na_memoria(MemoriaFisica *mf, size_t endereco_fisico, unsigned char valor);
 
 /**
  * @brief Lê um byte de um endereço físico específico.
@@ -70,7 +261,49 @@ void escrever_na_memoria(MemoriaFisica *mf, int endereco_fisico, unsigned char v
  * @param endereco_fisico O endereço físico de onde ler.
  * @return O byte lido do endereço.
  */
-unsigned char ler_da_memoria(MemoriaFisica *mf, int endereco_fisico);
+unsigned char ler_da_memoria(MemoriaFisica *mf, size_t endereco_fisico);
+
+/**
+ * @brief Mede a fragmentação dos quadros livres.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param maior_bloco_livre Saída: tamanho, em quadros, da maior sequência contígua de quadros livres.
+ * @param num_blocos_livres Saída: número de sequências contíguas de quadros livres.
+ */
+void calcular_fragmentacao(MemoriaFisica *mf, int *maior_bloco_livre, int *num_blocos_livres);
+
+/**
+ * @brief Exibe a política de alocação, as métricas de fragmentação e a latência das alocações.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ */
+void exibir_estatisticas_alocacao(MemoriaFisica *mf);
+
+/**
+ * @brief Copia dados para a memória física a partir do início de um quadro.
+ * 
+ * O intervalo é validado uma única vez e copiado com memcpy. Quando os
+ * quadros seguintes são fisicamente adjacentes, bytes pode ultrapassar o
+ * tamanho de uma página para copiar a sequência inteira de uma vez.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param quadro_index Índice do primeiro quadro de destino.
+ * @param origem Dados a serem escritos.
+ * @param bytes Número de bytes a copiar.
+ * @return 1 se sucesso, 0 se o intervalo for inválido.
+ */
+int escrever_pagina(MemoriaFisica *mf, int quadro_index, const unsigned char *origem, size_t bytes);
+
+/**
+ * @brief Copia dados da memória física a partir do início de um quadro.
+ * 
+ * @param mf Ponteiro para a estrutura da Memória Física.
+ * @param quadro_index Índice do primeiro quadro de origem.
+ * @param destino Buffer que recebe os dados.
+ * @param bytes Número de bytes a copiar (pode abranger quadros adjacentes).
+ * @return 1 se sucesso, 0 se o intervalo for inválido.
+ */
+int ler_pagina(MemoriaFisica *mf, int quadro_index, unsigned char *destino, size_t bytes);
 
 /**
  * @brief Exibe informações sobre o estado atual da memória física.
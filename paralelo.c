@@ -0,0 +1,127 @@
+#include "paralelo.h"
+#include "erros.h"
+
+// Processa blocos da tarefa atual até que não reste nenhum
+static void processar_blocos(PoolThreads *pool) {
+    size_t inicio;
+    while ((inicio = __atomic_fetch_add(&pool->proximo, pool->tamanho_bloco, __ATOMIC_RELAXED)) < pool->total) {
+        size_t fim = pool->total - inicio < pool->tamanho_bloco ? pool->total : inicio + pool->tamanho_bloco;
+        pool->tarefa(pool->contexto, inicio, fim);
+    }
+}
+
+// Laço das threads auxiliares: espera uma tarefa nova, trabalha nela e avisa ao terminar
+static void* executar_auxiliar(void *argumento) {
+    PoolThreads *pool = (PoolThreads*)argumento;
+    long long geracao_vista = 0;
+
+    pthread_mutex_lock(&pool->trava);
+    while (1) {
+        while (!pool->encerrar && pool->geracao == geracao_vista) {
+            pthread_cond_wait(&pool->nova_tarefa, &pool->trava);
+        }
+        if (pool->encerrar) {
+            break;
+        }
+        geracao_vista = pool->geracao;
+        pthread_mutex_unlock(&pool->trava);
+
+        processar_blocos(pool);
+
+        pthread_mutex_lock(&pool->trava);
+        if (--pool->ocupadas == 0) {
+            pthread_cond_signal(&pool->tarefa_concluida);
+        }
+    }
+    pthread_mutex_unlock(&pool->trava);
+    return NULL;
+}
+
+PoolThreads* criar_pool_threads(int num_threads) {
+    if (num_threads < 1) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Numero de threads invalido (%d).\n", num_threads);
+        return NULL;
+    }
+
+    PoolThreads *pool = (PoolThreads*)calloc(1, sizeof(PoolThreads));
+    if (!pool) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o pool de threads.\n");
+        return NULL;
+    }
+    pool->threads = (pthread_t*)malloc((num_threads - 1 > 0 ? num_threads - 1 : 1) * sizeof(pthread_t));
+    if (!pool->threads) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o pool de threads.\n");
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->trava, NULL);
+    pthread_cond_init(&pool->nova_tarefa, NULL);
+    pthread_cond_init(&pool->tarefa_concluida, NULL);
+    pthread_mutex_init(&pool->trava_uso, NULL);
+
+    // Se alguma auxiliar não puder ser criada, o pool fica com as que já existem
+    for (int i = 0; i < num_threads - 1; i++) {
+        if (pthread_create(&pool->threads[i], NULL, executar_auxiliar, pool) != 0) {
+            REGISTRAR_AVISO("Pool criado com %d threads auxiliares em vez de %d.\n", i, num_threads - 1);
+            break;
+        }
+        pool->num_threads++;
+    }
+
+    REGISTRAR_DEPURACAO("Pool de threads criado com %d threads.\n", pool->num_threads + 1);
+    return pool;
+}
+
+void destruir_pool_threads(PoolThreads *pool) {
+    if (!pool) {
+        return;
+    }
+    pthread_mutex_lock(&pool->trava);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->nova_tarefa);
+    pthread_mutex_unlock(&pool->trava);
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->trava);
+    pthread_cond_destroy(&pool->nova_tarefa);
+    pthread_cond_destroy(&pool->tarefa_concluida);
+    pthread_mutex_destroy(&pool->trava_uso);
+    free(pool->threads);
+    free(pool);
+}
+
+void executar_em_paralelo(PoolThreads *pool, size_t total, size_t tamanho_bloco, TarefaIntervalo tarefa, void *contexto) {
+    if (tamanho_bloco == 0) {
+        tamanho_bloco = 1;
+    }
+    // Sem auxiliares ou com o pool ocupado por outra thread, não há com quem dividir
+    if (!pool || pool->num_threads == 0 || total <= tamanho_bloco || pthread_mutex_trylock(&pool->trava_uso) != 0) {
+        if (total > 0) {
+            tarefa(contexto, 0, total);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->trava);
+    pool->tarefa = tarefa;
+    pool->contexto = contexto;
+    pool->total = total;
+    pool->tamanho_bloco = tamanho_bloco;
+    pool->proximo = 0;
+    pool->ocupadas = pool->num_threads;
+    pool->geracao++;
+    pthread_cond_broadcast(&pool->nova_tarefa);
+    pthread_mutex_unlock(&pool->trava);
+
+    processar_blocos(pool);
+
+    // Os blocos já foram todos distribuídos; espera as auxiliares terminarem os seus
+    pthread_mutex_lock(&pool->trava);
+    while (pool->ocupadas > 0) {
+        pthread_cond_wait(&pool->tarefa_concluida, &pool->trava);
+    }
+    pthread_mutex_unlock(&pool->trava);
+    pthread_mutex_unlock(&pool->trava_uso);
+}
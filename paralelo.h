@@ -0,0 +1,62 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+// Trabalho aplicado a um intervalo [inicio, fim) de itens (ex.: páginas de um processo)
+typedef void (*TarefaIntervalo)(void *contexto, size_t inicio, size_t fim);
+
+// Pool de threads que divide um intervalo de itens em blocos. As threads
+// auxiliares ficam dormindo entre as tarefas; a thread que chama também trabalha.
+typedef struct {
+    pthread_t *threads;               // Threads auxiliares
+    int num_threads;                  // Número de threads auxiliares (total - 1)
+    pthread_mutex_t trava;            // Protege o estado da tarefa atual
+    pthread_cond_t nova_tarefa;       // Acorda as auxiliares quando há uma tarefa
+    pthread_cond_t tarefa_concluida;  // Avisa a thread que chamou que as auxiliares terminaram
+    pthread_mutex_t trava_uso;        // Uma tarefa por vez no pool
+    TarefaIntervalo tarefa;           // Tarefa atual
+    void *contexto;                   // Argumento da tarefa atual
+    size_t total;                     // Itens da tarefa atual
+    size_t tamanho_bloco;             // Itens entregues a uma thread de cada vez
+    size_t proximo;                   // Início do próximo bloco a distribuir (atômico)
+    long long geracao;                // Número da tarefa atual (muda a cada tarefa)
+    int ocupadas;                     // Auxiliares que ainda não terminaram a tarefa atual
+    int encerrar;                     // 1 quando o pool está sendo destruído
+} PoolThreads;
+
+/**
+ * @brief Cria um pool de threads.
+ *
+ * @param num_threads Número total de threads que trabalham em cada tarefa,
+ * contando a que chama executar_em_paralelo (são criadas num_threads - 1 auxiliares).
+ * @return Ponteiro para o pool, ou NULL em caso de erro.
+ */
+PoolThreads* criar_pool_threads(int num_threads);
+
+/**
+ * @brief Encerra as threads auxiliares e libera o pool.
+ *
+ * @param pool Ponteiro para o pool (pode ser NULL).
+ */
+void destruir_pool_threads(PoolThreads *pool);
+
+/**
+ * @brief Executa uma tarefa sobre os itens [0, total), em blocos de tamanho_bloco
+ * itens distribuídos às threads do pool conforme elas ficam livres.
+ *
+ * Retorna só depois que todos os blocos foram processados. Sem pool, com um
+ * único bloco ou com o pool ocupado por outra tarefa, a tarefa é executada
+ * inteira na thread que chama.
+ *
+ * @param pool Ponteiro para o pool (pode ser NULL).
+ * @param total Número de itens.
+ * @param tamanho_bloco Itens por bloco (no mínimo 1).
+ * @param tarefa Função chamada para cada bloco; deve aceitar chamadas simultâneas.
+ * @param contexto Argumento repassado à tarefa.
+ */
+void executar_em_paralelo(PoolThreads *pool, size_t total, size_t tamanho_bloco, TarefaIntervalo tarefa, void *contexto);
+
+#endif // PARALELO_H
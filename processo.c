@@ -1,265 +1,1839 @@
 #include "processo.h"
+#include "substituicao.h"
+#include "conjunto_trabalho.h"
+#include "compactacao.h"
+#include "deduplicacao.h"
+#include "cache_comprimido.h"
 #include <string.h>
+#include <limits.h>
 
 void inicializar_gerenciador_processos(GerenciadorProcessos *gp) {
     gp->num_processos = 0;
     gp->proximo_id = 1;
+    gp->semente = SEMENTE_PADRAO;
+    gp->percentual_imagem_comum = 0;
+    gp->percentual_entropia = 100;
+    gp->paginacao_sob_demanda = 0;
+    gp->imagens_sem_copia = 0;
+    gp->total_faltas_pagina = 0;
+    gp->total_forks = 0;
+    gp->total_copias_na_escrita = 0;
+    gp->substituicao = NULL;
+    gp->tlb = NULL;
+    gp->tipo_tabela = TABELA_LINEAR;
+    gp->tabela_invertida = NULL;
+    memset(&gp->estatisticas, 0, sizeof(gp->estatisticas));
+    gp->concorrente = 0;
+    pthread_rwlock_init(&gp->trava_tabela, NULL);
+    pthread_mutex_init(&gp->trava_substituicao, NULL);
+    gp->pool_carga = NULL;
+    gp->swap = NULL;
+    gp->conjunto_trabalho = NULL;
+    gp->compactacao = NULL;
+    gp->deduplicacao = NULL;
+    gp->cache_comprimido = NULL;
     
-    // Inicializa todos os processos como inativos
-    for (int i = 0; i < MAX_PROCESSOS; i++) {
-        gp->processos[i].ativo = 0;
-        gp->processos[i].id = 0;
-        gp->processos[i].tamanho = 0;
-        gp->processos[i].num_paginas = 0;
-        gp->processos[i].tabela_paginas = NULL;
+    // A tabela de processos e o índice são alocados na primeira criação
+    gp->blocos_processos = NULL;
+    gp->capacidade_blocos = 0;
+    gp->capacidade_processos = 0;
+    gp->slots_livres = NULL;
+    gp->num_slots_livres = 0;
+    gp->indice = NULL;
+    gp->capacidade_indice = 0;
+    gp->ocupacao_indice = 0;
+    
+    REGISTRAR_INFO("Gerenciador de processos inicializado.\n");
+}
+
+void finalizar_gerenciador_processos(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    desativar_modo_concorrente(gp, mf);
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo->ativo) {
+            remover_processo(gp, mf, processo->id);
+        }
+    }
+    for (int b = 0; b < gp->capacidade_processos / PROCESSOS_POR_BLOCO; b++) {
+        for (int i = 0; i < PROCESSOS_POR_BLOCO; i++) {
+            pthread_mutex_destroy(&gp->blocos_processos[b][i].trava);
+        }
+        free(gp->blocos_processos[b]);
+    }
+    free(gp->blocos_processos);
+    gp->blocos_processos = NULL;
+    gp->capacidade_blocos = 0;
+    gp->capacidade_processos = 0;
+    free(gp->slots_livres);
+    gp->slots_livres = NULL;
+    gp->num_slots_livres = 0;
+    free(gp->indice);
+    gp->indice = NULL;
+    gp->capacidade_indice = 0;
+    gp->ocupacao_indice = 0;
+    destruir_substituidor(gp->substituicao);
+    gp->substituicao = NULL;
+    destruir_tlb(gp->tlb);
+    gp->tlb = NULL;
+    destruir_tabela_invertida(gp->tabela_invertida);
+    gp->tabela_invertida = NULL;
+    destruir_pool_threads(gp->pool_carga);
+    gp->pool_carga = NULL;
+    destruir_swap(gp->swap);
+    gp->swap = NULL;
+    destruir_rastreador_trabalho(gp->conjunto_trabalho);
+    gp->conjunto_trabalho = NULL;
+    destruir_compactador(gp->compactacao);
+    gp->compactacao = NULL;
+    destruir_deduplicador(gp->deduplicacao);
+    gp->deduplicacao = NULL;
+    destruir_cache_comprimido(gp->cache_comprimido, mf);
+    gp->cache_comprimido = NULL;
+    pthread_rwlock_destroy(&gp->trava_tabela);
+    pthread_mutex_destroy(&gp->trava_substituicao);
+}
+
+// Travas do modo concorrente; fora dele as operações não fazem nada
+static void travar_tabela_leitura(GerenciadorProcessos *gp) {
+    if (gp->concorrente) {
+        pthread_rwlock_rdlock(&gp->trava_tabela);
+    }
+}
+
+static void travar_tabela_escrita(GerenciadorProcessos *gp) {
+    if (gp->concorrente) {
+        pthread_rwlock_wrlock(&gp->trava_tabela);
+    }
+}
+
+static void destravar_tabela(GerenciadorProcessos *gp) {
+    if (gp->concorrente) {
+        pthread_rwlock_unlock(&gp->trava_tabela);
+    }
+}
+
+static void travar_substituicao(GerenciadorProcessos *gp) {
+    if (gp->concorrente) {
+        pthread_mutex_lock(&gp->trava_substituicao);
+    }
+}
+
+static void destravar_substituicao(GerenciadorProcessos *gp) {
+    if (gp->concorrente) {
+        pthread_mutex_unlock(&gp->trava_substituicao);
+    }
+}
+
+// Acumula um contador compartilhado do gerenciador (atômico no modo concorrente)
+static void somar_contador(GerenciadorProcessos *gp, long long *contador, long long valor) {
+    if (gp->concorrente) {
+        __atomic_fetch_add(contador, valor, __ATOMIC_RELAXED);
+    } else {
+        *contador += valor;
+    }
+}
+
+Processo* processo_no_slot(GerenciadorProcessos *gp, int slot) {
+    return &gp->blocos_processos[slot / PROCESSOS_POR_BLOCO][slot % PROCESSOS_POR_BLOCO];
+}
+
+// Posição inicial de um PID no índice
+static int posicao_indice(GerenciadorProcessos *gp, int pid) {
+    return (int)(((uint32_t)pid * 0x9E3779B1u) & (uint32_t)(gp->capacidade_indice - 1));
+}
+
+// Insere PID -> slot no índice, sem verificar duplicatas
+static void indice_inserir(GerenciadorProcessos *gp, int pid, int slot) {
+    int mascara = gp->capacidade_indice - 1;
+    int i = posicao_indice(gp, pid);
+    while (gp->indice[i].slot != -1) {
+        i = (i + 1) & mascara;
+    }
+    gp->indice[i].pid = pid;
+    gp->indice[i].slot = slot;
+}
+
+// Dobra o índice, reinserindo as entradas. Retorna 0 se faltar memória.
+static int indice_crescer(GerenciadorProcessos *gp) {
+    int nova_capacidade = gp->capacidade_indice ? gp->capacidade_indice * 2 : CAPACIDADE_INICIAL_INDICE;
+    EntradaIndiceProcesso *novo = (EntradaIndiceProcesso*)malloc(nova_capacidade * sizeof(EntradaIndiceProcesso));
+    if (!novo) {
+        return 0;
+    }
+    for (int i = 0; i < nova_capacidade; i++) {
+        novo[i].slot = -1;
+    }
+    
+    EntradaIndiceProcesso *antigo = gp->indice;
+    int capacidade_antiga = gp->capacidade_indice;
+    gp->indice = novo;
+    gp->capacidade_indice = nova_capacidade;
+    for (int i = 0; i < capacidade_antiga; i++) {
+        if (antigo[i].slot != -1) {
+            indice_inserir(gp, antigo[i].pid, antigo[i].slot);
+        }
+    }
+    free(antigo);
+    return 1;
+}
+
+// Remove um PID do índice, recuando as entradas seguintes da sequência de
+// sondagem para que nenhuma busca seja interrompida por uma posição vazia
+static void indice_remover(GerenciadorProcessos *gp, int pid) {
+    int mascara = gp->capacidade_indice - 1;
+    int i = posicao_indice(gp, pid);
+    while (gp->indice[i].slot != -1 && gp->indice[i].pid != pid) {
+        i = (i + 1) & mascara;
+    }
+    if (gp->indice[i].slot == -1) {
+        return;
+    }
+    
+    int j = i;
+    while (1) {
+        j = (j + 1) & mascara;
+        if (gp->indice[j].slot == -1) {
+            break;
+        }
+        // A entrada em j pode ocupar a lacuna em i se sua posição inicial não
+        // estiver, circularmente, no intervalo (i, j]
+        int inicio = posicao_indice(gp, gp->indice[j].pid);
+        int entre = i <= j ? (inicio > i && inicio <= j) : (inicio > i || inicio <= j);
+        if (!entre) {
+            gp->indice[i] = gp->indice[j];
+            i = j;
+        }
+    }
+    gp->indice[i].slot = -1;
+}
+
+// Retira um slot da pilha de livres, acrescentando um bloco à tabela de
+// processos se ela estiver cheia. Os blocos existentes não mudam de lugar, então
+// os ponteiros para processos continuam válidos. Retorna -1 se faltar memória.
+static int reservar_slot_processo(GerenciadorProcessos *gp) {
+    if (gp->num_slots_livres == 0) {
+        int num_blocos = gp->capacidade_processos / PROCESSOS_POR_BLOCO;
+        if (num_blocos == gp->capacidade_blocos) {
+            int nova_capacidade = gp->capacidade_blocos ? gp->capacidade_blocos * 2 : 1;
+            Processo **blocos = (Processo**)realloc(gp->blocos_processos, nova_capacidade * sizeof(Processo*));
+            if (!blocos) {
+                return -1;
+            }
+            gp->blocos_processos = blocos;
+            gp->capacidade_blocos = nova_capacidade;
+        }
+        int nova_capacidade = gp->capacidade_processos + PROCESSOS_POR_BLOCO;
+        int *livres = (int*)realloc(gp->slots_livres, nova_capacidade * sizeof(int));
+        if (!livres) {
+            return -1;
+        }
+        gp->slots_livres = livres;
+        Processo *bloco = (Processo*)calloc(PROCESSOS_POR_BLOCO, sizeof(Processo));
+        if (!bloco) {
+            return -1;
+        }
+        for (int i = 0; i < PROCESSOS_POR_BLOCO; i++) {
+            bloco[i].slot = gp->capacidade_processos + i;
+            pthread_mutex_init(&bloco[i].trava, NULL);
+        }
+        gp->blocos_processos[num_blocos] = bloco;
+        
+        // Os novos slots são empilhados do último para o primeiro, para serem usados em ordem
+        for (int i = nova_capacidade - 1; i >= gp->capacidade_processos; i--) {
+            gp->slots_livres[gp->num_slots_livres++] = i;
+        }
+        gp->capacidade_processos = nova_capacidade;
+    }
+    return gp->slots_livres[--gp->num_slots_livres];
+}
+
+// Devolve ao swap os slots das páginas de um processo que está sendo liberado
+static void liberar_slots_swap(GerenciadorProcessos *gp, Processo *processo) {
+    for (int i = 0; processo->slots_swap && i < processo->num_paginas; i++) {
+        if (processo->slots_swap[i] != -1 && gp->swap) {
+            swap_liberar_slot(gp->swap, processo->slots_swap[i]);
+        }
+    }
+}
+
+// Devolve ao cache comprimido os objetos das páginas de um processo que está sendo liberado
+static void liberar_objetos_comprimidos(GerenciadorProcessos *gp, Processo *processo) {
+    for (int i = 0; processo->objetos_comprimidos && i < processo->num_paginas; i++) {
+        if (processo->objetos_comprimidos[i] != -1 && gp->cache_comprimido) {
+            cache_comprimido_liberar(gp->cache_comprimido, processo->objetos_comprimidos[i]);
+        }
+    }
+}
+
+// Tira um processo inativo do índice e devolve seu slot à pilha de livres
+static void devolver_slot_processo(GerenciadorProcessos *gp, Processo *processo) {
+    travar_tabela_escrita(gp);
+    indice_remover(gp, processo->id);
+    gp->ocupacao_indice--;
+    gp->slots_livres[gp->num_slots_livres++] = processo->slot;
+    destravar_tabela(gp);
+}
+
+// Desfaz uma criação que falhou: libera a memória do processo, tira-o do índice e devolve o slot
+static void descartar_processo(GerenciadorProcessos *gp, Processo *processo) {
+    liberar_slots_swap(gp, processo);
+    liberar_objetos_comprimidos(gp, processo);
+    liberar_processo(processo);
+    devolver_slot_processo(gp, processo);
+}
+
+// Processo com o ID no índice, ou NULL; o chamador cuida da trava da tabela
+static Processo* procurar_processo(GerenciadorProcessos *gp, int id_processo) {
+    if (gp->capacidade_indice == 0) {
+        return NULL;
+    }
+    int mascara = gp->capacidade_indice - 1;
+    for (int i = posicao_indice(gp, id_processo); gp->indice[i].slot != -1; i = (i + 1) & mascara) {
+        if (gp->indice[i].pid == id_processo) {
+            return processo_no_slot(gp, gp->indice[i].slot);
+        }
+    }
+    return NULL;
+}
+
+// Reserva o ID e um slot para um novo processo, que fica no índice mas inativo
+// até ser publicado. Retorna NULL se o ID já existir ou faltar memória.
+static Processo* reservar_processo(GerenciadorProcessos *gp, int id_processo) {
+    if (procurar_processo(gp, id_processo)) {
+        RELATAR_ERRO(ERRO_PROCESSO_EXISTENTE, "Processo com ID %d ja existe.\n", id_processo);
+        return NULL;
+    }
+    
+    // Mantém a carga do índice em no máximo 1/2 antes de inserir
+    if (2 * (gp->ocupacao_indice + 1) > gp->capacidade_indice && !indice_crescer(gp)) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao ampliar o indice de processos.\n");
+        return NULL;
+    }
+    
+    // Obtém um slot livre para o processo
+    int slot_livre = reservar_slot_processo(gp);
+    if (slot_livre == -1) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Nao foi possivel encontrar um slot livre para o processo.\n");
+        return NULL;
+    }
+    
+    Processo *processo = processo_no_slot(gp, slot_livre);
+    indice_inserir(gp, id_processo, slot_livre);
+    gp->ocupacao_indice++;
+    processo->id = id_processo;
+    return processo;
+}
+
+// Torna um processo recém-criado visível às operações das outras threads
+static void publicar_processo(GerenciadorProcessos *gp, Processo *processo) {
+    if (gp->concorrente) {
+        pthread_mutex_lock(&processo->trava);
+        processo->ativo = 1;
+        pthread_mutex_unlock(&processo->trava);
+        __atomic_fetch_add(&gp->num_processos, 1, __ATOMIC_RELAXED);
+    } else {
+        processo->ativo = 1;
+        gp->num_processos++;
+    }
+}
+
+// Encontra um processo e, no modo concorrente, toma sua trava. Como os slots
+// nunca são liberados, a trava pode ser tomada depois da busca; o processo é
+// revalidado em seguida, pois pode ter sido removido (e o slot reutilizado)
+// nesse intervalo. Retorna NULL se o processo não existir.
+static Processo* adquirir_processo(GerenciadorProcessos *gp, int id_processo) {
+    Processo *processo = encontrar_processo(gp, id_processo);
+    if (!processo || !gp->concorrente) {
+        return processo;
+    }
+    pthread_mutex_lock(&processo->trava);
+    if (!processo->ativo || processo->id != id_processo) {
+        pthread_mutex_unlock(&processo->trava);
+        return NULL;
+    }
+    return processo;
+}
+
+static void soltar_processo(GerenciadorProcessos *gp, Processo *processo) {
+    if (gp->concorrente) {
+        pthread_mutex_unlock(&processo->trava);
+    }
+}
+
+Substituidor* obter_substituidor(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (!gp->substituicao) {
+        gp->substituicao = criar_substituidor(mf->numero_quadros);
+    }
+    return gp->substituicao;
+}
+
+int ativar_modo_concorrente(GerenciadorProcessos *gp, MemoriaFisica *mf, int num_cpus) {
+    // O substituidor é criado aqui, pois a criação preguiçosa não é segura entre threads
+    Substituidor *s = obter_substituidor(gp, mf);
+    if (!s) {
+        return 0;
+    }
+    if (s->politica != SUBSTITUICAO_NENHUMA || gp->tlb || gp->conjunto_trabalho || gp->compactacao ||
+        gp->deduplicacao || gp->cache_comprimido || gp->tabela_invertida || gp->tipo_tabela == TABELA_INVERTIDA) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O modo concorrente exige substituicao, TLB, conjunto de trabalho, "
+                     "compactacao, deduplicacao e cache comprimido desativados e tabelas de paginas por processo.\n");
+        return 0;
+    }
+    if (mf->quadros_compartilhados > 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O modo concorrente exige que nenhum quadro esteja compartilhado "
+                     "(%d compartilhados por fork ou deduplicacao).\n", mf->quadros_compartilhados);
+        return 0;
+    }
+    if (!ativar_alocacao_concorrente(mf, num_cpus)) {
+        return 0;
+    }
+    gp->concorrente = 1;
+    REGISTRAR_INFO("Modo concorrente ativado (%d CPUs).\n", num_cpus);
+    return 1;
+}
+
+void desativar_modo_concorrente(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (!gp->concorrente) {
+        return;
+    }
+    gp->concorrente = 0;
+    desativar_alocacao_concorrente(mf);
+    REGISTRAR_INFO("Modo concorrente desativado.\n");
+}
+
+// Deslocamento lógico do início de uma página
+static size_t inicio_da_pagina(MemoriaFisica *mf, int pagina) {
+    return (size_t)pagina * mf->tamanho_pagina;
+}
+
+// Bytes ocupados por num_paginas páginas a partir de pagina; a última página
+// do processo pode ocupar só parte do quadro
+static size_t bytes_das_paginas(MemoriaFisica *mf, Processo *processo, int pagina, int num_paginas) {
+    size_t inicio = inicio_da_pagina(mf, pagina);
+    size_t bytes = (size_t)num_paginas * mf->tamanho_pagina;
+    if (inicio >= processo->tamanho) {
+        return 0;
+    }
+    return bytes < processo->tamanho - inicio ? bytes : processo->tamanho - inicio;
+}
+
+// Retorna onde fica a cópia de uma página fora da memória física: na memória
+// lógica do processo ou, nas imagens sem cópia, em um buffer próprio da página.
+// Com criar = 1 o buffer é reservado se ainda não existir; retorna NULL se não
+// houver cópia ou faltar memória.
+static unsigned char* copia_da_pagina(MemoriaFisica *mf, Processo *processo, int pagina, int criar) {
+    if (processo->memoria_logica) {
+        return processo->memoria_logica + inicio_da_pagina(mf, pagina);
+    }
+    
+    if (!processo->paginas_salvas) {
+        if (!criar) {
+            return NULL;
+        }
+        processo->paginas_salvas = (unsigned char**)calloc(processo->num_paginas, sizeof(unsigned char*));
+        if (!processo->paginas_salvas) {
+            return NULL;
+        }
+    }
+    if (!processo->paginas_salvas[pagina] && criar) {
+        processo->paginas_salvas[pagina] = (unsigned char*)malloc(mf->tamanho_pagina);
+    }
+    return processo->paginas_salvas[pagina];
+}
+
+// Slot de swap de uma página, ou -1 se ela não está no swap
+static int slot_swap_da_pagina(Processo *processo, int pagina) {
+    return processo->slots_swap ? processo->slots_swap[pagina] : -1;
+}
+
+// Reserva um slot de swap para uma página e enfileira a gravação do conteúdo,
+// devolvendo o slot com a versão anterior da página, se houver. O vetor de
+// slots do processo é criado no primeiro uso. Retorna 0 se o swap estiver
+// cheio ou faltar memória.
+static int gravar_no_swap(GerenciadorProcessos *gp, Processo *processo, int pagina, const unsigned char *dados) {
+    if (processo->slots_swap && processo->slots_swap[pagina] != -1) {
+        swap_liberar_slot(gp->swap, processo->slots_swap[pagina]);
+        processo->slots_swap[pagina] = -1;
+    }
+    if (!processo->slots_swap) {
+        processo->slots_swap = (int*)malloc(processo->num_paginas * sizeof(int));
+        if (!processo->slots_swap) {
+            return 0;
+        }
+        for (int i = 0; i < processo->num_paginas; i++) {
+            processo->slots_swap[i] = -1;
+        }
+    }
+    int slot = swap_gravar_pagina(gp->swap, dados);
+    if (slot == -1) {
+        return 0;
+    }
+    processo->slots_swap[pagina] = slot;
+    return 1;
+}
+
+// Objeto do cache comprimido de uma página, ou -1 se ela não está no cache
+static int objeto_comprimido_da_pagina(Processo *processo, int pagina) {
+    return processo->objetos_comprimidos ? processo->objetos_comprimidos[pagina] : -1;
+}
+
+// Devolve ao cache comprimido o objeto de uma página, se houver
+static void liberar_objeto_comprimido(GerenciadorProcessos *gp, Processo *processo, int pagina) {
+    int objeto = objeto_comprimido_da_pagina(processo, pagina);
+    if (objeto != -1) {
+        cache_comprimido_liberar(gp->cache_comprimido, objeto);
+        processo->objetos_comprimidos[pagina] = -1;
+    }
+}
+
+// Comprime uma página no cache comprimido, devolvendo o objeto com a versão
+// anterior, se houver. O vetor de objetos do processo é criado no primeiro
+// uso. Retorna 0 se o cache recusar a página ou faltar memória.
+static int guardar_no_cache_comprimido(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo,
+                                       int pagina, const unsigned char *dados) {
+    liberar_objeto_comprimido(gp, processo, pagina);
+    if (!processo->objetos_comprimidos) {
+        processo->objetos_comprimidos = (int*)malloc(processo->num_paginas * sizeof(int));
+        if (!processo->objetos_comprimidos) {
+            return 0;
+        }
+        for (int i = 0; i < processo->num_paginas; i++) {
+            processo->objetos_comprimidos[i] = -1;
+        }
+    }
+    int objeto = cache_comprimido_guardar(gp->cache_comprimido, mf, dados);
+    if (objeto == -1) {
+        return 0;
+    }
+    processo->objetos_comprimidos[pagina] = objeto;
+    return 1;
+}
+
+// Grava uma página modificada que sai do quadro: no cache comprimido, se ele
+// a aceitar; no swap, se houver um com slot livre; ou na memória lógica (ou
+// no buffer da página). Retorna 0 se faltar memória para a cópia.
+static int guardar_pagina_modificada(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo,
+                                     int pagina, int quadro, EntradaTabelaPagina *entrada) {
+    const unsigned char *dados = mf->memoria + (size_t)quadro * mf->tamanho_pagina;
+    // O slot que a página mantinha desde a última carga do swap fica obsoleto
+    if (gp->cache_comprimido && guardar_no_cache_comprimido(gp, mf, processo, pagina, dados)) {
+        if (slot_swap_da_pagina(processo, pagina) != -1) {
+            swap_liberar_slot(gp->swap, processo->slots_swap[pagina]);
+            processo->slots_swap[pagina] = -1;
+        }
+        return 1;
+    }
+    
+    // Com o swap cheio, a página fica na memória do hospedeiro, como sem swap
+    if (gp->swap && gravar_no_swap(gp, processo, pagina, dados)) {
+        return 1;
+    }
+    
+    unsigned char *copia = copia_da_pagina(mf, processo, pagina, 1);
+    if (!copia) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao reservar copia da pagina %d do processo %d.\n", pagina, processo->id);
+        return 0;
+    }
+    ler_pagina(mf, quadro, copia, bytes_das_paginas(mf, processo, pagina, 1));
+    entrada_ativar(entrada, TP_EM_MEMORIA_LOGICA);
+    return 1;
+}
+
+// Outra página ativa que mapeia o quadro, fora a página excluída do processo
+// excluído, ou NULL; a página encontrada vai para *pagina_encontrada. O fork
+// preserva os números de página, então a mesma página dos outros processos é
+// conferida primeiro; a deduplicação mescla páginas de números quaisquer,
+// inclusive do mesmo processo, que só a busca em todas as páginas encontra. Só
+// é feito ao despejar, migrar, mesclar ou deixar de mapear um quadro compartilhado.
+static Processo* procurar_compartilhador(GerenciadorProcessos *gp, Processo *excluido, int pagina, int quadro,
+                                         int *pagina_encontrada) {
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo == excluido || !processo->ativo || pagina >= processo->num_paginas) {
+            continue;
+        }
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+        if (entrada && entrada_tem(*entrada, TP_PRESENTE) && entrada_quadro(*entrada) == quadro) {
+            *pagina_encontrada = pagina;
+            return processo;
+        }
+    }
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (!processo->ativo || processo->paginas_presentes == 0) {
+            continue;
+        }
+        for (int p = 0; p < processo->num_paginas; p++) {
+            EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, p);
+            if (entrada && entrada_tem(*entrada, TP_PRESENTE) && entrada_quadro(*entrada) == quadro &&
+                (processo != excluido || p != pagina)) {
+                *pagina_encontrada = p;
+                return processo;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Retira o mapeamento de uma página para o seu quadro. O quadro só volta à
+// memória livre sem nenhum outro mapeamento; se a página era a dona no mapa
+// reverso, a posse passa a outra página que ainda o compartilha.
+static void soltar_quadro_da_pagina(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, int pagina, int quadro) {
+    Substituidor *s = gp->substituicao;
+    if (referencias_quadro(mf, quadro) <= 1) {
+        // Último mapeamento: o mapa reverso é limpo antes de o quadro voltar à
+        // memória livre, pois no modo concorrente outra CPU pode alocá-lo e
+        // registrar o novo dono logo em seguida
+        if (s) {
+            substituicao_registrar_liberacao(s, quadro);
+        }
+        liberar_quadro(mf, quadro);
+        return;
+    }
+    liberar_quadro(mf, quadro);
+    if (s && s->dono_pid[quadro] == processo->id && s->dono_pagina[quadro] == pagina) {
+        int pagina_outro;
+        Processo *outro = procurar_compartilhador(gp, processo, pagina, quadro, &pagina_outro);
+        if (outro) {
+            substituicao_transferir_quadro(s, quadro, outro->id, pagina_outro);
+        }
+    }
+}
+
+// Tira uma página de um processo da memória física, gravando-a no cache comprimido, no swap ou na
+// memória lógica (ou no buffer da página) se estiver modificada. Retorna 0 se faltar memória para a cópia.
+static int desmapear_pagina(GerenciadorProcessos *gp, MemoriaFisica *mf, Substituidor *s, Processo *processo, int pagina) {
+    EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+    int quadro = entrada_quadro(*entrada);
+    
+    int modificada = entrada_tem(*entrada, TP_MODIFICADA);
+    if (modificada) {
+        if (!guardar_pagina_modificada(gp, mf, processo, pagina, quadro, entrada)) {
+            return 0;
+        }
+        s->writebacks++;
+    }
+    
+    REGISTRAR_DEPURACAO("Despejo: processo %d, pagina %d (quadro %d%s)\n",
+                        processo->id, pagina, quadro, modificada ? ", gravada" : "");
+    
+    entrada_definir_quadro(entrada, -1);
+    entrada_desativar(entrada, TP_PRESENTE | TP_MODIFICADA | TP_REFERENCIADA | TP_COPIA_NA_ESCRITA);
+    processo->paginas_presentes--;
+    if (gp->tlb) {
+        tlb_invalidar(gp->tlb, processo->id, pagina);
+    }
+    return 1;
+}
+
+// Despeja a página de um quadro ocupado. Um quadro compartilhado (por fork ou
+// deduplicação) é despejado de todas as páginas que o mapeiam. Retorna 1 se o quadro foi liberado.
+static int despejar_quadro(GerenciadorProcessos *gp, MemoriaFisica *mf, Substituidor *s, int quadro) {
+    Processo *dono = encontrar_processo(gp, s->dono_pid[quadro]);
+    int pagina = s->dono_pagina[quadro];
+    Processo *outro;
+    int pagina_outro;
+    while (referencias_quadro(mf, quadro) > 1 &&
+           (outro = procurar_compartilhador(gp, dono, pagina, quadro, &pagina_outro))) {
+        if (!desmapear_pagina(gp, mf, s, outro, pagina_outro)) {
+            return 0;
+        }
+        liberar_quadro(mf, quadro);
+    }
+    if (!desmapear_pagina(gp, mf, s, dono, pagina)) {
+        return 0;
+    }
+    substituicao_registrar_liberacao(s, quadro);
+    liberar_quadro(mf, quadro);
+    return 1;
+}
+
+// Despeja uma página escolhida pela política de substituição. Retorna 1 se um quadro foi liberado.
+static int despejar_pagina(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    Substituidor *s = obter_substituidor(gp, mf);
+    if (!s) {
+        return 0;
+    }
+    
+    int quadro = substituicao_escolher_vitima(s, gp);
+    if (quadro != -1 && despejar_quadro(gp, mf, s, quadro)) {
+        return 1;
+    }
+    substituicao_cancelar_despejo(s);
+    return 0;
+}
+
+// Obtém um quadro livre, despejando uma página se a memória estiver cheia
+// (no modo concorrente não há substituição e a alocação simplesmente falha)
+static int obter_quadro(GerenciadorProcessos *gp, MemoriaFisica *mf) {
+    if (!gp->concorrente && mf->quadros_livres == 0 && !despejar_pagina(gp, mf)) {
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Nao ha quadros livres e nenhuma pagina pode ser despejada.\n");
+        return -1;
+    }
+    return alocar_quadro(mf);
+}
+
+int calcular_num_paginas(size_t tamanho, int tamanho_pagina) {
+    size_t num_paginas = tamanho / tamanho_pagina;
+    if (tamanho % tamanho_pagina != 0) {
+        num_paginas++; // Arredonda para cima
+    }
+    return num_paginas > INT_MAX ? -1 : (int)num_paginas;
+}
+
+// Incremento do splitmix64 (parte fracionária da razão áurea)
+#define SPLITMIX_GAMMA 0x9E3779B97F4A7C15ULL
+
+// Função de mistura do splitmix64
+static uint64_t splitmix64_misturar(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void definir_semente_processos(GerenciadorProcessos *gp, uint64_t semente) {
+    gp->semente = semente;
+}
+
+int definir_entropia_imagens(GerenciadorProcessos *gp, int percentual) {
+    if (percentual < 0 || percentual > 100) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Percentual de entropia invalido (%d).\n", percentual);
+        return 0;
+    }
+    gp->percentual_entropia = percentual;
+    REGISTRAR_INFO("Entropia das imagens: %d%% das palavras de cada novo processo aleatorias.\n", percentual);
+    return 1;
+}
+
+int definir_imagem_comum(GerenciadorProcessos *gp, int percentual) {
+    if (percentual < 0 || percentual > 100) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Percentual de imagem comum invalido (%d).\n", percentual);
+        return 0;
+    }
+    gp->percentual_imagem_comum = percentual;
+    REGISTRAR_INFO("Imagem comum: %d%% do inicio de cada novo processo.\n", percentual);
+    return 1;
+}
+
+// Semente da palavra de uma imagem: a comum no início, a do processo no restante
+static inline uint64_t semente_da_palavra(Processo *processo, uint64_t palavra) {
+    return palavra * 8 < processo->bytes_comuns ? processo->semente_comum : processo->semente;
+}
+
+// Palavra de uma imagem: splitmix64(semente + (i + 1) * gamma) ou, fora do
+// percentual de entropia, zero. A escolha usa os 32 bits altos do próprio
+// valor (multiplicação e deslocamento em vez de módulo)
+static inline uint64_t palavra_da_imagem(Processo *processo, uint64_t palavra) {
+    uint64_t valor = splitmix64_misturar(semente_da_palavra(processo, palavra) + (palavra + 1) * SPLITMIX_GAMMA);
+    if (processo->percentual_entropia < 100 && ((valor >> 32) * 100 >> 32) >= (uint64_t)processo->percentual_entropia) {
+        return 0;
+    }
+    return valor;
+}
+
+void gerar_dados_aleatorios_intervalo(Processo *processo, unsigned char *destino, size_t deslocamento, size_t bytes) {
+    uint64_t palavra = (uint64_t)(deslocamento / 8);
+    size_t gerados = 0;
+    
+    // Bytes iniciais até alinhar o deslocamento com uma palavra
+    int inicio = (int)(deslocamento % 8);
+    if (inicio != 0) {
+        uint64_t valor = palavra_da_imagem(processo, palavra);
+        while (inicio < 8 && gerados < bytes) {
+            destino[gerados++] = (unsigned char)(valor >> (8 * inicio));
+            inicio++;
+        }
+        palavra++;
+    }
+    
+    // Palavras completas: 8 bytes por passo
+    while (bytes - gerados >= 8) {
+        uint64_t valor = palavra_da_imagem(processo, palavra);
+        memcpy(destino + gerados, &valor, sizeof(valor));
+        gerados += 8;
+        palavra++;
+    }
+    
+    // Bytes finais de uma palavra incompleta
+    if (gerados < bytes) {
+        uint64_t valor = palavra_da_imagem(processo, palavra);
+        for (int k = 0; gerados < bytes; k++) {
+            destino[gerados++] = (unsigned char)(valor >> (8 * k));
+        }
+    }
+}
+
+void gerar_dados_aleatorios_processo(Processo *processo) {
+    gerar_dados_aleatorios_intervalo(processo, processo->memoria_logica, 0, processo->tamanho);
+    
+    REGISTRAR_DEPURACAO("Dados aleatorios gerados para o processo %d (%zu bytes).\n", 
+                        processo->id, processo->tamanho);
+}
+
+// Mapeia todas as páginas de um processo em quadros recém-alocados
+static int alocar_quadros_do_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo) {
+    int id_processo = processo->id;
+    
+    REGISTRAR_DEPURACAO("Alocando %d quadros para o processo %d...\n", processo->num_paginas, id_processo);
+    
+    int *quadros = (int*)malloc(processo->num_paginas * sizeof(int));
+    if (!quadros) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar vetor de quadros para o processo %d.\n", id_processo);
+        return 0;
+    }
+    
+    // Com uma política de substituição ativa, despeja páginas até haver quadros suficientes
+    if (!gp->concorrente && processo->num_paginas <= mf->numero_quadros) {
+        while (mf->quadros_livres < processo->num_paginas && despejar_pagina(gp, mf)) {
+        }
+    }
+    
+    // Reserva todos os quadros de uma vez; em caso de falha nada foi alocado
+    if (!alocar_quadros(mf, processo->num_paginas, quadros)) {
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Nao ha quadros suficientes para alocar as %d paginas do processo %d.\n", 
+                     processo->num_paginas, id_processo);
+        free(quadros);
+        return 0;
+    }
+    
+    Substituidor *s = obter_substituidor(gp, mf);
+    for (int i = 0; i < processo->num_paginas; i++) {
+        EntradaTabelaPagina *entrada = obter_entrada_pagina(&processo->tabela_paginas, i);
+        entrada_definir_quadro(entrada, quadros[i]);
+        entrada_ativar(entrada, TP_PRESENTE | TP_REFERENCIADA);
+        entrada_desativar(entrada, TP_MODIFICADA);
+        if (s) {
+            substituicao_registrar_carga(s, quadros[i], processo->id, i);
+        }
+    }
+    processo->paginas_presentes = processo->num_paginas;
+    free(quadros);
+    
+    REGISTRAR_DEPURACAO("  Paginas 0-%d mapeadas em %d quadros\n", processo->num_paginas - 1, processo->num_paginas);
+    
+    return 1;
+}
+
+// Preenche os quadros das páginas presentes no intervalo [inicio, fim) de um
+// processo, acumulando o tempo gasto em tempo_geracao_ns e tempo_copia_ns
+static void copiar_intervalo_para_quadros(MemoriaFisica *mf, Processo *processo, int inicio, int fim,
+                                          long long *tempo_geracao_ns, long long *tempo_copia_ns) {
+    // Sem memória lógica, o conteúdo é gerado diretamente nos quadros
+    int gerar = processo->memoria_logica == NULL;
+    
+    int pagina = inicio;
+    while (pagina < fim) {
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+        if (!entrada || !entrada_tem(*entrada, TP_PRESENTE)) {
+            pagina++;
+            continue;
+        }
+        
+        // Agrupa as páginas seguintes enquanto estiverem em quadros fisicamente adjacentes
+        int quadro = entrada_quadro(*entrada);
+        int num_paginas_seq = 1;
+        while (pagina + num_paginas_seq < fim) {
+            EntradaTabelaPagina *seguinte = buscar_entrada_pagina(&processo->tabela_paginas, pagina + num_paginas_seq);
+            if (!seguinte || !entrada_tem(*seguinte, TP_PRESENTE) || entrada_quadro(*seguinte) != quadro + num_paginas_seq) {
+                break;
+            }
+            num_paginas_seq++;
+        }
+        
+        size_t endereco_logico_base = inicio_da_pagina(mf, pagina);
+        size_t bytes_para_copiar = bytes_das_paginas(mf, processo, pagina, num_paginas_seq);
+        
+        long long inicio_ns = agora_ns();
+        if (bytes_para_copiar > 0 && gerar) {
+            gerar_dados_aleatorios_intervalo(processo, mf->memoria + (size_t)quadro * mf->tamanho_pagina,
+                                             endereco_logico_base, bytes_para_copiar);
+            *tempo_geracao_ns += agora_ns() - inicio_ns;
+            REGISTRAR_DEPURACAO("  Paginas %d-%d: %zu bytes gerados nos quadros %d-%d\n", 
+                                pagina, pagina + num_paginas_seq - 1, bytes_para_copiar,
+                                quadro, quadro + num_paginas_seq - 1);
+        } else if (bytes_para_copiar > 0 &&
+            escrever_pagina(mf, quadro, processo->memoria_logica + endereco_logico_base, bytes_para_copiar)) {
+            *tempo_copia_ns += agora_ns() - inicio_ns;
+            REGISTRAR_DEPURACAO("  Paginas %d-%d: %zu bytes copiados para os quadros %d-%d\n", 
+                                pagina, pagina + num_paginas_seq - 1, bytes_para_copiar,
+                                quadro, quadro + num_paginas_seq - 1);
+        }
+        pagina += num_paginas_seq;
+    }
+}
+
+// Preenche os quadros das páginas presentes de um processo
+static void copiar_paginas_para_quadros(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo) {
+    REGISTRAR_DEPURACAO("%s dados da memoria logica para a fisica do processo %d...\n",
+                        processo->memoria_logica ? "Copiando" : "Gerando", processo->id);
+    
+    long long tempo_geracao_ns = 0, tempo_copia_ns = 0;
+    copiar_intervalo_para_quadros(mf, processo, 0, processo->num_paginas, &tempo_geracao_ns, &tempo_copia_ns);
+    somar_contador(gp, &gp->estatisticas.tempo_geracao_ns, tempo_geracao_ns);
+    somar_contador(gp, &gp->estatisticas.tempo_copia_ns, tempo_copia_ns);
+}
+
+// Carga de uma imagem dividida entre as threads do pool
+typedef struct {
+    MemoriaFisica *mf;
+    Processo *processo;
+    long long tempo_geracao_ns;               // Soma dos tempos de todas as threads (atômico)
+    long long tempo_copia_ns;
+} CargaImagem;
+
+// Gera e copia as páginas [inicio, fim) de um processo recém-criado
+static void carregar_bloco_imagem(void *contexto, size_t inicio, size_t fim) {
+    CargaImagem *carga = (CargaImagem*)contexto;
+    Processo *processo = carga->processo;
+    long long tempo_geracao_ns = 0, tempo_copia_ns = 0;
+    
+    // O trecho da memória lógica é gerado logo antes da cópia, enquanto ainda está no cache
+    if (processo->memoria_logica) {
+        size_t base = inicio_da_pagina(carga->mf, (int)inicio);
+        long long inicio_ns = agora_ns();
+        gerar_dados_aleatorios_intervalo(processo, processo->memoria_logica + base, base,
+                                         bytes_das_paginas(carga->mf, processo, (int)inicio, (int)(fim - inicio)));
+        tempo_geracao_ns += agora_ns() - inicio_ns;
+    }
+    copiar_intervalo_para_quadros(carga->mf, processo, (int)inicio, (int)fim, &tempo_geracao_ns, &tempo_copia_ns);
+    
+    __atomic_fetch_add(&carga->tempo_geracao_ns, tempo_geracao_ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&carga->tempo_copia_ns, tempo_copia_ns, __ATOMIC_RELAXED);
+}
+
+// Gera a imagem de um processo com todas as páginas presentes e a leva aos quadros,
+// dividindo as páginas entre as threads de carga
+static void carregar_imagem_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo) {
+    REGISTRAR_DEPURACAO("Gerando a imagem do processo %d com %d threads...\n", processo->id,
+                        gp->pool_carga ? gp->pool_carga->num_threads + 1 : 1);
+    
+    CargaImagem carga = {mf, processo, 0, 0};
+    size_t paginas_por_bloco = BYTES_POR_BLOCO_CARGA / mf->tamanho_pagina;
+    executar_em_paralelo(gp->pool_carga, processo->num_paginas, paginas_por_bloco > 0 ? paginas_por_bloco : 1,
+                         carregar_bloco_imagem, &carga);
+    somar_contador(gp, &gp->estatisticas.tempo_geracao_ns, carga.tempo_geracao_ns);
+    somar_contador(gp, &gp->estatisticas.tempo_copia_ns, carga.tempo_copia_ns);
+}
+
+int criar_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, size_t tamanho, int tamanho_pagina, size_t tamanho_max_processo) {
+    // Verifica se o tamanho é válido
+    if (tamanho == 0 || tamanho > tamanho_max_processo) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Tamanho de processo invalido (%zu). Deve estar entre 1 e %zu bytes.\n", 
+                     tamanho, tamanho_max_processo);
+        return -1;
+    }
+    
+    if (calcular_num_paginas(tamanho, tamanho_pagina) == -1) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Processo de %zu bytes tem paginas demais.\n", tamanho);
+        return -1;
+    }
+    
+    // Verifica se o ID já existe e reserva o ID e um slot. O processo só fica
+    // ativo (visível às outras threads) depois de construído, fora da trava da tabela.
+    travar_tabela_escrita(gp);
+    Processo *processo = reservar_processo(gp, id_processo);
+    destravar_tabela(gp);
+    if (!processo) {
+        return -1;
     }
     
-    printf("Gerenciador de processos inicializado.\n");
+    // Cria o processo
+    processo->tamanho = tamanho;
+    processo->num_paginas = calcular_num_paginas(tamanho, tamanho_pagina);
+    // Semente própria do processo, derivada de forma determinística da global e do ID
+    processo->semente = splitmix64_misturar(gp->semente ^ ((uint64_t)id_processo * SPLITMIX_GAMMA));
+    // O início comum da imagem termina em um limite de página, para que as páginas sejam idênticas
+    processo->semente_comum = splitmix64_misturar(gp->semente);
+    processo->bytes_comuns = tamanho * (size_t)gp->percentual_imagem_comum / 100 / tamanho_pagina * tamanho_pagina;
+    processo->percentual_entropia = gp->percentual_entropia;
+    
+    // Cria a tabela de páginas na representação configurada; todas as entradas começam ausentes
+    long long inicio_ns = agora_ns();
+    if (gp->tipo_tabela == TABELA_INVERTIDA && !gp->tabela_invertida) {
+        gp->tabela_invertida = criar_tabela_invertida();
+    }
+    int tabela_criada = criar_tabela_paginas(&processo->tabela_paginas, gp->tipo_tabela, processo->num_paginas,
+                                             gp->tabela_invertida, processo->id);
+    somar_contador(gp, &gp->estatisticas.tempo_tabela_ns, agora_ns() - inicio_ns);
+    if (!tabela_criada) {
+        REGISTRAR_ERRO("Falha ao alocar tabela de paginas para o processo %d.\n", processo->id);
+        descartar_processo(gp, processo);
+        return -1;
+    }
+    processo->faltas_pagina = 0;
+    processo->paginas_presentes = 0;
+    processo->trabalho = NULL;
+    
+    // Aloca a memória lógica dinamicamente; nas imagens sem cópia ela não existe
+    // e o conteúdo vive só nos quadros (e nas cópias das páginas despejadas)
+    processo->memoria_logica = NULL;
+    processo->paginas_salvas = NULL;
+    processo->slots_swap = NULL;
+    processo->objetos_comprimidos = NULL;
+    if (!gp->imagens_sem_copia) {
+        processo->memoria_logica = (unsigned char*)malloc(tamanho);
+    }
+    if (!gp->imagens_sem_copia && !processo->memoria_logica) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar memoria logica para o processo %d.\n", processo->id);
+        descartar_processo(gp, processo);
+        return -1;
+    }
+    
+    if (gp->paginacao_sob_demanda) {
+        // Nenhum quadro é reservado: cada página é carregada na primeira falta
+        REGISTRAR_INFO("Processo %d criado sob demanda (nenhuma pagina carregada).\n", processo->id);
+        REGISTRAR_INFO("  - Tamanho: %zu bytes\n", processo->tamanho);
+        REGISTRAR_INFO("  - Paginas: %d\n", processo->num_paginas);
+        publicar_processo(gp, processo);
+        return id_processo;
+    }
+    
+    // Marca as páginas que terão cópia na memória lógica
+    inicio_ns = agora_ns();
+    for (int i = 0; i < processo->num_paginas && processo->memoria_logica; i++) {
+        EntradaTabelaPagina *entrada = obter_entrada_pagina(&processo->tabela_paginas, i);
+        if (!entrada) {
+            descartar_processo(gp, processo);
+            return -1;
+        }
+        entrada_ativar(entrada, TP_EM_MEMORIA_LOGICA);
+    }
+    somar_contador(gp, &gp->estatisticas.tempo_tabela_ns, agora_ns() - inicio_ns);
+    
+    // Aloca quadros físicos para o processo
+    if (!alocar_quadros_do_processo(gp, mf, processo)) {
+        REGISTRAR_ERRO("Falha ao alocar quadros para o processo %d.\n", processo->id);
+        descartar_processo(gp, processo);
+        return -1;
+    }
+    
+    // Gera os dados na memória lógica e os copia para a física (ou os gera direto nos quadros)
+    carregar_imagem_processo(gp, mf, processo);
+    
+    REGISTRAR_INFO("Processo %d criado com sucesso!\n", processo->id);
+    REGISTRAR_INFO("  - Tamanho: %zu bytes\n", processo->tamanho);
+    REGISTRAR_INFO("  - Paginas: %d\n", processo->num_paginas);
+    
+    // Depois de publicado, o processo pode ser removido a qualquer momento por outra thread
+    publicar_processo(gp, processo);
+    return id_processo;
 }
 
-int calcular_num_paginas(int tamanho, int tamanho_pagina) {
-    int num_paginas = tamanho / tamanho_pagina;
-    if (tamanho % tamanho_pagina != 0) {
-        num_paginas++; // Arredonda para cima
+int alocar_quadros_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo) {
+    Processo *processo = adquirir_processo(gp, id_processo);
+    if (!processo) {
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        return 0;
     }
-    return num_paginas;
+    int sucesso = alocar_quadros_do_processo(gp, mf, processo);
+    soltar_processo(gp, processo);
+    return sucesso;
 }
 
-void gerar_dados_aleatorios_processo(Processo *processo) {
-    srand(time(NULL) + processo->id); // Seed baseado no ID do processo
+void copiar_memoria_logica_para_fisica(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo) {
+    Processo *processo = adquirir_processo(gp, id_processo);
+    if (!processo) {
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        return;
+    }
+    copiar_paginas_para_quadros(gp, mf, processo);
+    soltar_processo(gp, processo);
+}
+
+// Dá ao filho uma cópia própria de uma página do pai que está no cache
+// comprimido ou no swap: em outro objeto do cache, em outro slot ou, se
+// ambos a recusarem, na memória do hospedeiro
+static int copiar_pagina_guardada(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *pai, Processo *filho,
+                                  int pagina, EntradaTabelaPagina *entrada) {
+    unsigned char *buffer = (unsigned char*)malloc(mf->tamanho_pagina);
+    int objeto = objeto_comprimido_da_pagina(pai, pagina);
+    int lida = buffer && (objeto != -1 ? cache_comprimido_ler(gp->cache_comprimido, mf, objeto, buffer)
+                                       : swap_ler_pagina(gp->swap, slot_swap_da_pagina(pai, pagina), buffer));
+    if (!lida) {
+        free(buffer);
+        return 0;
+    }
+    int sucesso = (gp->cache_comprimido && guardar_no_cache_comprimido(gp, mf, filho, pagina, buffer)) ||
+                  (gp->swap && gravar_no_swap(gp, filho, pagina, buffer));
+    if (!sucesso) {
+        unsigned char *destino = copia_da_pagina(mf, filho, pagina, 1);
+        if (destino) {
+            memcpy(destino, buffer, bytes_das_paginas(mf, filho, pagina, 1));
+            entrada_ativar(entrada, TP_EM_MEMORIA_LOGICA);
+            sucesso = 1;
+        }
+    }
+    free(buffer);
+    return sucesso;
+}
+
+// Copia a entrada de uma página do processo original para o filho, compartilhando o
+// quadro (ou a cópia salva, se a página estiver ausente). Retorna 0 se faltar memória.
+static int herdar_pagina(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *pai, Processo *filho,
+                         int pagina, EntradaTabelaPagina *entrada_pai) {
+    EntradaTabelaPagina *entrada = obter_entrada_pagina(&filho->tabela_paginas, pagina);
+    if (!entrada) {
+        return 0;
+    }
     
-    for (int i = 0; i < processo->tamanho; i++) {
-        processo->memoria_logica[i] = rand() % 256; // Valores de 0 a 255
+    if (entrada_tem(*entrada_pai, TP_PRESENTE)) {
+        if (!compartilhar_quadro(mf, entrada_quadro(*entrada_pai))) {
+            return 0;
+        }
+        entrada_ativar(entrada_pai, TP_COPIA_NA_ESCRITA);
+        *entrada = *entrada_pai;
+        filho->paginas_presentes++;
+        // Sem memória lógica, o filho só recupera da semente o conteúdo nunca
+        // escrito; páginas que o pai tem guardadas (inclusive no swap) contam como modificadas
+        if (entrada_tem(*entrada_pai, TP_EM_MEMORIA_LOGICA) || slot_swap_da_pagina(pai, pagina) != -1) {
+            entrada_desativar(entrada, TP_EM_MEMORIA_LOGICA);
+            entrada_ativar(entrada, TP_MODIFICADA);
+        }
+        return 1;
     }
     
-    printf("Dados aleatorios gerados para o processo %d (%d bytes).\n", 
-           processo->id, processo->tamanho);
+    *entrada = *entrada_pai;
+    entrada_desativar(entrada, TP_EM_MEMORIA_LOGICA);
+    if (objeto_comprimido_da_pagina(pai, pagina) != -1 || slot_swap_da_pagina(pai, pagina) != -1) {
+        return copiar_pagina_guardada(gp, mf, pai, filho, pagina, entrada);
+    }
+    unsigned char *origem = entrada_tem(*entrada_pai, TP_EM_MEMORIA_LOGICA) ? copia_da_pagina(mf, pai, pagina, 0) : NULL;
+    if (origem) {
+        unsigned char *destino = copia_da_pagina(mf, filho, pagina, 1);
+        if (!destino) {
+            return 0;
+        }
+        memcpy(destino, origem, bytes_das_paginas(mf, pai, pagina, 1));
+        entrada_ativar(entrada, TP_EM_MEMORIA_LOGICA);
+    }
+    return 1;
 }
 
-int criar_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, int tamanho, int tamanho_pagina, int tamanho_max_processo) {
-    // Verifica se há espaço para mais processos
-    if (gp->num_processos >= MAX_PROCESSOS) {
-        printf("Erro: Numero maximo de processos atingido (%d).\n", MAX_PROCESSOS);
+int fork_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, int id_filho) {
+    // Soltar um quadro compartilhado percorre a tabela de processos sem travas
+    if (gp->concorrente) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O fork nao e suportado no modo concorrente.\n");
         return -1;
     }
-    
-    // Verifica se o ID já existe
-    if (encontrar_processo(gp, id_processo)) {
-        printf("Erro: Processo com ID %d ja existe.\n", id_processo);
+    long long inicio_ns = agora_ns();
+    travar_tabela_escrita(gp);
+    Processo *filho = reservar_processo(gp, id_filho);
+    destravar_tabela(gp);
+    if (!filho) {
+        return -1;
+    }
+    Processo *pai = adquirir_processo(gp, id_processo);
+    if (!pai) {
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        descartar_processo(gp, filho);
         return -1;
     }
     
-    // Verifica se o tamanho é válido
-    if (tamanho <= 0 || tamanho > tamanho_max_processo) {
-        printf("Erro: Tamanho de processo invalido (%d). Deve estar entre 1 e %d bytes.\n", 
-               tamanho, tamanho_max_processo);
+    filho->tamanho = pai->tamanho;
+    filho->num_paginas = pai->num_paginas;
+    filho->semente = pai->semente;
+    filho->semente_comum = pai->semente_comum;
+    filho->bytes_comuns = pai->bytes_comuns;
+    filho->percentual_entropia = pai->percentual_entropia;
+    filho->faltas_pagina = 0;
+    filho->paginas_presentes = 0;
+    filho->trabalho = NULL;
+    filho->memoria_logica = NULL;
+    filho->paginas_salvas = NULL;
+    filho->slots_swap = NULL;
+    filho->objetos_comprimidos = NULL;
+    if (!criar_tabela_paginas(&filho->tabela_paginas, pai->tabela_paginas.tipo, filho->num_paginas,
+                              gp->tabela_invertida, id_filho)) {
+        REGISTRAR_ERRO("Falha ao alocar tabela de paginas para o processo %d.\n", id_filho);
+        soltar_processo(gp, pai);
+        descartar_processo(gp, filho);
         return -1;
     }
     
-    // Encontra um slot livre para o processo
-    int slot_livre = -1;
-    for (int i = 0; i < MAX_PROCESSOS; i++) {
-        if (!gp->processos[i].ativo) {
-            slot_livre = i;
+    // Só as entradas materializadas do pai são visitadas e copiadas
+    int compartilhadas = 0;
+    for (int pagina = 0; pagina < pai->num_paginas; pagina++) {
+        EntradaTabelaPagina *entrada_pai = buscar_entrada_pagina(&pai->tabela_paginas, pagina);
+        if (!entrada_pai) {
+            continue;
+        }
+        if (!herdar_pagina(gp, mf, pai, filho, pagina, entrada_pai)) {
+            RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao copiar a pagina %d do processo %d no fork.\n", pagina, id_processo);
+            // Desfaz os compartilhamentos; as páginas do pai continuam marcadas e
+            // são desmarcadas sem cópia na próxima escrita
+            for (int i = 0; i < pagina; i++) {
+                EntradaTabelaPagina *entrada = buscar_entrada_pagina(&filho->tabela_paginas, i);
+                if (entrada && entrada_tem(*entrada, TP_PRESENTE)) {
+                    liberar_quadro(mf, entrada_quadro(*entrada));
+                }
+            }
+            soltar_processo(gp, pai);
+            descartar_processo(gp, filho);
+            return -1;
+        }
+        compartilhadas += entrada_tem(*entrada_pai, TP_PRESENTE);
+    }
+    soltar_processo(gp, pai);
+    
+    somar_contador(gp, &gp->total_forks, 1);
+    somar_contador(gp, &gp->estatisticas.tempo_fork_ns, agora_ns() - inicio_ns);
+    REGISTRAR_INFO("Processo %d criado por fork do processo %d.\n", id_filho, id_processo);
+    REGISTRAR_INFO("  - Paginas compartilhadas: %d de %d\n", compartilhadas, filho->num_paginas);
+    
+    publicar_processo(gp, filho);
+    return id_filho;
+}
+
+void definir_paginacao_sob_demanda(GerenciadorProcessos *gp, int ativa) {
+    gp->paginacao_sob_demanda = ativa ? 1 : 0;
+    REGISTRAR_INFO("Paginacao sob demanda %s.\n", gp->paginacao_sob_demanda ? "ativada" : "desativada");
+}
+
+void definir_imagens_sem_copia(GerenciadorProcessos *gp, int ativa) {
+    gp->imagens_sem_copia = ativa ? 1 : 0;
+    REGISTRAR_INFO("Imagens sem copia %s.\n", gp->imagens_sem_copia ? "ativadas" : "desativadas");
+}
+
+int definir_threads_carga(GerenciadorProcessos *gp, int num_threads) {
+    if (num_threads < 1) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Numero de threads de carga invalido (%d).\n", num_threads);
+        return 0;
+    }
+    PoolThreads *pool = NULL;
+    if (num_threads > 1) {
+        pool = criar_pool_threads(num_threads);
+        if (!pool) {
+            return 0;
+        }
+    }
+    destruir_pool_threads(gp->pool_carga);
+    gp->pool_carga = pool;
+    REGISTRAR_INFO("Imagens dos processos carregadas com %d thread(s).\n", pool ? pool->num_threads + 1 : 1);
+    return 1;
+}
+
+int configurar_swap(GerenciadorProcessos *gp, MemoriaFisica *mf, size_t tamanho, const char *arquivo,
+                    long long latencia_ns, long long bytes_por_segundo) {
+    if (gp->swap && gp->swap->slots_em_uso > 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O swap guarda %d paginas e nao pode ser trocado.\n", gp->swap->slots_em_uso);
+        return 0;
+    }
+    DispositivoSwap *swap = NULL;
+    if (tamanho > 0) {
+        swap = criar_swap(arquivo, tamanho, mf->tamanho_pagina, latencia_ns, bytes_por_segundo);
+        if (!swap) {
+            return 0;
+        }
+    }
+    destruir_swap(gp->swap);
+    gp->swap = swap;
+    if (!swap) {
+        REGISTRAR_INFO("Swap desativado.\n");
+    } else if (!gp->substituicao || gp->substituicao->politica == SUBSTITUICAO_NENHUMA) {
+        REGISTRAR_AVISO("O swap so recebe paginas despejadas por uma politica de substituicao.\n");
+    }
+    return 1;
+}
+
+int configurar_cache_comprimido(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadros, int limite_percentual) {
+    if (gp->concorrente && quadros != 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O cache comprimido nao e suportado no modo concorrente.\n");
+        return 0;
+    }
+    if (gp->cache_comprimido && gp->cache_comprimido->objetos_em_uso > 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O cache comprimido guarda %d paginas e nao pode ser trocado.\n",
+                     gp->cache_comprimido->objetos_em_uso);
+        return 0;
+    }
+    // Os quadros do cache anterior voltam à memória antes da reserva do novo
+    destruir_cache_comprimido(gp->cache_comprimido, mf);
+    gp->cache_comprimido = NULL;
+    if (quadros == 0) {
+        REGISTRAR_INFO("Cache comprimido desativado.\n");
+        return 1;
+    }
+    gp->cache_comprimido = criar_cache_comprimido(mf, quadros, limite_percentual);
+    if (!gp->cache_comprimido) {
+        return 0;
+    }
+    if (!gp->substituicao || gp->substituicao->politica == SUBSTITUICAO_NENHUMA) {
+        REGISTRAR_AVISO("O cache comprimido so recebe paginas despejadas por uma politica de substituicao.\n");
+    }
+    return 1;
+}
+
+int configurar_conjunto_trabalho(GerenciadorProcessos *gp, int intervalo, int janela) {
+    if (gp->concorrente && intervalo != 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "O conjunto de trabalho nao e suportado no modo concorrente.\n");
+        return 0;
+    }
+    RastreadorTrabalho *r = NULL;
+    if (intervalo != 0) {
+        r = criar_rastreador_trabalho(intervalo, janela);
+        if (!r) {
+            return 0;
+        }
+    }
+    
+    // O histórico dos processos pertence ao rastreador anterior
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        liberar_estado_trabalho(processo->trabalho);
+        processo->trabalho = NULL;
+    }
+    destruir_rastreador_trabalho(gp->conjunto_trabalho);
+    gp->conjunto_trabalho = r;
+    if (!r) {
+        REGISTRAR_INFO("Conjunto de trabalho desativado.\n");
+    }
+    return 1;
+}
+
+int reduzir_paginas_residentes(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, int limite) {
+    Substituidor *s = obter_substituidor(gp, mf);
+    int despejadas = 0;
+    while (s && gp->conjunto_trabalho && processo->paginas_presentes > limite) {
+        int pagina = conjunto_trabalho_escolher_pagina(gp->conjunto_trabalho, gp, processo);
+        if (pagina == -1) {
+            break;
+        }
+        int quadro = entrada_quadro(*buscar_entrada_pagina(&processo->tabela_paginas, pagina));
+        if (s->dono_pid[quadro] == -1 || !despejar_quadro(gp, mf, s, quadro)) {
             break;
         }
+        s->despejos++;
+        gp->conjunto_trabalho->despejos_locais++;
+        processo->trabalho->despejos_locais++;
+        despejadas++;
+    }
+    return despejadas;
+}
+
+int configurar_compactacao(GerenciadorProcessos *gp, int quadros_por_passo, int intervalo) {
+    if (gp->concorrente && quadros_por_passo != 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A compactacao nao e suportada no modo concorrente.\n");
+        return 0;
+    }
+    Compactador *c = NULL;
+    if (quadros_por_passo != 0) {
+        c = criar_compactador(quadros_por_passo, intervalo);
+        if (!c) {
+            return 0;
+        }
+    }
+    destruir_compactador(gp->compactacao);
+    gp->compactacao = c;
+    if (!c) {
+        REGISTRAR_INFO("Compactacao desativada.\n");
+    }
+    return 1;
+}
+
+// Aponta a entrada de uma página para outro quadro, mantendo seus bits
+static void remapear_pagina(GerenciadorProcessos *gp, Processo *processo, int pagina, int quadro) {
+    entrada_definir_quadro(buscar_entrada_pagina(&processo->tabela_paginas, pagina), quadro);
+    if (gp->tlb) {
+        tlb_invalidar(gp->tlb, processo->id, pagina);
+    }
+}
+
+int realocar_quadro(GerenciadorProcessos *gp, MemoriaFisica *mf, int origem, int destino) {
+    Substituidor *s = gp->substituicao;
+    Processo *dono = s && !gp->concorrente && origem >= 0 && origem < mf->numero_quadros && s->dono_pid[origem] != -1
+                         ? encontrar_processo(gp, s->dono_pid[origem]) : NULL;
+    if (!dono) {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "O quadro %d nao tem dono e nao pode ser migrado.\n", origem);
+        return 0;
+    }
+    int pagina = s->dono_pagina[origem];
+    if (!migrar_quadro(mf, origem, destino)) {
+        return 0;
     }
     
-    if (slot_livre == -1) {
-        printf("Erro: Nao foi possivel encontrar um slot livre para o processo.\n");
+    Processo *outro;
+    int pagina_outro;
+    while (referencias_quadro(mf, destino) > 1 &&
+           (outro = procurar_compartilhador(gp, dono, pagina, origem, &pagina_outro))) {
+        remapear_pagina(gp, outro, pagina_outro, destino);
+    }
+    remapear_pagina(gp, dono, pagina, destino);
+    substituicao_migrar_quadro(s, origem, destino);
+    return 1;
+}
+
+int configurar_deduplicacao(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadros_por_passo, int intervalo) {
+    if (gp->concorrente && quadros_por_passo != 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A deduplicacao nao e suportada no modo concorrente.\n");
+        return 0;
+    }
+    Deduplicador *d = NULL;
+    if (quadros_por_passo != 0) {
+        d = criar_deduplicador(mf->numero_quadros, quadros_por_passo, intervalo);
+        if (!d) {
+            return 0;
+        }
+    }
+    destruir_deduplicador(gp->deduplicacao);
+    gp->deduplicacao = d;
+    if (!d) {
+        REGISTRAR_INFO("Deduplicacao desativada.\n");
+    }
+    return 1;
+}
+
+// Passa uma página para o quadro mesclado, com cópia na escrita, retirando seu mapeamento do quadro antigo
+static void mover_para_quadro_mesclado(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo,
+                                       int pagina, int quadro, int destino) {
+    compartilhar_quadro(mf, destino);
+    entrada_ativar(buscar_entrada_pagina(&processo->tabela_paginas, pagina), TP_COPIA_NA_ESCRITA);
+    remapear_pagina(gp, processo, pagina, destino);
+    liberar_quadro(mf, quadro);
+}
+
+int mesclar_quadros(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadro, int destino) {
+    Substituidor *s = gp->substituicao;
+    int validos = s && !gp->concorrente && quadro != destino && quadro >= 0 && quadro < mf->numero_quadros &&
+                  destino >= 0 && destino < mf->numero_quadros && s->dono_pid[quadro] != -1 &&
+                  s->dono_pid[destino] != -1;
+    Processo *dono = validos ? encontrar_processo(gp, s->dono_pid[quadro]) : NULL;
+    Processo *dono_destino = validos ? encontrar_processo(gp, s->dono_pid[destino]) : NULL;
+    if (!dono || !dono_destino) {
+        RELATAR_ERRO(ERRO_QUADRO_INVALIDO, "Os quadros %d e %d nao podem ser mesclados.\n", quadro, destino);
+        return 0;
+    }
+    int pagina = s->dono_pagina[quadro];
+    
+    entrada_ativar(buscar_entrada_pagina(&dono_destino->tabela_paginas, s->dono_pagina[destino]), TP_COPIA_NA_ESCRITA);
+    Processo *outro;
+    int pagina_outro;
+    while (referencias_quadro(mf, quadro) > 1 &&
+           (outro = procurar_compartilhador(gp, dono, pagina, quadro, &pagina_outro))) {
+        mover_para_quadro_mesclado(gp, mf, outro, pagina_outro, quadro, destino);
+    }
+    mover_para_quadro_mesclado(gp, mf, dono, pagina, quadro, destino);
+    substituicao_registrar_liberacao(s, quadro);
+    REGISTRAR_DEPURACAO("Deduplicacao: pagina %d, quadro %d mesclado ao quadro %d\n", pagina, quadro, destino);
+    return 1;
+}
+
+int tratar_falta_pagina(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, int pagina) {
+    EntradaTabelaPagina *entrada = obter_entrada_pagina(&processo->tabela_paginas, pagina);
+    if (!entrada) {
         return -1;
     }
     
-    // Cria o processo
-    Processo *processo = &gp->processos[slot_livre];
-    processo->id = id_processo;
-    processo->tamanho = tamanho;
-    processo->num_paginas = calcular_num_paginas(tamanho, tamanho_pagina);
-    processo->ativo = 1;
+    processo->faltas_pagina++;
+    somar_contador(gp, &gp->total_faltas_pagina, 1);
+    long long inicio_ns = agora_ns();
     
-    // Aloca a tabela de páginas dinamicamente
-    processo->tabela_paginas = (EntradaTabelaPagina*)malloc(processo->num_paginas * sizeof(EntradaTabelaPagina));
-    if (!processo->tabela_paginas) {
-        printf("Erro: Falha ao alocar tabela de paginas para o processo %d.\n", processo->id);
-        processo->ativo = 0;
-        return -1;
+    Substituidor *s = obter_substituidor(gp, mf);
+    if (s) {
+        travar_substituicao(gp);
+        substituicao_registrar_falta(s, gp, processo->id, pagina);
+        destravar_substituicao(gp);
     }
     
-    // Inicializa a tabela de páginas
-    for (int i = 0; i < processo->num_paginas; i++) {
-        processo->tabela_paginas[i].quadro_fisico = -1;
-        processo->tabela_paginas[i].presente = 0;
-        processo->tabela_paginas[i].modificada = 0;
-    }
-    
-    // Aloca a memória lógica dinamicamente
-    processo->memoria_logica = (unsigned char*)malloc(tamanho);
-    if (!processo->memoria_logica) {
-        printf("Erro: Falha ao alocar memoria logica para o processo %d.\n", processo->id);
-        processo->ativo = 0;
-        free(processo->tabela_paginas);
-        processo->tabela_paginas = NULL;
+    // Controle PFF: no limite do orçamento, a página entra no lugar de outra do próprio processo
+    int orcamento = gp->conjunto_trabalho ? conjunto_trabalho_orcamento(gp->conjunto_trabalho, processo) : 0;
+    if (orcamento > 0 && processo->paginas_presentes >= orcamento) {
+        reduzir_paginas_residentes(gp, mf, processo, orcamento - 1);
+    }
+    
+    int quadro = obter_quadro(gp, mf);
+    if (quadro == -1) {
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Falta de pagina %d do processo %d sem quadro livre.\n", pagina, processo->id);
+        somar_contador(gp, &gp->estatisticas.tempo_faltas_ns, agora_ns() - inicio_ns);
         return -1;
     }
     
-    // Gera dados aleatórios para a memória lógica
-    gerar_dados_aleatorios_processo(processo);
+    // Preenche o quadro com o conteúdo da página: a cópia no cache comprimido
+    // ou no swap, que é a mais recente; a cópia salva na memória lógica, se
+    // houver; ou a imagem gerada a partir da semente do processo
+    size_t endereco_logico_base = inicio_da_pagina(mf, pagina);
+    size_t bytes = bytes_das_paginas(mf, processo, pagina, 1);
+    unsigned char *destino = mf->memoria + (size_t)quadro * mf->tamanho_pagina;
+    int objeto = objeto_comprimido_da_pagina(processo, pagina);
+    int slot = slot_swap_da_pagina(processo, pagina);
+    unsigned char *copia = entrada_tem(*entrada, TP_EM_MEMORIA_LOGICA) ? copia_da_pagina(mf, processo, pagina, 0) : NULL;
+    long long inicio_carga_ns = agora_ns();
+    if (objeto != -1) {
+        if (!cache_comprimido_ler(gp->cache_comprimido, mf, objeto, destino)) {
+            liberar_quadro(mf, quadro);
+            somar_contador(gp, &gp->estatisticas.tempo_faltas_ns, agora_ns() - inicio_ns);
+            return -1;
+        }
+        somar_contador(gp, &gp->estatisticas.tempo_descompressao_ns, agora_ns() - inicio_carga_ns);
+    } else if (slot != -1) {
+        if (!swap_ler_pagina(gp->swap, slot, destino)) {
+            liberar_quadro(mf, quadro);
+            somar_contador(gp, &gp->estatisticas.tempo_faltas_ns, agora_ns() - inicio_ns);
+            return -1;
+        }
+        somar_contador(gp, &gp->estatisticas.tempo_swap_ns, agora_ns() - inicio_carga_ns);
+    } else if (copia) {
+        escrever_pagina(mf, quadro, copia, bytes);
+        somar_contador(gp, &gp->estatisticas.tempo_copia_ns, agora_ns() - inicio_carga_ns);
+    } else {
+        gerar_dados_aleatorios_intervalo(processo, destino, endereco_logico_base, bytes);
+        somar_contador(gp, &gp->estatisticas.tempo_geracao_ns, agora_ns() - inicio_carga_ns);
+    }
+    
+    entrada_definir_quadro(entrada, quadro);
+    // Como no cache de swap, a página vinda do swap mantém o slot: enquanto
+    // não for modificada, o despejo não precisa gravá-la de novo
+    entrada_ativar(entrada, TP_PRESENTE | TP_REFERENCIADA);
+    entrada_desativar(entrada, TP_MODIFICADA);
+    // Como no zswap, a página sai do cache comprimido ao ser carregada: o
+    // quadro fica com a única cópia e precisa ser gravado de novo no despejo
+    if (objeto != -1) {
+        liberar_objeto_comprimido(gp, processo, pagina);
+        entrada_ativar(entrada, TP_MODIFICADA);
+    }
+    processo->paginas_presentes++;
+    if (s) {
+        substituicao_registrar_carga(s, quadro, processo->id, pagina);
+    }
     
-    // Aloca quadros físicos para o processo
-    if (!alocar_quadros_processo(gp, mf, processo->id)) {
-        printf("Erro: Falha ao alocar quadros para o processo %d.\n", processo->id);
-        liberar_processo(processo);
+    long long duracao_ns = agora_ns() - inicio_ns;
+    somar_contador(gp, &gp->estatisticas.tempo_faltas_ns, duracao_ns);
+    swap_registrar_falta(gp->swap, duracao_ns, slot != -1);
+    REGISTRAR_DEPURACAO("Falta de pagina: processo %d, pagina %d -> quadro %d\n", processo->id, pagina, quadro);
+    return quadro;
+}
+
+// Traduz um endereço de um processo já encontrado (e travado, no modo concorrente)
+static int64_t traduzir_no_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, uint64_t endereco_logico) {
+    int id_processo = processo->id;
+    if (endereco_logico >= processo->tamanho) {
+        RELATAR_ERRO(ERRO_ENDERECO_INVALIDO, "Endereco logico %llu fora do processo %d (tamanho %zu bytes).\n",
+                     (unsigned long long)endereco_logico, id_processo, processo->tamanho);
         return -1;
     }
     
-    // Copia dados da memória lógica para a física
-    copiar_memoria_logica_para_fisica(gp, mf, processo->id);
+    // A amostra do conjunto de trabalho pode despejar páginas, então vem antes da tradução
+    if (gp->conjunto_trabalho) {
+        conjunto_trabalho_registrar_acesso(gp->conjunto_trabalho, gp, mf, processo);
+    }
+    
+    int pagina = (int)(endereco_logico / mf->tamanho_pagina);
+    int deslocamento = (int)(endereco_logico % mf->tamanho_pagina);
+    EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
     
-    gp->num_processos++;
+    if (gp->tlb) {
+        tlb_trocar_contexto(gp->tlb, id_processo);
+        int quadro = tlb_buscar(gp->tlb, id_processo, pagina);
+        if (quadro != -1) {
+            // Uma tradução na TLB implica que a entrada existe e está presente
+            entrada_ativar(entrada, TP_REFERENCIADA);
+            if (gp->substituicao) {
+                travar_substituicao(gp);
+                substituicao_registrar_acerto(gp->substituicao, gp, quadro);
+                destravar_substituicao(gp);
+            }
+            return (int64_t)quadro * mf->tamanho_pagina + deslocamento;
+        }
+    }
+    
+    // Falta na TLB (ou TLB desativada): consulta a tabela de páginas
+    if (!entrada || !entrada_tem(*entrada, TP_PRESENTE)) {
+        if (tratar_falta_pagina(gp, mf, processo, pagina) == -1) {
+            return -1;
+        }
+        entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+    } else {
+        entrada_ativar(entrada, TP_REFERENCIADA);
+        if (gp->substituicao) {
+            travar_substituicao(gp);
+            substituicao_registrar_acerto(gp->substituicao, gp, entrada_quadro(*entrada));
+            destravar_substituicao(gp);
+        }
+    }
     
-    printf("Processo %d criado com sucesso!\n", processo->id);
-    printf("  - Tamanho: %d bytes\n", processo->tamanho);
-    printf("  - Paginas: %d\n", processo->num_paginas);
+    if (gp->tlb) {
+        tlb_inserir(gp->tlb, id_processo, pagina, entrada_quadro(*entrada));
+    }
     
-    return processo->id;
+    return (int64_t)entrada_quadro(*entrada) * mf->tamanho_pagina + deslocamento;
 }
 
-int alocar_quadros_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo) {
-    Processo *processo = encontrar_processo(gp, id_processo);
+int64_t traduzir_endereco(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, uint64_t endereco_logico) {
+    Processo *processo = adquirir_processo(gp, id_processo);
     if (!processo) {
-        printf("Erro: Processo %d nao encontrado.\n", id_processo);
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        return -1;
+    }
+    int64_t endereco_fisico = traduzir_no_processo(gp, mf, processo, endereco_logico);
+    soltar_processo(gp, processo);
+    return endereco_fisico;
+}
+
+// Verifica se a página que contém o endereço permite o acesso pedido. Páginas
+// ainda sem entrada têm as permissões padrão (leitura e escrita).
+static int acesso_permitido(MemoriaFisica *mf, Processo *processo, uint64_t endereco_logico, uint32_t permissao) {
+    if (endereco_logico >= processo->tamanho) {
+        return 1; // A tradução reporta o erro
+    }
+    EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, (int)(endereco_logico / mf->tamanho_pagina));
+    if (entrada && !entrada_tem(*entrada, permissao)) {
+        RELATAR_ERRO(ERRO_PROTECAO, "Violacao de protecao no endereco %llu do processo %d (%s nao permitida).\n",
+                     (unsigned long long)endereco_logico, processo->id, permissao == TP_ESCRITA ? "escrita" : "leitura");
         return 0;
     }
+    return 1;
+}
+
+// O processo fica travado do início da tradução até o fim do acesso, para que
+// outra thread não o remova (liberando o quadro) no meio da operação
+int ler_logico(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, uint64_t endereco_logico) {
+    Processo *processo = adquirir_processo(gp, id_processo);
+    if (!processo) {
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        return -1;
+    }
+    int valor = -1;
+    if (acesso_permitido(mf, processo, endereco_logico, TP_LEITURA)) {
+        int64_t endereco_fisico = traduzir_no_processo(gp, mf, processo, endereco_logico);
+        if (endereco_fisico != -1) {
+            valor = ler_da_memoria(mf, endereco_fisico);
+        }
+    }
+    soltar_processo(gp, processo);
+    return valor;
+}
+
+// Dá à página um quadro privado antes da primeira escrita depois de um fork.
+// Retorna o quadro da página, ou -1 se não houver quadro para a cópia.
+static int quebrar_copia_na_escrita(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, int pagina) {
+    EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+    int quadro = entrada_quadro(*entrada);
+    
+    // Os outros processos já deixaram o quadro: ele é só desta página
+    if (referencias_quadro(mf, quadro) == 1) {
+        entrada_desativar(entrada, TP_COPIA_NA_ESCRITA);
+        return quadro;
+    }
     
-    printf("Alocando %d quadros para o processo %d...\n", processo->num_paginas, id_processo);
+    long long inicio_ns = agora_ns();
+    int novo = obter_quadro(gp, mf);
+    if (novo == -1) {
+        RELATAR_ERRO(ERRO_SEM_QUADROS, "Copia na escrita da pagina %d do processo %d sem quadro livre.\n",
+                     pagina, processo->id);
+        return -1;
+    }
     
-    for (int i = 0; i < processo->num_paginas; i++) {
-        int quadro = alocar_quadro(mf);
-        if (quadro == -1) {
-            printf("Erro: Nao ha quadros suficientes para alocar a pagina %d do processo %d.\n", 
-                   i, id_processo);
-            
-            // Libera os quadros já alocados
-            for (int j = 0; j < i; j++) {
-                liberar_quadro(mf, processo->tabela_paginas[j].quadro_fisico);
-                processo->tabela_paginas[j].quadro_fisico = -1;
-                processo->tabela_paginas[j].presente = 0;
-            }
-            return 0;
-        }
-        
-        processo->tabela_paginas[i].quadro_fisico = quadro;
-        processo->tabela_paginas[i].presente = 1;
-        processo->tabela_paginas[i].modificada = 0;
-        
-        printf("  Pagina %d -> Quadro %d\n", i, quadro);
+    // O despejo feito para obter o quadro pode ter levado a própria página;
+    // nesse caso ela volta, já privada, por uma falta comum
+    if (!entrada_tem(*entrada, TP_PRESENTE)) {
+        liberar_quadro(mf, novo);
+        return tratar_falta_pagina(gp, mf, processo, pagina);
     }
     
-    return 1;
+    memcpy(mf->memoria + (size_t)novo * mf->tamanho_pagina, mf->memoria + (size_t)quadro * mf->tamanho_pagina,
+           bytes_das_paginas(mf, processo, pagina, 1));
+    entrada_definir_quadro(entrada, novo);
+    entrada_desativar(entrada, TP_COPIA_NA_ESCRITA);
+    soltar_quadro_da_pagina(gp, mf, processo, pagina, quadro);
+    if (gp->substituicao) {
+        substituicao_registrar_carga(gp->substituicao, novo, processo->id, pagina);
+    }
+    if (gp->tlb) {
+        tlb_invalidar(gp->tlb, processo->id, pagina);
+    }
+    somar_contador(gp, &gp->total_copias_na_escrita, 1);
+    somar_contador(gp, &gp->estatisticas.tempo_copia_ns, agora_ns() - inicio_ns);
+    REGISTRAR_DEPURACAO("Copia na escrita: processo %d, pagina %d, quadro %d -> %d\n",
+                        processo->id, pagina, quadro, novo);
+    return novo;
 }
 
-void copiar_memoria_logica_para_fisica(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo) {
-    Processo *processo = encontrar_processo(gp, id_processo);
+int escrever_logico(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, uint64_t endereco_logico, unsigned char valor) {
+    Processo *processo = adquirir_processo(gp, id_processo);
     if (!processo) {
-        printf("Erro: Processo %d nao encontrado.\n", id_processo);
-        return;
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        return 0;
+    }
+    int sucesso = 0;
+    if (acesso_permitido(mf, processo, endereco_logico, TP_ESCRITA)) {
+        int64_t endereco_fisico = traduzir_no_processo(gp, mf, processo, endereco_logico);
+        // A tradução acabou de garantir que a página está presente
+        int pagina = (int)(endereco_logico / mf->tamanho_pagina);
+        EntradaTabelaPagina *entrada = endereco_fisico != -1 ? buscar_entrada_pagina(&processo->tabela_paginas, pagina) : NULL;
+        if (entrada && entrada_tem(*entrada, TP_COPIA_NA_ESCRITA)) {
+            int quadro = quebrar_copia_na_escrita(gp, mf, processo, pagina);
+            endereco_fisico = quadro == -1 ? -1 : (int64_t)quadro * mf->tamanho_pagina + (int64_t)(endereco_logico % mf->tamanho_pagina);
+            entrada = buscar_entrada_pagina(&processo->tabela_paginas, pagina);
+        }
+        if (endereco_fisico != -1) {
+            escrever_na_memoria(mf, endereco_fisico, valor);
+            entrada_ativar(entrada, TP_MODIFICADA);
+            sucesso = 1;
+        }
+    }
+    soltar_processo(gp, processo);
+    return sucesso;
+}
+
+int definir_protecao_pagina(GerenciadorProcessos *gp, int id_processo, int pagina, int leitura, int escrita) {
+    Processo *processo = adquirir_processo(gp, id_processo);
+    if (!processo) {
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
+        return 0;
+    }
+    EntradaTabelaPagina *entrada = obter_entrada_pagina(&processo->tabela_paginas, pagina);
+    if (!entrada) {
+        RELATAR_ERRO(ERRO_ENDERECO_INVALIDO, "Pagina %d invalida para o processo %d.\n", pagina, id_processo);
+        soltar_processo(gp, processo);
+        return 0;
+    }
+    entrada_desativar(entrada, TP_LEITURA | TP_ESCRITA);
+    entrada_ativar(entrada, (leitura ? TP_LEITURA : 0) | (escrita ? TP_ESCRITA : 0));
+    soltar_processo(gp, processo);
+    return 1;
+}
+
+int configurar_tlb(GerenciadorProcessos *gp, int num_entradas, int associatividade, int limpar_na_troca) {
+    if (gp->concorrente && num_entradas != 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A TLB compartilhada nao e suportada no modo concorrente.\n");
+        return 0;
     }
+    destruir_tlb(gp->tlb);
+    gp->tlb = NULL;
     
-    printf("Copiando dados da memoria logica para a fisica do processo %d...\n", id_processo);
+    if (num_entradas == 0) {
+        REGISTRAR_INFO("TLB desativada.\n");
+        return 1;
+    }
     
-    for (int pagina = 0; pagina < processo->num_paginas; pagina++) {
-        if (processo->tabela_paginas[pagina].presente) {
-            int quadro = processo->tabela_paginas[pagina].quadro_fisico;
-            int endereco_fisico_base = quadro * mf->tamanho_pagina;
-            int endereco_logico_base = pagina * mf->tamanho_pagina;
-            
-            // Se o endereço lógico base já está fora do tamanho do processo, não copia nada
-            if (endereco_logico_base >= processo->tamanho) {
-                continue;
-            }
-            // Calcula quantos bytes copiar para esta página
-            int bytes_para_copiar = mf->tamanho_pagina;
-            if (endereco_logico_base + mf->tamanho_pagina > processo->tamanho) {
-                bytes_para_copiar = processo->tamanho - endereco_logico_base;
-            }
-            if (bytes_para_copiar <= 0) {
-                continue;
-            }
-            // Copia os dados
-            for (int i = 0; i < bytes_para_copiar; i++) {
-                unsigned char valor = processo->memoria_logica[endereco_logico_base + i];
-                escrever_na_memoria(mf, endereco_fisico_base + i, valor);
-            }
-            printf("  Pagina %d: %d bytes copiados para o quadro %d\n", 
-                   pagina, bytes_para_copiar, quadro);
+    gp->tlb = criar_tlb(num_entradas, associatividade, limpar_na_troca);
+    return gp->tlb != NULL;
+}
+
+int definir_tipo_tabela_paginas(GerenciadorProcessos *gp, TipoTabelaPaginas tipo) {
+    if (tipo < TABELA_LINEAR || tipo > TABELA_INVERTIDA) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Tipo de tabela de paginas invalido (%d).\n", tipo);
+        return 0;
+    }
+    if (gp->concorrente && tipo == TABELA_INVERTIDA) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "A tabela invertida compartilhada nao e suportada no modo concorrente.\n");
+        return 0;
+    }
+    gp->tipo_tabela = tipo;
+    REGISTRAR_INFO("Novos processos usarao tabela de paginas %s.\n", nome_tipo_tabela_paginas(tipo));
+    return 1;
+}
+
+void exibir_uso_tabelas_paginas(GerenciadorProcessos *gp) {
+    size_t total = 0;
+    
+    printf("\n=== USO DAS TABELAS DE PAGINAS ===\n");
+    printf("ID | Representacao    | Paginas | Bytes\n");
+    printf("---|------------------|---------|-----------\n");
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo->ativo) {
+            size_t bytes = bytes_tabela_paginas(&processo->tabela_paginas);
+            printf("%2d | %-16s | %7d | %9zu\n", processo->id,
+                   nome_tipo_tabela_paginas(processo->tabela_paginas.tipo), processo->num_paginas, bytes);
+            total += bytes;
         }
     }
+    printf("Total nos processos: %zu bytes\n", total);
+    if (gp->tabela_invertida) {
+        printf("Tabela invertida compartilhada: %zu bytes alocados (%d entradas, %d baldes)\n",
+               bytes_tabela_invertida(gp->tabela_invertida), gp->tabela_invertida->usados,
+               gp->tabela_invertida->num_baldes);
+    }
+    printf("==================================\n\n");
 }
 
 void visualizar_tabela_paginas(GerenciadorProcessos *gp, int id_processo) {
-    Processo *processo = encontrar_processo(gp, id_processo);
+    Processo *processo = adquirir_processo(gp, id_processo);
     if (!processo) {
-        printf("Erro: Processo %d nao encontrado.\n", id_processo);
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
         return;
     }
     
     printf("\n=== TABELA DE PAGINAS - PROCESSO %d ===\n", id_processo);
-    printf("Tamanho do processo: %d bytes\n", processo->tamanho);
+    printf("Tamanho do processo: %zu bytes\n", processo->tamanho);
     printf("Numero de paginas: %d\n", processo->num_paginas);
+    printf("Faltas de pagina: %d\n", processo->faltas_pagina);
+    printf("Representacao: %s (%zu bytes)\n", nome_tipo_tabela_paginas(processo->tabela_paginas.tipo),
+           bytes_tabela_paginas(&processo->tabela_paginas));
     printf("\n");
-    printf("Pagina | Quadro Fisico | Presente | Modificada\n");
-    printf("-------|---------------|----------|-----------\n");
+    printf("Pagina | Quadro Fisico | Presente | Modificada | Protecao | Compartilhada\n");
+    printf("-------|---------------|----------|------------|----------|--------------\n");
     
     for (int i = 0; i < processo->num_paginas; i++) {
-        EntradaTabelaPagina *entrada = &processo->tabela_paginas[i];
-        printf("%6d | %13d | %8s | %10s\n", 
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, i);
+        // Páginas sem entrada materializada nunca foram mapeadas e têm as permissões padrão
+        EntradaTabelaPagina valor = entrada ? *entrada : TP_ENTRADA_VAZIA;
+        printf("%6d | %13d | %8s | %10s | %c%c       | %s\n", 
                i,
-               entrada->quadro_fisico,
-               entrada->presente ? "Sim" : "Nao",
-               entrada->modificada ? "Sim" : "Nao");
+               entrada_quadro(valor),
+               entrada_tem(valor, TP_PRESENTE) ? "Sim" : "Nao",
+               entrada_tem(valor, TP_MODIFICADA) ? "Sim" : "Nao",
+               entrada_tem(valor, TP_LEITURA) ? 'r' : '-',
+               entrada_tem(valor, TP_ESCRITA) ? 'w' : '-',
+               entrada_tem(valor, TP_COPIA_NA_ESCRITA) ? "Sim" : "Nao");
     }
     
     printf("\n");
+    soltar_processo(gp, processo);
 }
 
 Processo* encontrar_processo(GerenciadorProcessos *gp, int id_processo) {
-    for (int i = 0; i < MAX_PROCESSOS; i++) {
-        if (gp->processos[i].ativo && gp->processos[i].id == id_processo) {
-            return &gp->processos[i];
-        }
-    }
-    return NULL;
+    travar_tabela_leitura(gp);
+    Processo *processo = procurar_processo(gp, id_processo);
+    destravar_tabela(gp);
+    return processo;
 }
 
 int remover_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo) {
-    Processo *processo = encontrar_processo(gp, id_processo);
+    Processo *processo = adquirir_processo(gp, id_processo);
     if (!processo) {
-        printf("Erro: Processo %d nao encontrado.\n", id_processo);
+        RELATAR_ERRO(ERRO_PROCESSO_INEXISTENTE, "Processo %d nao encontrado.\n", id_processo);
         return 0;
     }
+    // Inativo, o processo não é mais usado por nenhuma outra thread: as que o
+    // encontrarem no índice desistem ao revalidá-lo, então a liberação dispensa a trava
+    processo->ativo = 0;
+    soltar_processo(gp, processo);
     
-    printf("Removendo processo %d...\n", id_processo);
+    REGISTRAR_INFO("Removendo processo %d...\n", id_processo);
     
     // Libera os quadros físicos alocados
     for (int i = 0; i < processo->num_paginas; i++) {
-        if (processo->tabela_paginas[i].presente) {
-            liberar_quadro(mf, processo->tabela_paginas[i].quadro_fisico);
-            printf("  Quadro %d liberado\n", processo->tabela_paginas[i].quadro_fisico);
+        EntradaTabelaPagina *entrada = buscar_entrada_pagina(&processo->tabela_paginas, i);
+        if (entrada && entrada_tem(*entrada, TP_PRESENTE)) {
+            int quadro = entrada_quadro(*entrada);
+            soltar_quadro_da_pagina(gp, mf, processo, i, quadro);
+            REGISTRAR_DEPURACAO("  Quadro %d liberado\n", quadro);
         }
     }
     
+    if (gp->substituicao) {
+        substituicao_esquecer_processo(gp->substituicao, id_processo);
+    }
+    if (gp->tlb) {
+        tlb_invalidar_asid(gp->tlb, id_processo);
+    }
+    
     // Libera a memória do processo
+    liberar_slots_swap(gp, processo);
+    liberar_objetos_comprimidos(gp, processo);
     liberar_processo(processo);
-    
-    // Marca o slot como livre
-    processo->ativo = 0;
-    processo->id = 0;
     processo->tamanho = 0;
     processo->num_paginas = 0;
     
-    gp->num_processos--;
+    // Tira o processo do índice e devolve o slot à pilha
+    devolver_slot_processo(gp, processo);
+    if (gp->concorrente) {
+        __atomic_fetch_sub(&gp->num_processos, 1, __ATOMIC_RELAXED);
+    } else {
+        gp->num_processos--;
+    }
     
-    printf("Processo %d removido com sucesso.\n", id_processo);
+    REGISTRAR_INFO("Processo %d removido com sucesso.\n", id_processo);
     return 1;
 }
 
@@ -268,12 +1842,13 @@ void listar_processos(GerenciadorProcessos *gp) {
     printf("ID | Tamanho | Paginas | Status\n");
     printf("---|---------|---------|--------\n");
     
-    for (int i = 0; i < MAX_PROCESSOS; i++) {
-        if (gp->processos[i].ativo) {
-            printf("%2d | %7d | %7d | Ativo\n", 
-                   gp->processos[i].id,
-                   gp->processos[i].tamanho,
-                   gp->processos[i].num_paginas);
+    for (int i = 0; i < gp->capacidade_processos; i++) {
+        Processo *processo = processo_no_slot(gp, i);
+        if (processo->ativo) {
+            printf("%2d | %7zu | %7d | Ativo\n", 
+                   processo->id,
+                   processo->tamanho,
+                   processo->num_paginas);
         }
     }
     
@@ -283,13 +1858,23 @@ void listar_processos(GerenciadorProcessos *gp) {
 
 void liberar_processo(Processo *processo) {
     if (processo) {
-        if (processo->tabela_paginas) {
-            free(processo->tabela_paginas);
-            processo->tabela_paginas = NULL;
-        }
+        destruir_tabela_paginas(&processo->tabela_paginas);
         if (processo->memoria_logica) {
             free(processo->memoria_logica);
             processo->memoria_logica = NULL;
         }
+        if (processo->paginas_salvas) {
+            for (int i = 0; i < processo->num_paginas; i++) {
+                free(processo->paginas_salvas[i]);
+            }
+            free(processo->paginas_salvas);
+            processo->paginas_salvas = NULL;
+        }
+        free(processo->slots_swap);
+        processo->slots_swap = NULL;
+        free(processo->objetos_comprimidos);
+        processo->objetos_comprimidos = NULL;
+        liberar_estado_trabalho(processo->trabalho);
+        processo->trabalho = NULL;
     }
 } 
\ No newline at end of file
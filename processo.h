@@ -2,35 +2,112 @@
 #define PROCESSO_H
 
 #include "memoria.h"
+#include "tlb.h"
+#include "tabela_paginas.h"
+#include "paralelo.h"
+#include "swap.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <pthread.h>
 
-// Número máximo de processos suportados
-#define MAX_PROCESSOS 10
+// Slots de cada bloco da tabela de processos (a tabela cresce um bloco por vez)
+#define PROCESSOS_POR_BLOCO 64
+// Capacidade inicial do índice PID -> slot (dobra quando necessário)
+#define CAPACIDADE_INICIAL_INDICE 32
+// Bytes de imagem entregues a uma thread de cada vez na carga paralela dos processos
+#define BYTES_POR_BLOCO_CARGA (1024 * 1024)
 
-// Estrutura para representar uma entrada na tabela de páginas
-typedef struct {
-    int quadro_fisico;    // Índice do quadro físico onde a página está mapeada
-    int presente;         // 1 se a página está presente na memória física, 0 caso contrário
-    int modificada;       // 1 se a página foi modificada, 0 caso contrário
-} EntradaTabelaPagina;
+// Semente padrão do gerador de dados aleatórios dos processos
+#define SEMENTE_PADRAO 0x2545F4914F6CDD1DULL
+
+// Histórico de referências de um processo e rastreador do conjunto de trabalho (definidos em conjunto_trabalho.h)
+struct EstadoTrabalho;
+struct RastreadorTrabalho;
+// Compactação incremental dos quadros físicos (definida em compactacao.h)
+struct Compactador;
+// Deduplicação de páginas idênticas (definida em deduplicacao.h)
+struct Deduplicador;
+// Cache comprimido das páginas despejadas (definido em cache_comprimido.h)
+struct CacheComprimido;
 
 // Estrutura para representar um processo
 typedef struct {
     int id;                                    // ID único do processo
-    int tamanho;                              // Tamanho da memória lógica em bytes
-    unsigned char *memoria_logica;            // Memória lógica do processo
-    EntradaTabelaPagina *tabela_paginas;      // Tabela de páginas (alocada dinamicamente)
+    size_t tamanho;                           // Tamanho da memória lógica em bytes
+    unsigned char *memoria_logica;            // Memória lógica do processo (NULL nas imagens sem cópia)
+    unsigned char **paginas_salvas;           // Imagens sem cópia: páginas modificadas salvas no despejo
+    int *slots_swap;                          // Slot de swap de cada página (-1 se não está no swap; NULL se nenhuma está)
+    int *objetos_comprimidos;                 // Objeto do cache comprimido de cada página (-1 se não está; NULL se nenhuma está)
+    TabelaPaginas tabela_paginas;             // Tabela de páginas (representação escolhida na criação)
     int num_paginas;                          // Número de páginas utilizadas pelo processo
     int ativo;                                // 1 se o processo está ativo, 0 caso contrário
+    uint64_t semente;                         // Semente da imagem do processo (semente global + ID)
+    uint64_t semente_comum;                   // Semente do início da imagem, igual em todos os processos
+    size_t bytes_comuns;                      // Bytes do início da imagem gerados com semente_comum
+    int percentual_entropia;                  // Percentual das palavras da imagem que são aleatórias (as demais são zero)
+    int faltas_pagina;                        // Número de faltas de página do processo
+    int paginas_presentes;                    // Páginas mapeadas em quadros
+    struct EstadoTrabalho *trabalho;          // Histórico de referências (NULL sem o rastreador do conjunto de trabalho)
+    int slot;                                 // Posição fixa do processo na tabela de processos
+    pthread_mutex_t trava;                    // Modo concorrente: serializa as operações sobre o processo
 } Processo;
 
+// Posição do índice de processos (endereçamento aberto com sondagem linear)
+typedef struct {
+    int pid;                                  // ID do processo
+    int slot;                                 // Slot em processos (-1 se a posição está vazia)
+} EntradaIndiceProcesso;
+
+// Tempo acumulado nas etapas de criação de processos e de carga de páginas
+// (a alocação de quadros é medida em EstatisticasAlocacao, na memória física)
+typedef struct {
+    long long tempo_tabela_ns;                // Criação e preenchimento inicial das tabelas de páginas
+    long long tempo_geracao_ns;               // Geração das imagens (na memória lógica ou nos quadros)
+    long long tempo_copia_ns;                 // Cópia de páginas da memória lógica para os quadros
+    long long tempo_faltas_ns;                // Tratamento de faltas de página, incluindo despejo e carga
+    long long tempo_fork_ns;                  // Duplicação de processos por fork (sem as cópias na escrita)
+    long long tempo_swap_ns;                  // Leitura de páginas do swap nas faltas
+    long long tempo_descompressao_ns;         // Descompressão de páginas do cache comprimido nas faltas
+} EstatisticasProcessos;
+
+// Mecanismo de substituição de páginas (definido em substituicao.h)
+struct Substituidor;
+
 // Estrutura para gerenciar todos os processos
 typedef struct {
-    Processo processos[MAX_PROCESSOS];
+    Processo **blocos_processos;              // Tabela de processos em blocos que nunca mudam de lugar
+    int capacidade_blocos;                    // Posições em blocos_processos
+    int capacidade_processos;                 // Slots alocados (blocos * PROCESSOS_POR_BLOCO)
+    int *slots_livres;                        // Pilha de slots livres
+    int num_slots_livres;                     // Slots na pilha de livres
+    EntradaIndiceProcesso *indice;            // Índice hash PID -> slot
+    int capacidade_indice;                    // Posições do índice (potência de dois)
+    int ocupacao_indice;                      // PIDs no índice (processos ativos e em criação)
     int num_processos;
     int proximo_id;
+    uint64_t semente;                         // Semente global usada para gerar as imagens dos processos
+    int percentual_imagem_comum;              // Percentual do início das imagens igual em todos os processos
+    int percentual_entropia;                  // Percentual das palavras aleatórias nas imagens dos novos processos
+    int paginacao_sob_demanda;                // 1 se novos processos são criados sem páginas carregadas
+    int imagens_sem_copia;                    // 1 se novos processos não têm memória lógica própria
+    long long total_faltas_pagina;            // Faltas de página de todos os processos
+    long long total_forks;                    // Processos criados por fork
+    long long total_copias_na_escrita;        // Páginas compartilhadas copiadas na primeira escrita
+    struct Substituidor *substituicao;        // Substituição de páginas e mapa reverso dos quadros
+    TLB *tlb;                                 // TLB simulada (NULL se desativada)
+    TipoTabelaPaginas tipo_tabela;            // Representação da tabela de páginas dos novos processos
+    TabelaInvertida *tabela_invertida;        // Tabela invertida compartilhada (criada no primeiro uso)
+    EstatisticasProcessos estatisticas;       // Tempo gasto em cada etapa
+    int concorrente;                          // 1 se várias threads podem operar ao mesmo tempo
+    pthread_rwlock_t trava_tabela;            // Modo concorrente: protege o índice, os slots e os blocos
+    pthread_mutex_t trava_substituicao;       // Modo concorrente: protege os contadores do substituidor
+    PoolThreads *pool_carga;                  // Threads que geram e copiam as imagens (NULL = só a que chama)
+    DispositivoSwap *swap;                    // Área de swap das páginas modificadas despejadas (NULL = desativada)
+    struct RastreadorTrabalho *conjunto_trabalho; // Amostragem do conjunto de trabalho e controle PFF (NULL = desativados)
+    struct Compactador *compactacao;          // Compactação dos quadros físicos (NULL = desativada)
+    struct Deduplicador *deduplicacao;        // Deduplicação de páginas idênticas (NULL = desativada)
+    struct CacheComprimido *cache_comprimido; // Cache comprimido das páginas despejadas (NULL = desativado)
 } GerenciadorProcessos;
 
 // Funções de gerenciamento de processos
@@ -42,6 +119,58 @@ typedef struct {
  */
 void inicializar_gerenciador_processos(GerenciadorProcessos *gp);
 
+/**
+ * @brief Remove todos os processos e libera as estruturas do gerenciador.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ */
+void finalizar_gerenciador_processos(GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Retorna o mecanismo de substituição do gerenciador, criando-o no primeiro uso.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @return Ponteiro para o substituidor, ou NULL em caso de erro.
+ */
+struct Substituidor* obter_substituidor(GerenciadorProcessos *gp, MemoriaFisica *mf);
+
+/**
+ * @brief Ativa o modo concorrente, em que várias threads criam, removem e acessam processos ao mesmo tempo.
+ * 
+ * A memória física passa a usar a alocação concorrente, com um cache de
+ * quadros por CPU (veja ativar_alocacao_concorrente). O índice e os slots da
+ * tabela de processos ficam sob uma trava de leitura e escrita, tomada só nas
+ * buscas e, brevemente, na reserva e na liberação de slots; a construção e a
+ * destruição de um processo acontecem fora dela. Cada processo tem sua própria
+ * trava, que serializa as traduções, faltas e acessos a ele. Como os blocos da
+ * tabela nunca são liberados, a trava de um processo pode ser tomada depois da
+ * busca, e o processo é revalidado em seguida.
+ * 
+ * O modo exige a substituição de páginas, a TLB, o rastreador do conjunto de
+ * trabalho, a compactação, a deduplicação e o cache comprimido desativados e
+ * tabelas de páginas por processo (lineares ou de dois níveis), pois o
+ * substituidor, a TLB e a tabela invertida são compartilhados. Também exige
+ * que nenhum quadro esteja compartilhado, e fork_processo é recusado enquanto
+ * o modo estiver ativo. Cada thread deve chamar definir_cpu_atual com um
+ * número de CPU próprio.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param num_cpus Número de CPUs (threads de trabalho).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int ativar_modo_concorrente(GerenciadorProcessos *gp, MemoriaFisica *mf, int num_cpus);
+
+/**
+ * @brief Desativa o modo concorrente, depois que todas as threads de trabalho terminaram.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ */
+void desativar_modo_concorrente(GerenciadorProcessos *gp, MemoriaFisica *mf);
+
 /**
  * @brief Cria um novo processo com valores aleatórios na memória lógica.
  * 
@@ -53,7 +182,34 @@ void inicializar_gerenciador_processos(GerenciadorProcessos *gp);
  * @param tamanho_max_processo Tamanho máximo do processo em bytes.
  * @return ID do processo criado, ou -1 se falhar.
  */
-int criar_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, int tamanho, int tamanho_pagina, int tamanho_max_processo);
+int criar_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, size_t tamanho, int tamanho_pagina, size_t tamanho_max_processo);
+
+/**
+ * @brief Cria uma cópia de um processo que compartilha os quadros do original (fork com cópia na escrita).
+ * 
+ * As páginas presentes dos dois processos passam a apontar para os mesmos
+ * quadros, marcadas com TP_COPIA_NA_ESCRITA, e cada quadro ganha um
+ * mapeamento a mais (compartilhar_quadro). A primeira escrita de qualquer um
+ * dos processos em uma dessas páginas copia o quadro para um novo, privado;
+ * se o processo já for o único a mapeá-lo, basta desmarcar a página. O custo
+ * é proporcional ao tamanho da tabela de páginas, não ao do processo.
+ * 
+ * O filho herda a semente do original e não tem memória lógica própria: as
+ * páginas ausentes são geradas de novo na falta, e só as ausentes cujo
+ * conteúdo está guardado fora da memória física (gravadas em um despejo) são
+ * copiadas para buffers do filho. O filho usa a mesma representação de tabela
+ * de páginas do original.
+ * 
+ * O fork não é suportado no modo concorrente: soltar um quadro compartilhado
+ * procura os outros processos que o mapeiam percorrendo a tabela de processos.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param id_processo ID do processo original.
+ * @param id_filho ID do novo processo.
+ * @return ID do processo criado, ou -1 se falhar.
+ */
+int fork_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, int id_filho);
 
 /**
  * @brief Aloca quadros físicos para as páginas de um processo.
@@ -68,12 +224,289 @@ int alocar_quadros_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_
 /**
  * @brief Copia dados da memória lógica para a memória física.
  * 
+ * Se o processo não tiver memória lógica (imagens sem cópia), o conteúdo das
+ * páginas presentes é gerado diretamente nos quadros.
+ * 
  * @param gp Ponteiro para o gerenciador de processos.
  * @param mf Ponteiro para a memória física.
  * @param id_processo ID do processo.
  */
 void copiar_memoria_logica_para_fisica(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo);
 
+/**
+ * @brief Ativa ou desativa a paginação sob demanda para os próximos processos.
+ * 
+ * Com a paginação sob demanda, criar_processo não reserva quadros nem gera
+ * dados: todas as páginas começam ausentes e são carregadas na primeira
+ * falta. A soma dos tamanhos dos processos pode então exceder a memória física.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param ativa 1 para ativar, 0 para desativar.
+ */
+void definir_paginacao_sob_demanda(GerenciadorProcessos *gp, int ativa);
+
+/**
+ * @brief Ativa ou desativa as imagens sem cópia para os próximos processos.
+ * 
+ * Nesse modo o processo não tem memória lógica: sua imagem é gerada direto nos
+ * quadros físicos e só as páginas modificadas que forem despejadas ganham uma
+ * cópia fora da memória física. Cada processo passa a ocupar cerca de metade
+ * da memória do hospedeiro.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param ativa 1 para ativar, 0 para desativar.
+ */
+void definir_imagens_sem_copia(GerenciadorProcessos *gp, int ativa);
+
+/**
+ * @brief Define quantas threads geram e copiam as imagens dos novos processos.
+ * 
+ * Na criação com carregamento antecipado, as páginas do processo são divididas
+ * em blocos de BYTES_POR_BLOCO_CARGA bytes; cada thread gera o trecho da
+ * memória lógica de um bloco e o copia em seguida para os quadros (ou o gera
+ * direto nos quadros, nas imagens sem cópia). Como cada palavra da imagem
+ * depende só da semente e da sua posição, o conteúdo é o mesmo para qualquer
+ * número de threads. Com várias threads, tempo_geracao_ns e tempo_copia_ns
+ * somam o tempo de todas elas.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param num_threads Número de threads, contando a que cria o processo (1 = sem pool).
+ * @return 1 se sucesso, 0 se falhar (a configuração anterior é mantida).
+ */
+int definir_threads_carga(GerenciadorProcessos *gp, int num_threads);
+
+/**
+ * @brief Ativa, troca ou desativa a área de swap.
+ * 
+ * Com o swap ativo, as páginas modificadas escolhidas pela substituição (e
+ * recusadas pelo cache comprimido, se houver) são gravadas nele em vez de na
+ * memória lógica (ou nos buffers das imagens sem cópia) e voltam dele na
+ * próxima falta. As gravações são assíncronas, feitas
+ * por uma thread de E/S em lotes; a leitura na falta é síncrona. Se o swap
+ * encher, as páginas seguintes voltam a ser guardadas na memória do hospedeiro.
+ * Só troca ou desativa um swap que não guarda nenhuma página.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física (define o tamanho dos slots).
+ * @param tamanho Tamanho da área em bytes (0 para desativar o swap).
+ * @param arquivo Arquivo de apoio, ou NULL para uma região da memória do hospedeiro.
+ * @param latencia_ns Latência simulada de cada leitura ou escrita, em nanossegundos.
+ * @param bytes_por_segundo Largura de banda simulada (0 para ilimitada).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int configurar_swap(GerenciadorProcessos *gp, MemoriaFisica *mf, size_t tamanho, const char *arquivo,
+                    long long latencia_ns, long long bytes_por_segundo);
+
+/**
+ * @brief Ativa, troca ou desativa o cache comprimido das páginas despejadas.
+ * 
+ * Com o cache ativo, as páginas modificadas escolhidas pela substituição são
+ * comprimidas e guardadas em `quadros` quadros reservados da memória física
+ * (veja cache_comprimido.h) e descomprimidas na próxima falta. As páginas
+ * recusadas, por não comprimirem até o limite ou por falta de espaço, seguem
+ * para o swap ou para a memória do hospedeiro. Só troca ou desativa um cache
+ * que não guarda nenhuma página; se a criação do novo falhar, o cache fica
+ * desativado.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param quadros Quadros reservados para o cache (0 para desativar).
+ * @param limite_percentual Maior tamanho comprimido aceito, em percentual da página.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int configurar_cache_comprimido(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadros, int limite_percentual);
+
+/**
+ * @brief Ativa, troca ou desativa o rastreador do conjunto de trabalho.
+ * 
+ * A cada `intervalo` acessos (de todos os processos), as páginas presentes
+ * são percorridas e as que tiverem o bit de referência ligado são anotadas na
+ * amostra e têm o bit limpo. O conjunto de trabalho de um processo são as
+ * páginas referenciadas nas últimas `janela` amostras. O controle PFF é
+ * ligado em seguida com configurar_controle_pff. Trocar o rastreador descarta
+ * o histórico e os orçamentos dos processos.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param intervalo Acessos entre duas amostras (0 para desativar).
+ * @param janela Amostras na janela do conjunto de trabalho.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int configurar_conjunto_trabalho(GerenciadorProcessos *gp, int intervalo, int janela);
+
+/**
+ * @brief Despeja páginas de um processo, escolhidas pelo rastreador do conjunto de trabalho, até restarem no máximo `limite`.
+ * 
+ * As páginas gravadas seguem o caminho de um despejo comum (swap, memória
+ * lógica ou buffer). Um quadro compartilhado é despejado de todos os
+ * processos que o mapeiam.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param processo Ponteiro para o processo.
+ * @param limite Páginas presentes que podem ficar.
+ * @return Número de páginas despejadas.
+ */
+int reduzir_paginas_residentes(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, int limite);
+
+/**
+ * @brief Ativa, troca ou desativa a compactação dos quadros físicos.
+ * 
+ * Cada passo migra no máximo `quadros_por_passo` quadros ocupados para o fim
+ * da memória (veja compactacao.h). Com `intervalo` maior que zero, um passo é
+ * executado a cada `intervalo` operações do modo em lote.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param quadros_por_passo Migrações permitidas em um passo (0 para desativar).
+ * @param intervalo Operações entre dois passos automáticos (0 para só compactar sob pedido).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int configurar_compactacao(GerenciadorProcessos *gp, int quadros_por_passo, int intervalo);
+
+/**
+ * @brief Migra a página de um quadro ocupado para um quadro livre.
+ * 
+ * O conteúdo e os compartilhamentos passam ao destino, e as entradas de todos
+ * as páginas que mapeiam o quadro (a dona do mapa reverso e as que o
+ * compartilham por fork ou deduplicação) passam a apontar para ele, com os
+ * mesmos bits. As traduções antigas são retiradas da TLB, e o substituidor
+ * transfere ao destino a posição e o histórico da origem.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param origem Quadro ocupado, com dono no mapa reverso.
+ * @param destino Quadro livre.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int realocar_quadro(GerenciadorProcessos *gp, MemoriaFisica *mf, int origem, int destino);
+
+/**
+ * @brief Ativa, troca ou desativa a deduplicação de páginas idênticas.
+ * 
+ * Cada passo examina `quadros_por_passo` quadros da varredura (veja
+ * deduplicacao.h). Com `intervalo` maior que zero, um passo é executado a
+ * cada `intervalo` operações do modo em lote.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param quadros_por_passo Quadros examinados em um passo (0 para desativar).
+ * @param intervalo Operações entre dois passos automáticos (0 para só deduplicar sob pedido).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int configurar_deduplicacao(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadros_por_passo, int intervalo);
+
+/**
+ * @brief Faz as páginas de um quadro passarem a mapear outro de mesmo conteúdo.
+ * 
+ * As páginas podem ter números diferentes e ser do mesmo processo. As
+ * entradas de todas as páginas que mapeiam `quadro` passam a apontar para
+ * `destino`, e as de ambos ganham a cópia na escrita, como depois de um fork:
+ * a primeira escrita de qualquer um deles volta a dar à página um quadro
+ * próprio. `quadro` é liberado. O conteúdo não é conferido aqui.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param quadro Quadro ocupado, com dono no mapa reverso, que será liberado.
+ * @param destino Quadro ocupado que passa a ser compartilhado.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int mesclar_quadros(GerenciadorProcessos *gp, MemoriaFisica *mf, int quadro, int destino);
+
+/**
+ * @brief Trata uma falta de página, alocando um quadro e carregando a página nele.
+ * 
+ * Se não houver quadro livre e uma política de substituição estiver ativa,
+ * uma página é despejada para dar lugar à nova. Com o controle PFF, um
+ * processo que já ocupa todo o seu orçamento despeja antes uma página própria.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param processo Ponteiro para o processo (no modo concorrente, com sua trava tomada).
+ * @param pagina Número da página ausente.
+ * @return O quadro onde a página foi carregada, ou -1 se não for possível obter um quadro.
+ */
+int tratar_falta_pagina(GerenciadorProcessos *gp, MemoriaFisica *mf, Processo *processo, int pagina);
+
+/**
+ * @brief Traduz um endereço lógico de um processo para o endereço físico.
+ * 
+ * A TLB, se configurada, é consultada primeiro; em caso de falta, a tabela de
+ * páginas é percorrida e a tradução é inserida na TLB. Se a página não estiver
+ * presente, uma falta de página é tratada antes da tradução.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param id_processo ID do processo.
+ * @param endereco_logico Endereço lógico dentro do processo.
+ * @return O endereço físico correspondente, ou -1 se falhar.
+ */
+int64_t traduzir_endereco(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, uint64_t endereco_logico);
+
+/**
+ * @brief Lê um byte do espaço de endereçamento lógico de um processo.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param id_processo ID do processo.
+ * @param endereco_logico Endereço lógico dentro do processo.
+ * @return O byte lido (0 a 255), ou -1 se a tradução falhar ou a leitura não for permitida.
+ */
+int ler_logico(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, uint64_t endereco_logico);
+
+/**
+ * @brief Escreve um byte no espaço de endereçamento lógico de um processo, marcando a página como modificada.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param mf Ponteiro para a memória física.
+ * @param id_processo ID do processo.
+ * @param endereco_logico Endereço lógico dentro do processo.
+ * @param valor O byte a ser escrito.
+ * @return 1 se sucesso, 0 se a tradução falhar ou a escrita não for permitida.
+ */
+int escrever_logico(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_processo, uint64_t endereco_logico, unsigned char valor);
+
+/**
+ * @brief Define as permissões de acesso de uma página de um processo.
+ * 
+ * Acessos a páginas sem a permissão correspondente falham em ler_logico e escrever_logico.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param id_processo ID do processo.
+ * @param pagina Número da página.
+ * @param leitura 1 para permitir leitura.
+ * @param escrita 1 para permitir escrita.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int definir_protecao_pagina(GerenciadorProcessos *gp, int id_processo, int pagina, int leitura, int escrita);
+
+/**
+ * @brief Configura a TLB usada nas traduções de endereço.
+ * 
+ * A TLB anterior, se houver, é descartada. Com num_entradas igual a 0 a TLB é desativada.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param num_entradas Número total de entradas.
+ * @param associatividade Entradas por conjunto.
+ * @param limpar_na_troca 1 para esvaziar a TLB a cada troca de contexto.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int configurar_tlb(GerenciadorProcessos *gp, int num_entradas, int associatividade, int limpar_na_troca);
+
+/**
+ * @brief Define a representação da tabela de páginas dos processos criados a seguir.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param tipo Representação desejada.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int definir_tipo_tabela_paginas(GerenciadorProcessos *gp, TipoTabelaPaginas tipo);
+
+/**
+ * @brief Exibe a memória ocupada pelas tabelas de páginas dos processos ativos.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ */
+void exibir_uso_tabelas_paginas(GerenciadorProcessos *gp);
+
 /**
  * @brief Visualiza a tabela de páginas de um processo.
  * 
@@ -85,12 +518,25 @@ void visualizar_tabela_paginas(GerenciadorProcessos *gp, int id_processo);
 /**
  * @brief Encontra um processo pelo ID.
  * 
+ * A busca usa o índice hash e tem custo constante. Os slots nunca mudam de
+ * lugar, mas no modo concorrente o processo pode ser removido por outra thread
+ * logo após a busca; as operações por ID revalidam o processo sob sua trava.
+ * 
  * @param gp Ponteiro para o gerenciador de processos.
  * @param id_processo ID do processo.
  * @return Ponteiro para o processo, ou NULL se não encontrado.
  */
 Processo* encontrar_processo(GerenciadorProcessos *gp, int id_processo);
 
+/**
+ * @brief Retorna o processo de um slot da tabela, ativo ou não.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param slot Slot, de 0 a capacidade_processos - 1.
+ * @return Ponteiro para o processo do slot.
+ */
+Processo* processo_no_slot(GerenciadorProcessos *gp, int slot);
+
 /**
  * @brief Remove um processo e libera seus quadros.
  * 
@@ -108,6 +554,44 @@ int remover_processo(GerenciadorProcessos *gp, MemoriaFisica *mf, int id_process
  */
 void listar_processos(GerenciadorProcessos *gp);
 
+/**
+ * @brief Define a semente global dos dados gerados para novos processos.
+ * 
+ * A mesma semente e o mesmo ID produzem sempre a mesma imagem de processo.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param semente Nova semente.
+ */
+void definir_semente_processos(GerenciadorProcessos *gp, uint64_t semente);
+
+/**
+ * @brief Define que parte das imagens de novos processos é igual em todos eles.
+ * 
+ * As páginas do início da imagem, até o percentual do tamanho, são geradas
+ * com uma semente comum a todos os processos, como o código de um mesmo
+ * programa ou de bibliotecas carregadas em todos, e o restante com a semente
+ * do processo.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param percentual Percentual da imagem igual em todos os processos (0 a 100).
+ * @return 1 se sucesso, 0 se o percentual for inválido.
+ */
+int definir_imagem_comum(GerenciadorProcessos *gp, int percentual);
+
+/**
+ * @brief Define a entropia das imagens de novos processos.
+ * 
+ * Cada palavra de 64 bits da imagem é aleatória com a probabilidade dada e
+ * zero no restante, escolha feita de forma determinística pela própria
+ * palavra gerada. Com 100%, o padrão, as páginas são incompressíveis; abaixo
+ * disso, se aproximam das taxas de compressão de memórias reais.
+ * 
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param percentual Percentual das palavras aleatórias (0 a 100).
+ * @return 1 se sucesso, 0 se o percentual for inválido.
+ */
+int definir_entropia_imagens(GerenciadorProcessos *gp, int percentual);
+
 /**
  * @brief Gera dados aleatórios para a memória lógica de um processo.
  * 
@@ -115,14 +599,30 @@ void listar_processos(GerenciadorProcessos *gp);
  */
 void gerar_dados_aleatorios_processo(Processo *processo);
 
+/**
+ * @brief Gera um trecho da imagem aleatória de um processo.
+ * 
+ * O gerador é baseado em contador (splitmix64): cada palavra de 64 bits da
+ * imagem depende apenas da semente do processo (ou da semente comum, no
+ * início da imagem) e da sua posição, então
+ * qualquer intervalo pode ser gerado de forma independente (por exemplo,
+ * página a página ou em paralelo) com o mesmo resultado.
+ * 
+ * @param processo Ponteiro para o processo.
+ * @param destino Buffer que recebe os bytes gerados.
+ * @param deslocamento Endereço lógico do primeiro byte a gerar.
+ * @param bytes Número de bytes a gerar.
+ */
+void gerar_dados_aleatorios_intervalo(Processo *processo, unsigned char *destino, size_t deslocamento, size_t bytes);
+
 /**
  * @brief Calcula o número de páginas necessárias para um tamanho de processo.
  * 
  * @param tamanho Tamanho do processo em bytes.
  * @param tamanho_pagina Tamanho da página em bytes.
- * @return Número de páginas necessárias.
+ * @return Número de páginas necessárias, ou -1 se passar do limite de um int.
  */
-int calcular_num_paginas(int tamanho, int tamanho_pagina);
+int calcular_num_paginas(size_t tamanho, int tamanho_pagina);
 
 /**
  * @brief Libera a memória alocada para um processo.
@@ -0,0 +1,25 @@
+#include "registro.h"
+#include <stdarg.h>
+
+int nivel_registro = REGISTRO_DEPURACAO;
+
+void definir_nivel_registro(int nivel) {
+    if (nivel < REGISTRO_DESLIGADO) {
+        nivel = REGISTRO_DESLIGADO;
+    } else if (nivel > REGISTRO_DEPURACAO) {
+        nivel = REGISTRO_DEPURACAO;
+    }
+    nivel_registro = nivel;
+}
+
+void registrar(int nivel, const char *formato, ...) {
+    if (nivel == REGISTRO_ERRO) {
+        fputs("Erro: ", stdout);
+    } else if (nivel == REGISTRO_AVISO) {
+        fputs("Aviso: ", stdout);
+    }
+    va_list argumentos;
+    va_start(argumentos, formato);
+    vprintf(formato, argumentos);
+    va_end(argumentos);
+}
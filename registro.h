@@ -0,0 +1,60 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <stdio.h>
+#include <time.h>
+
+// Níveis de registro, do mais restrito ao mais detalhado
+#define REGISTRO_DESLIGADO 0          // Nenhuma mensagem
+#define REGISTRO_ERRO      1          // Falhas de operações
+#define REGISTRO_AVISO     2          // Situações anormais que não impedem a operação
+#define REGISTRO_INFO      3          // Eventos de processos e de configuração
+#define REGISTRO_DEPURACAO 4          // Eventos por quadro ou página (alocações, cópias, faltas, despejos)
+
+// Nível máximo compilado; mensagens acima dele são eliminadas pelo compilador.
+// Ex.: -DREGISTRO_NIVEL_MAXIMO=REGISTRO_ERRO remove as mensagens dos caminhos críticos.
+#ifndef REGISTRO_NIVEL_MAXIMO
+#define REGISTRO_NIVEL_MAXIMO REGISTRO_DEPURACAO
+#endif
+
+// Nível em vigor durante a execução (REGISTRO_DEPURACAO por padrão)
+extern int nivel_registro;
+
+/**
+ * @brief Define o nível de registro em vigor durante a execução.
+ *
+ * @param nivel Um dos níveis REGISTRO_*; valores fora do intervalo são limitados a ele.
+ */
+void definir_nivel_registro(int nivel);
+
+/**
+ * @brief Exibe uma mensagem, no formato de printf, com o prefixo do nível
+ * ("Erro: ", "Aviso: "). Use as macros REGISTRAR_*, que testam o nível antes.
+ *
+ * @param nivel Nível da mensagem.
+ * @param formato Formato da mensagem, seguido dos argumentos.
+ */
+void registrar(int nivel, const char *formato, ...) __attribute__((format(printf, 2, 3)));
+
+// Testa os níveis de compilação e de execução; com o primeiro teste constante,
+// a chamada inteira (incluindo a avaliação dos argumentos) desaparece do código gerado
+#define REGISTRAR_NIVEL(nivel, ...) \
+    do { \
+        if ((nivel) <= REGISTRO_NIVEL_MAXIMO && (nivel) <= nivel_registro) { \
+            registrar((nivel), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define REGISTRAR_ERRO(...)      REGISTRAR_NIVEL(REGISTRO_ERRO, __VA_ARGS__)
+#define REGISTRAR_AVISO(...)     REGISTRAR_NIVEL(REGISTRO_AVISO, __VA_ARGS__)
+#define REGISTRAR_INFO(...)      REGISTRAR_NIVEL(REGISTRO_INFO, __VA_ARGS__)
+#define REGISTRAR_DEPURACAO(...) REGISTRAR_NIVEL(REGISTRO_DEPURACAO, __VA_ARGS__)
+
+// Relógio monotônico em nanossegundos, usado nas medições de tempo dos módulos
+static inline long long agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif // REGISTRO_H
@@ -0,0 +1,531 @@
+#include "substituicao.h"
+#include <string.h>
+
+// Identificadores das listas em que um nó pode estar
+enum {
+    LISTA_NENHUMA = -1,
+    LISTA_FIFO = 0,
+    LISTA_T1 = 1,
+    LISTA_T2 = 2,
+    LISTA_B1 = 3,
+    LISTA_B2 = 4
+};
+
+static ListaSubstituicao* lista_por_id(Substituidor *s, int id) {
+    switch (id) {
+        case LISTA_FIFO: return &s->fifo;
+        case LISTA_T1:   return &s->t1;
+        case LISTA_T2:   return &s->t2;
+        case LISTA_B1:   return &s->b1;
+        case LISTA_B2:   return &s->b2;
+        default:         return NULL;
+    }
+}
+
+static void lista_limpar(ListaSubstituicao *lista) {
+    lista->cabeca = -1;
+    lista->cauda = -1;
+    lista->tamanho = 0;
+}
+
+// Insere um nó como o mais recente da lista
+static void lista_inserir(Substituidor *s, int id_lista, int no) {
+    ListaSubstituicao *lista = lista_por_id(s, id_lista);
+    s->ant[no] = -1;
+    s->prox[no] = lista->cabeca;
+    if (lista->cabeca != -1) {
+        s->ant[lista->cabeca] = no;
+    } else {
+        lista->cauda = no;
+    }
+    lista->cabeca = no;
+    lista->tamanho++;
+    s->lista_do_no[no] = (signed char)id_lista;
+}
+
+// Retira um nó da lista em que ele estiver
+static void lista_remover(Substituidor *s, int no) {
+    ListaSubstituicao *lista = lista_por_id(s, s->lista_do_no[no]);
+    if (!lista) {
+        return;
+    }
+    if (s->ant[no] != -1) {
+        s->prox[s->ant[no]] = s->prox[no];
+    } else {
+        lista->cabeca = s->prox[no];
+    }
+    if (s->prox[no] != -1) {
+        s->ant[s->prox[no]] = s->ant[no];
+    } else {
+        lista->cauda = s->ant[no];
+    }
+    lista->tamanho--;
+    s->lista_do_no[no] = LISTA_NENHUMA;
+}
+
+// Entrada da tabela de páginas do dono de um quadro, ou NULL se o quadro está livre
+static EntradaTabelaPagina* entrada_do_quadro(Substituidor *s, GerenciadorProcessos *gp, int quadro) {
+    if (s->dono_pid[quadro] == -1) {
+        return NULL;
+    }
+    Processo *processo = encontrar_processo(gp, s->dono_pid[quadro]);
+    if (!processo) {
+        return NULL;
+    }
+    return buscar_entrada_pagina(&processo->tabela_paginas, s->dono_pagina[quadro]);
+}
+
+// Consome a referência de um quadro: o bit da entrada ou a marca deixada pela
+// amostragem. Um bit ligado deixa por sua vez a marca para a amostragem.
+static int consumir_referencia(Substituidor *s, EntradaTabelaPagina *entrada, int quadro) {
+    int referenciada = (s->referencias_colhidas[quadro] & REFERENCIA_PARA_POLITICA) != 0;
+    s->referencias_colhidas[quadro] &= ~REFERENCIA_PARA_POLITICA;
+    if (entrada_tem(*entrada, TP_REFERENCIADA)) {
+        entrada_desativar(entrada, TP_REFERENCIADA);
+        s->referencias_colhidas[quadro] |= REFERENCIA_PARA_AMOSTRA;
+        referenciada = 1;
+    }
+    return referenciada;
+}
+
+// ---------------------------------------------------------------------------
+// Entradas fantasmas do ARC (páginas despejadas recentemente, só a chave)
+// ---------------------------------------------------------------------------
+
+static int hash_fantasma(Substituidor *s, int id_processo, int pagina) {
+    uint32_t h = (uint32_t)id_processo * 0x9E3779B1u ^ (uint32_t)pagina * 0x85EBCA6Bu;
+    h ^= h >> 16;
+    return (int)(h & (uint32_t)(s->tamanho_hash - 1));
+}
+
+static int buscar_fantasma(Substituidor *s, int id_processo, int pagina) {
+    for (int g = s->hash_cabeca[hash_fantasma(s, id_processo, pagina)]; g != -1; g = s->hash_prox[g - s->numero_quadros]) {
+        int i = g - s->numero_quadros;
+        if (s->fantasma_pid[i] == id_processo && s->fantasma_pagina[i] == pagina) {
+            return g;
+        }
+    }
+    return -1;
+}
+
+static void remover_fantasma(Substituidor *s, int g) {
+    int i = g - s->numero_quadros;
+    int *elo = &s->hash_cabeca[hash_fantasma(s, s->fantasma_pid[i], s->fantasma_pagina[i])];
+    while (*elo != g) {
+        elo = &s->hash_prox[*elo - s->numero_quadros];
+    }
+    *elo = s->hash_prox[i];
+    lista_remover(s, g);
+    s->fantasmas_livres[s->num_fantasmas_livres++] = g;
+}
+
+static void adicionar_fantasma(Substituidor *s, int id_lista, int id_processo, int pagina) {
+    if (s->num_fantasmas_livres == 0) {
+        // Descarta o fantasma mais antigo da maior lista para abrir espaço
+        ListaSubstituicao *maior = s->b1.tamanho >= s->b2.tamanho ? &s->b1 : &s->b2;
+        remover_fantasma(s, maior->cauda);
+    }
+    int g = s->fantasmas_livres[--s->num_fantasmas_livres];
+    int i = g - s->numero_quadros;
+    s->fantasma_pid[i] = id_processo;
+    s->fantasma_pagina[i] = pagina;
+    int h = hash_fantasma(s, id_processo, pagina);
+    s->hash_prox[i] = s->hash_cabeca[h];
+    s->hash_cabeca[h] = g;
+    lista_inserir(s, id_lista, g);
+}
+
+// ---------------------------------------------------------------------------
+// Criação e troca de política
+// ---------------------------------------------------------------------------
+
+static void liberar_estruturas_politica(Substituidor *s) {
+    free(s->prox);
+    free(s->ant);
+    free(s->lista_do_no);
+    free(s->idade);
+    free(s->fantasma_pid);
+    free(s->fantasma_pagina);
+    free(s->fantasmas_livres);
+    free(s->hash_cabeca);
+    free(s->hash_prox);
+    s->prox = NULL;
+    s->ant = NULL;
+    s->lista_do_no = NULL;
+    s->idade = NULL;
+    s->fantasma_pid = NULL;
+    s->fantasma_pagina = NULL;
+    s->fantasmas_livres = NULL;
+    s->hash_cabeca = NULL;
+    s->hash_prox = NULL;
+    s->num_nos = 0;
+}
+
+Substituidor* criar_substituidor(int numero_quadros) {
+    Substituidor *s = (Substituidor*)calloc(1, sizeof(Substituidor));
+    if (!s) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o mecanismo de substituicao.\n");
+        return NULL;
+    }
+
+    s->numero_quadros = numero_quadros;
+    s->dono_pid = (int*)malloc(numero_quadros * sizeof(int));
+    s->dono_pagina = (int*)malloc(numero_quadros * sizeof(int));
+    s->referencias_colhidas = (unsigned char*)calloc(numero_quadros, sizeof(unsigned char));
+    if (!s->dono_pid || !s->dono_pagina || !s->referencias_colhidas) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o mapa reverso de quadros.\n");
+        destruir_substituidor(s);
+        return NULL;
+    }
+    for (int q = 0; q < numero_quadros; q++) {
+        s->dono_pid[q] = -1;
+        s->dono_pagina[q] = -1;
+    }
+
+    s->politica = SUBSTITUICAO_NENHUMA;
+    s->vitima_pendente = -1;
+    return s;
+}
+
+void destruir_substituidor(Substituidor *s) {
+    if (s) {
+        liberar_estruturas_politica(s);
+        free(s->dono_pid);
+        free(s->dono_pagina);
+        free(s->referencias_colhidas);
+        free(s);
+    }
+}
+
+int definir_politica_substituicao(Substituidor *s, PoliticaSubstituicao politica) {
+    if (politica < SUBSTITUICAO_NENHUMA || politica > SUBSTITUICAO_ARC) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Politica de substituicao invalida (%d).\n", politica);
+        return 0;
+    }
+
+    int c = s->numero_quadros;
+    liberar_estruturas_politica(s);
+    s->num_nos = politica == SUBSTITUICAO_ARC ? 3 * c : c;
+    s->prox = (int*)malloc(s->num_nos * sizeof(int));
+    s->ant = (int*)malloc(s->num_nos * sizeof(int));
+    s->lista_do_no = (signed char*)malloc(s->num_nos * sizeof(signed char));
+    s->idade = (unsigned int*)calloc(c, sizeof(unsigned int));
+    int ok = s->prox && s->ant && s->lista_do_no && s->idade;
+
+    if (ok && politica == SUBSTITUICAO_ARC) {
+        s->tamanho_hash = 1;
+        while (s->tamanho_hash < 2 * c) {
+            s->tamanho_hash <<= 1;
+        }
+        s->fantasma_pid = (int*)malloc(2 * c * sizeof(int));
+        s->fantasma_pagina = (int*)malloc(2 * c * sizeof(int));
+        s->fantasmas_livres = (int*)malloc(2 * c * sizeof(int));
+        s->hash_prox = (int*)malloc(2 * c * sizeof(int));
+        s->hash_cabeca = (int*)malloc(s->tamanho_hash * sizeof(int));
+        ok = s->fantasma_pid && s->fantasma_pagina && s->fantasmas_livres && s->hash_prox && s->hash_cabeca;
+        if (ok) {
+            s->num_fantasmas_livres = 0;
+            for (int g = 3 * c - 1; g >= c; g--) {
+                s->fantasmas_livres[s->num_fantasmas_livres++] = g;
+            }
+            for (int h = 0; h < s->tamanho_hash; h++) {
+                s->hash_cabeca[h] = -1;
+            }
+        }
+    }
+
+    if (!ok) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar estruturas da politica de substituicao.\n");
+        liberar_estruturas_politica(s);
+        s->politica = SUBSTITUICAO_NENHUMA;
+        return 0;
+    }
+
+    for (int no = 0; no < s->num_nos; no++) {
+        s->lista_do_no[no] = LISTA_NENHUMA;
+    }
+    lista_limpar(&s->fifo);
+    lista_limpar(&s->t1);
+    lista_limpar(&s->t2);
+    lista_limpar(&s->b1);
+    lista_limpar(&s->b2);
+    s->ponteiro_clock = 0;
+    s->acessos_desde_envelhecimento = 0;
+    s->arc_p = 0;
+    s->arc_alvo_t2 = 0;
+    s->arc_em_b2 = 0;
+    s->vitima_pendente = -1;
+    s->politica = politica;
+
+    // Os quadros já ocupados entram nas novas estruturas como se tivessem acabado de ser carregados
+    for (int q = 0; q < c; q++) {
+        if (s->dono_pid[q] != -1) {
+            substituicao_registrar_carga(s, q, s->dono_pid[q], s->dono_pagina[q]);
+        }
+    }
+
+    s->acessos = 0;
+    s->acertos = 0;
+    s->faltas = 0;
+    s->despejos = 0;
+    s->writebacks = 0;
+
+    REGISTRAR_INFO("Politica de substituicao: %s\n", nome_politica_substituicao(politica));
+    return 1;
+}
+
+const char* nome_politica_substituicao(PoliticaSubstituicao politica) {
+    switch (politica) {
+        case SUBSTITUICAO_NENHUMA: return "nenhuma";
+        case SUBSTITUICAO_FIFO:    return "FIFO";
+        case SUBSTITUICAO_CLOCK:   return "Clock";
+        case SUBSTITUICAO_LRU:     return "LRU aproximado";
+        case SUBSTITUICAO_ARC:     return "ARC";
+        default:                   return "desconhecida";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Eventos de acesso, carga e liberação
+// ---------------------------------------------------------------------------
+
+// LRU aproximado: a cada intervalo, desloca o bit de referência de cada página para sua idade
+static void envelhecer(Substituidor *s, GerenciadorProcessos *gp) {
+    if (s->politica != SUBSTITUICAO_LRU ||
+        ++s->acessos_desde_envelhecimento < LRU_INTERVALO_ENVELHECIMENTO) {
+        return;
+    }
+    s->acessos_desde_envelhecimento = 0;
+    for (int q = 0; q < s->numero_quadros; q++) {
+        EntradaTabelaPagina *entrada = entrada_do_quadro(s, gp, q);
+        if (entrada) {
+            s->idade[q] = (s->idade[q] >> 1) | (consumir_referencia(s, entrada, q) ? 0x80000000u : 0);
+        }
+    }
+}
+
+void substituicao_registrar_acerto(Substituidor *s, GerenciadorProcessos *gp, int quadro) {
+    s->acessos++;
+    s->acertos++;
+    if (s->politica == SUBSTITUICAO_ARC) {
+        // Página acessada de novo passa para a lista de frequentes
+        lista_remover(s, quadro);
+        lista_inserir(s, LISTA_T2, quadro);
+    }
+    envelhecer(s, gp);
+}
+
+void substituicao_registrar_falta(Substituidor *s, GerenciadorProcessos *gp, int id_processo, int pagina) {
+    s->acessos++;
+    s->faltas++;
+    envelhecer(s, gp);
+    if (s->politica != SUBSTITUICAO_ARC) {
+        return;
+    }
+
+    int c = s->numero_quadros;
+    int g = buscar_fantasma(s, id_processo, pagina);
+    s->arc_alvo_t2 = g != -1;
+    s->arc_em_b2 = 0;
+    if (g != -1 && s->lista_do_no[g] == LISTA_B1) {
+        // Acerto em B1: T1 era pequena demais
+        int delta = s->b2.tamanho > s->b1.tamanho ? s->b2.tamanho / s->b1.tamanho : 1;
+        s->arc_p = s->arc_p + delta < c ? s->arc_p + delta : c;
+        remover_fantasma(s, g);
+    } else if (g != -1) {
+        // Acerto em B2: T2 era pequena demais
+        int delta = s->b1.tamanho > s->b2.tamanho ? s->b1.tamanho / s->b2.tamanho : 1;
+        s->arc_p = s->arc_p - delta > 0 ? s->arc_p - delta : 0;
+        s->arc_em_b2 = 1;
+        remover_fantasma(s, g);
+    } else if (s->t1.tamanho + s->b1.tamanho >= c && s->b1.tamanho > 0) {
+        remover_fantasma(s, s->b1.cauda);
+    } else if (s->t1.tamanho + s->t2.tamanho + s->b1.tamanho + s->b2.tamanho >= 2 * c && s->b2.tamanho > 0) {
+        remover_fantasma(s, s->b2.cauda);
+    }
+}
+
+void substituicao_registrar_carga(Substituidor *s, int quadro, int id_processo, int pagina) {
+    s->dono_pid[quadro] = id_processo;
+    s->dono_pagina[quadro] = pagina;
+    s->referencias_colhidas[quadro] = 0;
+
+    switch (s->politica) {
+        case SUBSTITUICAO_FIFO:
+            lista_inserir(s, LISTA_FIFO, quadro);
+            break;
+        case SUBSTITUICAO_LRU:
+            s->idade[quadro] = 0x80000000u; // Conta como referenciada no intervalo atual
+            break;
+        case SUBSTITUICAO_ARC:
+            lista_inserir(s, s->arc_alvo_t2 ? LISTA_T2 : LISTA_T1, quadro);
+            s->arc_alvo_t2 = 0;
+            s->arc_em_b2 = 0;
+            break;
+        default:
+            break;
+    }
+}
+
+void substituicao_registrar_liberacao(Substituidor *s, int quadro) {
+    if (quadro == s->vitima_pendente) {
+        // Despejo concluído: no ARC, a chave da página fica registrada como fantasma
+        s->vitima_pendente = -1;
+        s->despejos++;
+        if (s->politica == SUBSTITUICAO_ARC) {
+            int id_lista = s->lista_do_no[quadro] == LISTA_T1 ? LISTA_B1 : LISTA_B2;
+            lista_remover(s, quadro);
+            adicionar_fantasma(s, id_lista, s->dono_pid[quadro], s->dono_pagina[quadro]);
+        }
+    }
+    s->dono_pid[quadro] = -1;
+    s->dono_pagina[quadro] = -1;
+    s->referencias_colhidas[quadro] = 0;
+    if (s->lista_do_no && s->lista_do_no[quadro] != LISTA_NENHUMA) {
+        lista_remover(s, quadro);
+    }
+}
+
+void substituicao_marcar_referencia(Substituidor *s, int quadro) {
+    s->referencias_colhidas[quadro] |= REFERENCIA_PARA_POLITICA;
+}
+
+int substituicao_colher_referencia(Substituidor *s, int quadro) {
+    int referenciada = (s->referencias_colhidas[quadro] & REFERENCIA_PARA_AMOSTRA) != 0;
+    s->referencias_colhidas[quadro] &= ~REFERENCIA_PARA_AMOSTRA;
+    return referenciada;
+}
+
+void substituicao_transferir_quadro(Substituidor *s, int quadro, int id_processo, int pagina) {
+    s->dono_pid[quadro] = id_processo;
+    s->dono_pagina[quadro] = pagina;
+}
+
+void substituicao_migrar_quadro(Substituidor *s, int origem, int destino) {
+    s->dono_pid[destino] = s->dono_pid[origem];
+    s->dono_pagina[destino] = s->dono_pagina[origem];
+    s->referencias_colhidas[destino] = s->referencias_colhidas[origem];
+    s->dono_pid[origem] = -1;
+    s->dono_pagina[origem] = -1;
+    s->referencias_colhidas[origem] = 0;
+    if (!s->lista_do_no) {
+        return; // Estruturas da política não alocadas
+    }
+    s->idade[destino] = s->idade[origem];
+    s->idade[origem] = 0;
+
+    // O destino ocupa o lugar da origem na lista da política
+    s->lista_do_no[destino] = s->lista_do_no[origem];
+    ListaSubstituicao *lista = lista_por_id(s, s->lista_do_no[origem]);
+    if (lista) {
+        s->ant[destino] = s->ant[origem];
+        s->prox[destino] = s->prox[origem];
+        if (s->ant[origem] != -1) {
+            s->prox[s->ant[origem]] = destino;
+        } else {
+            lista->cabeca = destino;
+        }
+        if (s->prox[origem] != -1) {
+            s->ant[s->prox[origem]] = destino;
+        } else {
+            lista->cauda = destino;
+        }
+    }
+    s->lista_do_no[origem] = LISTA_NENHUMA;
+}
+
+void substituicao_esquecer_processo(Substituidor *s, int id_processo) {
+    if (s->politica != SUBSTITUICAO_ARC) {
+        return;
+    }
+    ListaSubstituicao *listas[2] = { &s->b1, &s->b2 };
+    for (int l = 0; l < 2; l++) {
+        int g = listas[l]->cabeca;
+        while (g != -1) {
+            int proximo = s->prox[g];
+            if (s->fantasma_pid[g - s->numero_quadros] == id_processo) {
+                remover_fantasma(s, g);
+            }
+            g = proximo;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Escolha da vítima
+// ---------------------------------------------------------------------------
+
+static int vitima_clock(Substituidor *s, GerenciadorProcessos *gp) {
+    // Duas voltas bastam: na primeira todos os bits de referência são zerados
+    for (int passo = 0; passo < 2 * s->numero_quadros + 1; passo++) {
+        int q = s->ponteiro_clock;
+        s->ponteiro_clock = (s->ponteiro_clock + 1) % s->numero_quadros;
+        EntradaTabelaPagina *entrada = entrada_do_quadro(s, gp, q);
+        if (!entrada) {
+            continue;
+        }
+        // Uma página referenciada perde a referência e ganha uma segunda chance
+        if (!consumir_referencia(s, entrada, q)) {
+            return q;
+        }
+    }
+    return -1;
+}
+
+static int vitima_lru(Substituidor *s) {
+    int vitima = -1;
+    for (int q = 0; q < s->numero_quadros; q++) {
+        if (s->dono_pid[q] != -1 && (vitima == -1 || s->idade[q] < s->idade[vitima])) {
+            vitima = q;
+        }
+    }
+    return vitima;
+}
+
+static int vitima_arc(Substituidor *s) {
+    int da_t1 = s->t1.tamanho > 0 &&
+                (s->t1.tamanho > s->arc_p || (s->arc_em_b2 && s->t1.tamanho == s->arc_p) || s->t2.tamanho == 0);
+    return da_t1 ? s->t1.cauda : s->t2.cauda;
+}
+
+int substituicao_escolher_vitima(Substituidor *s, GerenciadorProcessos *gp) {
+    int vitima = -1;
+    switch (s->politica) {
+        case SUBSTITUICAO_FIFO:
+            vitima = s->fifo.cauda;
+            break;
+        case SUBSTITUICAO_CLOCK:
+            vitima = vitima_clock(s, gp);
+            break;
+        case SUBSTITUICAO_LRU:
+            vitima = vitima_lru(s);
+            break;
+        case SUBSTITUICAO_ARC:
+            vitima = vitima_arc(s);
+            break;
+        default:
+            break;
+    }
+    s->vitima_pendente = vitima;
+    return vitima;
+}
+
+void substituicao_cancelar_despejo(Substituidor *s) {
+    s->vitima_pendente = -1;
+}
+
+void exibir_estatisticas_substituicao(Substituidor *s) {
+    printf("\n=== ESTATISTICAS DE SUBSTITUICAO ===\n");
+    printf("Politica: %s\n", nome_politica_substituicao(s->politica));
+    printf("Acessos: %lld\n", s->acessos);
+    printf("Acertos: %lld\n", s->acertos);
+    printf("Faltas de pagina: %lld\n", s->faltas);
+    printf("Taxa de acertos: %.2f%%\n", s->acessos > 0 ? (double)s->acertos / s->acessos * 100 : 0.0);
+    printf("Despejos: %lld\n", s->despejos);
+    printf("Writebacks de paginas modificadas: %lld\n", s->writebacks);
+    if (s->politica == SUBSTITUICAO_ARC) {
+        printf("ARC: |T1|=%d |T2|=%d |B1|=%d |B2|=%d p=%d\n",
+               s->t1.tamanho, s->t2.tamanho, s->b1.tamanho, s->b2.tamanho, s->arc_p);
+    }
+    printf("====================================\n\n");
+}
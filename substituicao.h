@@ -0,0 +1,225 @@
+#ifndef SUBSTITUICAO_H
+#define SUBSTITUICAO_H
+
+#include "memoria.h"
+#include "processo.h"
+
+// Número de acessos entre dois envelhecimentos do LRU aproximado
+#define LRU_INTERVALO_ENVELHECIMENTO 64
+
+// Marcas de referências colhidas de um quadro por quem não as usa
+#define REFERENCIA_PARA_POLITICA 0x1  // Bit limpo pela amostragem do conjunto de trabalho
+#define REFERENCIA_PARA_AMOSTRA 0x2   // Bit limpo pelo Clock ou pelo envelhecimento do LRU
+
+// Políticas de substituição de páginas
+typedef enum {
+    SUBSTITUICAO_NENHUMA = 0,         // Sem substituição: a alocação falha quando não há quadro livre
+    SUBSTITUICAO_FIFO = 1,            // Despeja a página carregada há mais tempo
+    SUBSTITUICAO_CLOCK = 2,           // Segunda chance, usando o bit de referência
+    SUBSTITUICAO_LRU = 3,             // LRU aproximado por envelhecimento (aging) dos bits de referência
+    SUBSTITUICAO_ARC = 4              // Adaptive Replacement Cache (listas T1/T2 e fantasmas B1/B2)
+} PoliticaSubstituicao;
+
+// Lista duplamente encadeada de nós (quadros ou entradas fantasmas), da mais recente à mais antiga
+typedef struct {
+    int cabeca;                       // Nó mais recente (MRU), -1 se vazia
+    int cauda;                        // Nó mais antigo (LRU), -1 se vazia
+    int tamanho;                      // Número de nós na lista
+} ListaSubstituicao;
+
+// Estado do mecanismo de substituição de páginas
+typedef struct Substituidor {
+    PoliticaSubstituicao politica;    // Política de escolha da vítima
+    int numero_quadros;               // Número de quadros da memória física
+    int *dono_pid;                    // Mapa reverso: processo dono de cada quadro (-1 se livre)
+    int *dono_pagina;                 // Mapa reverso: página do dono carregada em cada quadro
+    unsigned char *referencias_colhidas; // Marcas REFERENCIA_PARA_* de cada quadro
+
+    // Nós das listas: [0, numero_quadros) são quadros, os seguintes são entradas fantasmas do ARC
+    int num_nos;                      // Número de nós alocados
+    int *prox;                        // Próximo nó (em direção ao mais antigo)
+    int *ant;                         // Nó anterior (em direção ao mais recente)
+    signed char *lista_do_no;         // Lista em que cada nó está (-1 se em nenhuma)
+
+    ListaSubstituicao fifo;           // FIFO: ordem de carga dos quadros
+    int ponteiro_clock;               // Clock: próximo quadro a inspecionar
+    unsigned int *idade;              // LRU: contador de envelhecimento de cada quadro
+    long long acessos_desde_envelhecimento; // LRU: acessos desde o último envelhecimento
+
+    // ARC
+    ListaSubstituicao t1, t2, b1, b2; // Residentes recentes/frequentes e seus fantasmas
+    int arc_p;                        // Tamanho alvo de T1
+    int arc_alvo_t2;                  // 1 se a página da falta atual estava em B1/B2 (vai para T2)
+    int arc_em_b2;                    // 1 se a página da falta atual estava em B2
+    int *fantasma_pid;                // Chave (processo) de cada entrada fantasma
+    int *fantasma_pagina;             // Chave (página) de cada entrada fantasma
+    int *fantasmas_livres;            // Pilha de entradas fantasmas não usadas
+    int num_fantasmas_livres;
+    int *hash_cabeca;                 // Índice hash (pid, página) -> entrada fantasma
+    int *hash_prox;
+    int tamanho_hash;
+
+    int vitima_pendente;              // Vítima escolhida cujo quadro ainda não foi liberado (-1 se nenhuma)
+
+    // Estatísticas
+    long long acessos;                // Acessos traduzidos
+    long long acertos;                // Acessos a páginas presentes
+    long long faltas;                 // Acessos a páginas ausentes
+    long long despejos;               // Páginas despejadas para liberar quadros
+    long long writebacks;             // Despejos de páginas modificadas gravadas na memória lógica
+} Substituidor;
+
+/**
+ * @brief Cria o mecanismo de substituição para uma memória física.
+ *
+ * @param numero_quadros Número de quadros da memória física.
+ * @return Ponteiro para o substituidor, ou NULL em caso de erro.
+ */
+Substituidor* criar_substituidor(int numero_quadros);
+
+/**
+ * @brief Libera o mecanismo de substituição.
+ *
+ * @param s Ponteiro para o substituidor.
+ */
+void destruir_substituidor(Substituidor *s);
+
+/**
+ * @brief Troca a política de substituição, reconstruindo as estruturas com os quadros ocupados.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param politica A nova política.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int definir_politica_substituicao(Substituidor *s, PoliticaSubstituicao politica);
+
+/**
+ * @brief Retorna o nome legível de uma política de substituição.
+ *
+ * @param politica A política de substituição.
+ * @return Nome da política.
+ */
+const char* nome_politica_substituicao(PoliticaSubstituicao politica);
+
+/**
+ * @brief Registra um acesso a uma página presente (acerto).
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param quadro Quadro acessado.
+ */
+void substituicao_registrar_acerto(Substituidor *s, GerenciadorProcessos *gp, int quadro);
+
+/**
+ * @brief Registra uma falta de página, antes que um quadro seja obtido para ela.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @param id_processo Processo que sofreu a falta.
+ * @param pagina Página ausente.
+ */
+void substituicao_registrar_falta(Substituidor *s, GerenciadorProcessos *gp, int id_processo, int pagina);
+
+/**
+ * @brief Registra que uma página foi carregada em um quadro.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param quadro Quadro que recebeu a página.
+ * @param id_processo Processo dono da página.
+ * @param pagina Número da página.
+ */
+void substituicao_registrar_carga(Substituidor *s, int quadro, int id_processo, int pagina);
+
+/**
+ * @brief Registra que um quadro deixou de ser usado (página despejada ou processo removido).
+ *
+ * Se o quadro é a vítima escolhida por substituicao_escolher_vitima, o
+ * despejo é contado e, no ARC, a página ganha uma entrada fantasma em B1 ou B2.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param quadro Quadro liberado.
+ */
+void substituicao_registrar_liberacao(Substituidor *s, int quadro);
+
+/**
+ * @brief Guarda a referência de um quadro cujo bit foi limpo pela amostragem do conjunto de trabalho.
+ *
+ * A política e a amostragem disputam o mesmo bit de referência. Como o
+ * PG_young do Linux, quem limpa o bit deixa uma marca para o outro: o Clock e
+ * o LRU aproximado consultam esta marca junto com o bit, de modo que a
+ * amostragem não muda a escolha das vítimas.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param quadro Quadro cuja página estava referenciada.
+ */
+void substituicao_marcar_referencia(Substituidor *s, int quadro);
+
+/**
+ * @brief Consome a marca deixada pela política ao limpar o bit de referência de um quadro.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param quadro Quadro consultado.
+ * @return 1 se a política limpou o bit de uma referência desde a última consulta, 0 caso contrário.
+ */
+int substituicao_colher_referencia(Substituidor *s, int quadro);
+
+/**
+ * @brief Passa um quadro compartilhado para outra página que o mapeia.
+ *
+ * O quadro mantém sua posição nas estruturas da política; só o dono do mapa reverso muda.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param quadro Quadro compartilhado.
+ * @param id_processo Processo do novo dono do quadro.
+ * @param pagina Página do novo dono que mapeia o quadro.
+ */
+void substituicao_transferir_quadro(Substituidor *s, int quadro, int id_processo, int pagina);
+
+/**
+ * @brief Registra que o conteúdo de um quadro foi migrado para outro (compactação).
+ *
+ * O destino herda o dono, a idade, as marcas de referência e a posição da
+ * origem nas listas da política; a origem fica livre.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param origem Quadro de onde a página saiu.
+ * @param destino Quadro que recebeu a página.
+ */
+void substituicao_migrar_quadro(Substituidor *s, int origem, int destino);
+
+/**
+ * @brief Descarta as entradas fantasmas de um processo removido.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param id_processo ID do processo removido.
+ */
+void substituicao_esquecer_processo(Substituidor *s, int id_processo);
+
+/**
+ * @brief Escolhe o quadro a ser despejado segundo a política atual.
+ *
+ * A vítima continua nas estruturas da política até que seu quadro seja
+ * liberado (substituicao_registrar_liberacao); se o despejo falhar, quem
+ * chama deve desistir dela com substituicao_cancelar_despejo.
+ *
+ * @param s Ponteiro para o substituidor.
+ * @param gp Ponteiro para o gerenciador de processos.
+ * @return O quadro vítima, ou -1 se não houver quadro ocupado ou a política for NENHUMA.
+ */
+int substituicao_escolher_vitima(Substituidor *s, GerenciadorProcessos *gp);
+
+/**
+ * @brief Desiste da vítima escolhida, cujo despejo falhou; ela continua residente e nas listas da política.
+ *
+ * @param s Ponteiro para o substituidor.
+ */
+void substituicao_cancelar_despejo(Substituidor *s);
+
+/**
+ * @brief Exibe a política atual, a taxa de acertos e os despejos realizados.
+ *
+ * @param s Ponteiro para o substituidor.
+ */
+void exibir_estatisticas_substituicao(Substituidor *s);
+
+#endif // SUBSTITUICAO_H
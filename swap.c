@@ -0,0 +1,462 @@
+#include "swap.h"
+#include <string.h>
+#include <time.h>     // Para nanosleep
+#include <fcntl.h>    // Para open
+#include <unistd.h>   // Para pread, pwrite, ftruncate e close
+#include <errno.h>
+
+// Custo simulado de uma operação: latência fixa mais o tempo de transferência
+static long long custo_operacao_ns(const DispositivoSwap *swap, size_t bytes) {
+    long long custo = swap->latencia_ns;
+    if (swap->bytes_por_segundo > 0) {
+        custo += (long long)((double)bytes * 1e9 / (double)swap->bytes_por_segundo);
+    }
+    return custo;
+}
+
+// Dorme pelo custo simulado, descontando o tempo que a operação real já gastou
+static void simular_custo(long long custo_ns, long long inicio_ns) {
+    long long restante = custo_ns - (agora_ns() - inicio_ns);
+    if (restante <= 0) {
+        return;
+    }
+    struct timespec espera = { (time_t)(restante / 1000000000LL), (long)(restante % 1000000000LL) };
+    while (nanosleep(&espera, &espera) != 0 && errno == EINTR) {
+    }
+}
+
+int swap_faixa_histograma(long long valor) {
+    if (valor <= 0) {
+        return 0;
+    }
+    int faixa = 64 - __builtin_clzll((unsigned long long)valor);
+    return faixa < SWAP_FAIXAS_HISTOGRAMA ? faixa : SWAP_FAIXAS_HISTOGRAMA - 1;
+}
+
+long long swap_limite_faixa(int faixa) {
+    return 1LL << faixa;
+}
+
+// Escreve bytes no arquivo ou na região, a partir do slot indicado
+static int escrever_dispositivo(DispositivoSwap *swap, int slot, const unsigned char *dados, size_t bytes) {
+    size_t deslocamento = (size_t)slot * swap->tamanho_pagina;
+    if (swap->regiao) {
+        memcpy(swap->regiao + deslocamento, dados, bytes);
+        return 1;
+    }
+    while (bytes > 0) {
+        ssize_t escritos = pwrite(swap->descritor, dados, bytes, (off_t)deslocamento);
+        if (escritos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (escritos <= 0) {
+            return 0;
+        }
+        dados += escritos;
+        deslocamento += (size_t)escritos;
+        bytes -= (size_t)escritos;
+    }
+    return 1;
+}
+
+// Lê bytes do arquivo ou da região, a partir do slot indicado
+static int ler_dispositivo(DispositivoSwap *swap, int slot, unsigned char *destino, size_t bytes) {
+    size_t deslocamento = (size_t)slot * swap->tamanho_pagina;
+    if (swap->regiao) {
+        memcpy(destino, swap->regiao + deslocamento, bytes);
+        return 1;
+    }
+    while (bytes > 0) {
+        ssize_t lidos = pread(swap->descritor, destino, bytes, (off_t)deslocamento);
+        if (lidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (lidos <= 0) {
+            return 0;
+        }
+        destino += lidos;
+        deslocamento += (size_t)lidos;
+        bytes -= (size_t)lidos;
+    }
+    return 1;
+}
+
+// Escreve um lote de gravações: ordena por slot (mantendo a ordem de chegada
+// entre gravações do mesmo slot) e junta as de slots adjacentes numa escrita só
+static void escrever_lote(DispositivoSwap *swap, int *posicoes, int n) {
+    for (int i = 1; i < n; i++) {
+        int atual = posicoes[i], j = i - 1;
+        while (j >= 0 && swap->fila_slots[posicoes[j]] > swap->fila_slots[atual]) {
+            posicoes[j + 1] = posicoes[j];
+            j--;
+        }
+        posicoes[j + 1] = atual;
+    }
+
+    size_t tamanho_pagina = (size_t)swap->tamanho_pagina;
+    long long escritas = 0, inicio_lote = agora_ns();
+    for (int i = 0; i < n; ) {
+        // Grupo [i, fim) de slots consecutivos, sem repetir slot dentro do grupo
+        int primeiro = swap->fila_slots[posicoes[i]], fim = i + 1;
+        while (fim < n && swap->fila_slots[posicoes[fim]] == primeiro + (fim - i)) {
+            fim++;
+        }
+        int paginas = fim - i;
+        long long inicio_ns = agora_ns();
+        const unsigned char *dados = swap->fila_dados + (size_t)posicoes[i] * tamanho_pagina;
+        if (paginas > 1) {
+            for (int k = 0; k < paginas; k++) {
+                memcpy(swap->buffer_lote + (size_t)k * tamanho_pagina,
+                       swap->fila_dados + (size_t)posicoes[i + k] * tamanho_pagina, tamanho_pagina);
+            }
+            dados = swap->buffer_lote;
+        }
+        if (!escrever_dispositivo(swap, primeiro, dados, (size_t)paginas * tamanho_pagina)) {
+            REGISTRAR_ERRO("Falha ao escrever %d paginas no swap a partir do slot %d.\n", paginas, primeiro);
+        }
+        simular_custo(custo_operacao_ns(swap, (size_t)paginas * tamanho_pagina), inicio_ns);
+        escritas++;
+        i = fim;
+    }
+
+    pthread_mutex_lock(&swap->trava);
+    swap->estatisticas.escritas += escritas;
+    swap->estatisticas.paginas_gravadas += n;
+    swap->estatisticas.tempo_escrita_ns += agora_ns() - inicio_lote;
+    pthread_mutex_unlock(&swap->trava);
+}
+
+// Laço da thread de E/S: retira até SWAP_LOTE gravações do início da fila,
+// escreve-as fora da trava e só então as remove da fila
+static void* executar_thread_es(void *argumento) {
+    DispositivoSwap *swap = (DispositivoSwap*)argumento;
+    int posicoes[SWAP_LOTE];
+
+    pthread_mutex_lock(&swap->trava);
+    while (1) {
+        while (!swap->encerrar && swap->fila_pendentes == 0) {
+            pthread_cond_wait(&swap->tem_pedidos, &swap->trava);
+        }
+        if (swap->fila_pendentes == 0) {
+            break;
+        }
+        int n = swap->fila_pendentes < SWAP_LOTE ? swap->fila_pendentes : SWAP_LOTE;
+        for (int i = 0; i < n; i++) {
+            posicoes[i] = (swap->fila_inicio + i) % SWAP_FILA_CAPACIDADE;
+        }
+        pthread_mutex_unlock(&swap->trava);
+
+        escrever_lote(swap, posicoes, n);
+
+        pthread_mutex_lock(&swap->trava);
+        swap->fila_inicio = (swap->fila_inicio + n) % SWAP_FILA_CAPACIDADE;
+        swap->fila_pendentes -= n;
+        pthread_cond_broadcast(&swap->tem_espaco);
+    }
+    pthread_mutex_unlock(&swap->trava);
+    return NULL;
+}
+
+DispositivoSwap* criar_swap(const char *arquivo, size_t tamanho, int tamanho_pagina,
+                            long long latencia_ns, long long bytes_por_segundo) {
+    if (tamanho_pagina <= 0 || tamanho < (size_t)tamanho_pagina || latencia_ns < 0 || bytes_por_segundo < 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Parametros do swap invalidos.\n");
+        return NULL;
+    }
+    size_t num_slots = tamanho / (size_t)tamanho_pagina;
+    if (num_slots > (size_t)0x7FFFFFFF) {
+        RELATAR_ERRO(ERRO_TAMANHO_INVALIDO, "Swap grande demais: %zu slots.\n", num_slots);
+        return NULL;
+    }
+
+    DispositivoSwap *swap = (DispositivoSwap*)calloc(1, sizeof(DispositivoSwap));
+    if (!swap) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o dispositivo de swap.\n");
+        return NULL;
+    }
+    swap->descritor = -1;
+    swap->num_slots = (int)num_slots;
+    swap->tamanho = num_slots * (size_t)tamanho_pagina;
+    swap->tamanho_pagina = tamanho_pagina;
+    swap->latencia_ns = latencia_ns;
+    swap->bytes_por_segundo = bytes_por_segundo;
+
+    size_t palavras = (num_slots + 63) / 64;
+    swap->slot_livre = (uint64_t*)malloc(palavras * sizeof(uint64_t));
+    swap->fila_dados = (unsigned char*)malloc((size_t)SWAP_FILA_CAPACIDADE * tamanho_pagina);
+    swap->buffer_lote = (unsigned char*)malloc((size_t)SWAP_LOTE * tamanho_pagina);
+    if (!swap->slot_livre || !swap->fila_dados || !swap->buffer_lote) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar o dispositivo de swap.\n");
+        free(swap->slot_livre);
+        free(swap->fila_dados);
+        free(swap->buffer_lote);
+        free(swap);
+        return NULL;
+    }
+    memset(swap->slot_livre, 0xFF, palavras * sizeof(uint64_t));
+    if (num_slots % 64) {
+        swap->slot_livre[palavras - 1] = (1ULL << (num_slots % 64)) - 1;
+    }
+
+    int falhou = 0;
+    if (arquivo) {
+        swap->descritor = open(arquivo, O_RDWR | O_CREAT | O_TRUNC, 0600);
+        falhou = swap->descritor < 0 || ftruncate(swap->descritor, (off_t)swap->tamanho) != 0;
+        if (falhou) {
+            RELATAR_ERRO(ERRO_ARQUIVO, "Falha ao preparar o arquivo de swap %s.\n", arquivo);
+        }
+    } else {
+        swap->regiao = (unsigned char*)malloc(swap->tamanho);
+        falhou = !swap->regiao;
+        if (falhou) {
+            RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar a regiao de swap de %zu bytes.\n", swap->tamanho);
+        }
+    }
+
+    pthread_mutex_init(&swap->trava, NULL);
+    pthread_cond_init(&swap->tem_pedidos, NULL);
+    pthread_cond_init(&swap->tem_espaco, NULL);
+    if (!falhou && pthread_create(&swap->thread_es, NULL, executar_thread_es, swap) != 0) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao criar a thread de E/S do swap.\n");
+        falhou = 1;
+    }
+    if (falhou) {
+        if (swap->descritor >= 0) {
+            close(swap->descritor);
+        }
+        pthread_mutex_destroy(&swap->trava);
+        pthread_cond_destroy(&swap->tem_pedidos);
+        pthread_cond_destroy(&swap->tem_espaco);
+        free(swap->regiao);
+        free(swap->slot_livre);
+        free(swap->fila_dados);
+        free(swap->buffer_lote);
+        free(swap);
+        return NULL;
+    }
+
+    REGISTRAR_INFO("Swap de %zu bytes (%d slots) em %s criado.\n", swap->tamanho, swap->num_slots,
+                   arquivo ? arquivo : "memoria");
+    return swap;
+}
+
+void destruir_swap(DispositivoSwap *swap) {
+    if (!swap) {
+        return;
+    }
+    // A thread de E/S só sai com a fila vazia
+    pthread_mutex_lock(&swap->trava);
+    swap->encerrar = 1;
+    pthread_cond_signal(&swap->tem_pedidos);
+    pthread_mutex_unlock(&swap->trava);
+    pthread_join(swap->thread_es, NULL);
+
+    if (swap->descritor >= 0) {
+        close(swap->descritor);
+    }
+    pthread_mutex_destroy(&swap->trava);
+    pthread_cond_destroy(&swap->tem_pedidos);
+    pthread_cond_destroy(&swap->tem_espaco);
+    free(swap->regiao);
+    free(swap->slot_livre);
+    free(swap->fila_dados);
+    free(swap->buffer_lote);
+    free(swap);
+}
+
+// Reserva o próximo slot livre a partir do cursor (busca circular no mapa de bits)
+static int reservar_slot(DispositivoSwap *swap) {
+    if (swap->slots_em_uso >= swap->num_slots) {
+        return -1;
+    }
+    int palavras = (swap->num_slots + 63) / 64;
+    int palavra = swap->proximo_slot / 64;
+    // Na primeira palavra, ignora os bits antes do cursor; eles são revistos na volta
+    uint64_t mascara = ~0ULL << (swap->proximo_slot % 64);
+    for (int i = 0; i <= palavras; i++) {
+        uint64_t livres = swap->slot_livre[palavra] & mascara;
+        if (livres) {
+            int slot = palavra * 64 + __builtin_ctzll(livres);
+            swap->slot_livre[palavra] &= ~(1ULL << (slot % 64));
+            swap->slots_em_uso++;
+            swap->proximo_slot = slot + 1 < swap->num_slots ? slot + 1 : 0;
+            return slot;
+        }
+        palavra = (palavra + 1) % palavras;
+        mascara = ~0ULL;
+    }
+    return -1;
+}
+
+void swap_liberar_slot(DispositivoSwap *swap, int slot) {
+    if (!swap || slot < 0 || slot >= swap->num_slots) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Slot de swap invalido: %d.\n", slot);
+        return;
+    }
+    if (swap->slot_livre[slot / 64] & (1ULL << (slot % 64))) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Slot de swap %d ja esta livre.\n", slot);
+        return;
+    }
+    swap->slot_livre[slot / 64] |= 1ULL << (slot % 64);
+    swap->slots_em_uso--;
+}
+
+int swap_gravar_pagina(DispositivoSwap *swap, const unsigned char *dados) {
+    if (!swap || !dados) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Parametros invalidos para gravar no swap.\n");
+        return -1;
+    }
+    int slot = reservar_slot(swap);
+    if (slot == -1) {
+        REGISTRAR_DEPURACAO("Swap cheio (%d slots).\n", swap->num_slots);
+        return -1;
+    }
+
+    pthread_mutex_lock(&swap->trava);
+    if (swap->fila_pendentes == SWAP_FILA_CAPACIDADE) {
+        swap->estatisticas.esperas_fila_cheia++;
+        while (swap->fila_pendentes == SWAP_FILA_CAPACIDADE) {
+            pthread_cond_wait(&swap->tem_espaco, &swap->trava);
+        }
+    }
+    // A posição livre não faz parte do lote em escrita, então a cópia pode ser feita com a trava
+    int posicao = (swap->fila_inicio + swap->fila_pendentes) % SWAP_FILA_CAPACIDADE;
+    memcpy(swap->fila_dados + (size_t)posicao * swap->tamanho_pagina, dados, (size_t)swap->tamanho_pagina);
+    swap->fila_slots[posicao] = slot;
+    swap->fila_pendentes++;
+
+    EstatisticasSwap *e = &swap->estatisticas;
+    e->profundidade[swap_faixa_histograma(swap->fila_pendentes)]++;
+    if (swap->fila_pendentes > e->profundidade_maxima) {
+        e->profundidade_maxima = swap->fila_pendentes;
+    }
+    pthread_cond_signal(&swap->tem_pedidos);
+    pthread_mutex_unlock(&swap->trava);
+    return slot;
+}
+
+int swap_ler_pagina(DispositivoSwap *swap, int slot, unsigned char *destino) {
+    if (!swap || !destino || slot < 0 || slot >= swap->num_slots) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Parametros invalidos para ler do swap.\n");
+        return 0;
+    }
+
+    // Gravação ainda na fila: a cópia mais recente do slot está nela
+    pthread_mutex_lock(&swap->trava);
+    for (int i = swap->fila_pendentes - 1; i >= 0; i--) {
+        int posicao = (swap->fila_inicio + i) % SWAP_FILA_CAPACIDADE;
+        if (swap->fila_slots[posicao] == slot) {
+            memcpy(destino, swap->fila_dados + (size_t)posicao * swap->tamanho_pagina, (size_t)swap->tamanho_pagina);
+            swap->estatisticas.acertos_fila++;
+            pthread_mutex_unlock(&swap->trava);
+            return 1;
+        }
+    }
+    pthread_mutex_unlock(&swap->trava);
+
+    // Leitura síncrona; a thread de E/S não escreve neste slot, pois ele não está na fila
+    long long inicio_ns = agora_ns();
+    if (!ler_dispositivo(swap, slot, destino, (size_t)swap->tamanho_pagina)) {
+        RELATAR_ERRO(ERRO_ARQUIVO, "Falha ao ler o slot %d do swap.\n", slot);
+        return 0;
+    }
+    simular_custo(custo_operacao_ns(swap, (size_t)swap->tamanho_pagina), inicio_ns);
+
+    pthread_mutex_lock(&swap->trava);
+    swap->estatisticas.paginas_lidas++;
+    pthread_mutex_unlock(&swap->trava);
+    return 1;
+}
+
+void swap_esperar_gravacoes(DispositivoSwap *swap) {
+    if (!swap) {
+        return;
+    }
+    pthread_mutex_lock(&swap->trava);
+    while (swap->fila_pendentes > 0) {
+        pthread_cond_wait(&swap->tem_espaco, &swap->trava);
+    }
+    pthread_mutex_unlock(&swap->trava);
+}
+
+void swap_registrar_falta(DispositivoSwap *swap, long long latencia_ns, int do_swap) {
+    if (!swap) {
+        return;
+    }
+    pthread_mutex_lock(&swap->trava);
+    long long *histograma = do_swap ? swap->estatisticas.latencia_swap_in_ns : swap->estatisticas.latencia_outras_ns;
+    histograma[swap_faixa_histograma(latencia_ns)]++;
+    pthread_mutex_unlock(&swap->trava);
+}
+
+void swap_obter_estatisticas(DispositivoSwap *swap, EstatisticasSwap *destino) {
+    pthread_mutex_lock(&swap->trava);
+    *destino = swap->estatisticas;
+    pthread_mutex_unlock(&swap->trava);
+}
+
+long long swap_percentil(const long long *histograma, double fracao) {
+    long long total = 0;
+    for (int k = 0; k < SWAP_FAIXAS_HISTOGRAMA; k++) {
+        total += histograma[k];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    long long alvo = (long long)(fracao * (double)(total - 1)) + 1, acumulado = 0;
+    for (int k = 0; k < SWAP_FAIXAS_HISTOGRAMA; k++) {
+        acumulado += histograma[k];
+        if (acumulado >= alvo) {
+            return swap_limite_faixa(k);
+        }
+    }
+    return swap_limite_faixa(SWAP_FAIXAS_HISTOGRAMA - 1);
+}
+
+void swap_exibir_histograma(const char *titulo, const char *unidade, const long long *histograma) {
+    long long total = 0;
+    for (int k = 0; k < SWAP_FAIXAS_HISTOGRAMA; k++) {
+        total += histograma[k];
+    }
+    printf("%s (%lld amostras", titulo, total);
+    if (total > 0) {
+        printf(", p50 < %lld %s, p99 < %lld %s", swap_percentil(histograma, 0.50), unidade,
+               swap_percentil(histograma, 0.99), unidade);
+    }
+    printf("):\n");
+    for (int k = 0; k < SWAP_FAIXAS_HISTOGRAMA; k++) {
+        if (histograma[k] > 0) {
+            printf("  < %-14lld %10lld (%5.1f%%)\n", swap_limite_faixa(k), histograma[k],
+                   100.0 * (double)histograma[k] / (double)total);
+        }
+    }
+}
+
+void exibir_estatisticas_swap(DispositivoSwap *swap) {
+    if (!swap) {
+        printf("Swap desativado.\n");
+        return;
+    }
+    EstatisticasSwap e;
+    swap_obter_estatisticas(swap, &e);
+
+    printf("\n=== ESTATISTICAS DO SWAP ===\n");
+    printf("Dispositivo: %s, %zu bytes, %d slots (%d em uso)\n", swap->regiao ? "memoria" : "arquivo",
+           swap->tamanho, swap->num_slots, swap->slots_em_uso);
+    printf("Latencia simulada: %lld ns, largura de banda: ", swap->latencia_ns);
+    if (swap->bytes_por_segundo > 0) {
+        printf("%.1f MB/s\n", (double)swap->bytes_por_segundo / (1024.0 * 1024.0));
+    } else {
+        printf("ilimitada\n");
+    }
+    printf("Paginas gravadas (swap-out): %lld em %lld escritas (%.2f paginas por escrita)\n",
+           e.paginas_gravadas, e.escritas, e.escritas ? (double)e.paginas_gravadas / (double)e.escritas : 0.0);
+    printf("Paginas lidas do dispositivo (swap-in): %lld\n", e.paginas_lidas);
+    printf("Paginas recuperadas da fila: %lld\n", e.acertos_fila);
+    printf("Tempo da thread de E/S: %.3f ms\n", e.tempo_escrita_ns / 1e6);
+    printf("Profundidade maxima da fila: %d de %d (%lld esperas com a fila cheia)\n",
+           e.profundidade_maxima, SWAP_FILA_CAPACIDADE, e.esperas_fila_cheia);
+    swap_exibir_histograma("Profundidade da fila a cada gravacao", "pedidos", e.profundidade);
+    swap_exibir_histograma("Latencia das faltas atendidas pelo swap", "ns", e.latencia_swap_in_ns);
+    swap_exibir_histograma("Latencia das demais faltas", "ns", e.latencia_outras_ns);
+}
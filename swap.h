@@ -0,0 +1,179 @@
+#ifndef SWAP_H
+#define SWAP_H
+
+#include "erros.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// Gravações aguardando a thread de E/S (acima disso, quem despeja espera)
+#define SWAP_FILA_CAPACIDADE 256
+// Gravações retiradas da fila de uma vez pela thread de E/S
+#define SWAP_LOTE 32
+// Faixas dos histogramas: a faixa k conta valores em [2^(k-1), 2^k), e a 0 conta o valor 0
+#define SWAP_FAIXAS_HISTOGRAMA 48
+
+// Contadores do dispositivo de swap
+typedef struct {
+    long long paginas_gravadas;       // Páginas gravadas no dispositivo (swap-out)
+    long long paginas_lidas;          // Páginas lidas do dispositivo (swap-in)
+    long long acertos_fila;           // Páginas recuperadas da fila antes de chegarem ao dispositivo
+    long long escritas;               // Operações de escrita (cada uma com slots adjacentes)
+    long long esperas_fila_cheia;     // Gravações que esperaram espaço na fila
+    long long tempo_escrita_ns;       // Tempo da thread de E/S nas escritas, incluindo a latência simulada
+    int profundidade_maxima;          // Maior número de gravações pendentes observado
+    long long profundidade[SWAP_FAIXAS_HISTOGRAMA];      // Gravações pendentes a cada novo pedido
+    long long latencia_swap_in_ns[SWAP_FAIXAS_HISTOGRAMA]; // Faltas atendidas pelo swap
+    long long latencia_outras_ns[SWAP_FAIXAS_HISTOGRAMA];  // Demais faltas (geração ou cópia da memória lógica)
+} EstatisticasSwap;
+
+// Área de swap simulada: slots do tamanho de uma página em um arquivo ou em
+// uma região da memória do hospedeiro. As gravações são enfileiradas com uma
+// cópia da página e escritas por uma thread de E/S, em lotes ordenados por
+// slot em que slots adjacentes viram uma única escrita.
+typedef struct {
+    int descritor;                    // Arquivo de apoio (-1 se o swap é uma região de memória)
+    unsigned char *regiao;            // Região de memória (NULL se o swap é um arquivo)
+    size_t tamanho;                   // Tamanho em bytes
+    int tamanho_pagina;               // Tamanho de cada slot em bytes
+    int num_slots;                    // Número de slots
+    uint64_t *slot_livre;             // Mapa de bits dos slots (bit 1 para livre)
+    int proximo_slot;                 // Busca circular: slots consecutivos para despejos consecutivos
+    int slots_em_uso;                 // Slots ocupados
+    long long latencia_ns;            // Latência simulada de cada operação
+    long long bytes_por_segundo;      // Largura de banda simulada (0 = ilimitada)
+
+    // Fila de gravações (anel); as do lote em escrita só saem da fila quando terminam
+    int fila_slots[SWAP_FILA_CAPACIDADE]; // Slot de cada gravação
+    unsigned char *fila_dados;        // Cópia das páginas, SWAP_FILA_CAPACIDADE * tamanho_pagina bytes
+    int fila_inicio;                  // Gravação mais antiga
+    int fila_pendentes;               // Gravações na fila, incluindo o lote em escrita
+    unsigned char *buffer_lote;       // Buffer da thread de E/S para juntar slots adjacentes
+    pthread_t thread_es;              // Thread de E/S
+    pthread_mutex_t trava;            // Protege a fila e as estatísticas
+    pthread_cond_t tem_pedidos;       // Acorda a thread de E/S
+    pthread_cond_t tem_espaco;        // Avisa que a fila andou
+    int encerrar;                     // 1 quando o dispositivo está sendo destruído
+
+    EstatisticasSwap estatisticas;
+} DispositivoSwap;
+
+/**
+ * @brief Cria uma área de swap e sua thread de E/S.
+ *
+ * @param arquivo Caminho do arquivo de apoio, ou NULL para uma região da memória do hospedeiro.
+ * @param tamanho Tamanho da área em bytes.
+ * @param tamanho_pagina Tamanho de cada slot (o das páginas) em bytes.
+ * @param latencia_ns Latência simulada de cada leitura ou escrita, em nanossegundos.
+ * @param bytes_por_segundo Largura de banda simulada (0 para ilimitada).
+ * @return Ponteiro para o dispositivo, ou NULL em caso de erro.
+ */
+DispositivoSwap* criar_swap(const char *arquivo, size_t tamanho, int tamanho_pagina,
+                            long long latencia_ns, long long bytes_por_segundo);
+
+/**
+ * @brief Espera as gravações pendentes, encerra a thread de E/S e libera o dispositivo.
+ *
+ * @param swap Ponteiro para o dispositivo (pode ser NULL).
+ */
+void destruir_swap(DispositivoSwap *swap);
+
+/**
+ * @brief Reserva um slot e enfileira a gravação de uma página nele.
+ *
+ * A página é copiada para a fila, então o quadro pode ser reutilizado assim
+ * que a função retorna. Se a fila estiver cheia, espera a thread de E/S.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ * @param dados Conteúdo da página (tamanho_pagina bytes).
+ * @return Slot reservado, ou -1 se o swap estiver cheio.
+ */
+int swap_gravar_pagina(DispositivoSwap *swap, const unsigned char *dados);
+
+/**
+ * @brief Lê a página de um slot, da fila se a gravação ainda estiver pendente ou do dispositivo.
+ *
+ * A leitura do dispositivo é síncrona e inclui a latência simulada.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ * @param slot Slot da página.
+ * @param destino Destino (tamanho_pagina bytes).
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int swap_ler_pagina(DispositivoSwap *swap, int slot, unsigned char *destino);
+
+/**
+ * @brief Devolve um slot à área livre.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ * @param slot Slot a liberar.
+ */
+void swap_liberar_slot(DispositivoSwap *swap, int slot);
+
+/**
+ * @brief Espera até que todas as gravações enfileiradas tenham sido escritas.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ */
+void swap_esperar_gravacoes(DispositivoSwap *swap);
+
+/**
+ * @brief Registra a latência de atendimento de uma falta de página.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ * @param latencia_ns Duração da falta em nanossegundos.
+ * @param do_swap 1 se a página veio do swap, 0 se foi gerada ou copiada da memória lógica.
+ */
+void swap_registrar_falta(DispositivoSwap *swap, long long latencia_ns, int do_swap);
+
+/**
+ * @brief Copia as estatísticas do dispositivo de forma consistente com a thread de E/S.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ * @param destino Estrutura que recebe a cópia.
+ */
+void swap_obter_estatisticas(DispositivoSwap *swap, EstatisticasSwap *destino);
+
+/**
+ * @brief Faixa dos histogramas em que um valor cai.
+ *
+ * @param valor Valor medido.
+ * @return 0 para valores até 0, senão 1 + piso(log2(valor)), limitado à última faixa.
+ */
+int swap_faixa_histograma(long long valor);
+
+/**
+ * @brief Limite superior (exclusivo) de uma faixa dos histogramas.
+ *
+ * @param faixa Índice da faixa.
+ * @return 2^faixa (1 para a faixa 0).
+ */
+long long swap_limite_faixa(int faixa);
+
+/**
+ * @brief Percentil aproximado de um histograma: o limite superior da faixa onde ele cai.
+ *
+ * @param histograma Histograma com SWAP_FAIXAS_HISTOGRAMA faixas.
+ * @param fracao Percentil desejado, entre 0 e 1.
+ * @return Limite da faixa, ou 0 se o histograma estiver vazio.
+ */
+long long swap_percentil(const long long *histograma, double fracao);
+
+/**
+ * @brief Imprime as faixas não vazias de um histograma, com o total de amostras, p50 e p99.
+ *
+ * @param titulo Título do histograma.
+ * @param unidade Unidade dos valores (por exemplo, "ns").
+ * @param histograma Histograma com SWAP_FAIXAS_HISTOGRAMA faixas.
+ */
+void swap_exibir_histograma(const char *titulo, const char *unidade, const long long *histograma);
+
+/**
+ * @brief Exibe contadores, profundidade da fila e histogramas de latência das faltas.
+ *
+ * @param swap Ponteiro para o dispositivo.
+ */
+void exibir_estatisticas_swap(DispositivoSwap *swap);
+
+#endif // SWAP_H
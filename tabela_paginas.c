@@ -0,0 +1,322 @@
+#include "tabela_paginas.h"
+#include "erros.h"
+
+// Número inicial de baldes da tabela invertida
+#define TP_BALDES_INICIAIS 1024
+
+static void inicializar_entrada(EntradaTabelaPagina *entrada) {
+    *entrada = TP_ENTRADA_VAZIA;
+}
+
+// ---------------------------------------------------------------------------
+// Tabela invertida compartilhada
+// ---------------------------------------------------------------------------
+
+static NoTabelaInvertida* no_invertida(TabelaInvertida *invertida, int indice) {
+    return &invertida->blocos[indice >> TP_BITS_BLOCO_INVERTIDA][indice & (TP_NOS_POR_BLOCO_INVERTIDA - 1)];
+}
+
+static int balde_invertida(TabelaInvertida *invertida, int pid, int pagina) {
+    uint32_t h = (uint32_t)pid * 0x9E3779B1u ^ (uint32_t)pagina * 0x85EBCA6Bu;
+    h ^= h >> 15;
+    return (int)(h & (uint32_t)(invertida->num_baldes - 1));
+}
+
+TabelaInvertida* criar_tabela_invertida(void) {
+    TabelaInvertida *invertida = (TabelaInvertida*)calloc(1, sizeof(TabelaInvertida));
+    if (!invertida) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar a tabela de paginas invertida.\n");
+        return NULL;
+    }
+
+    invertida->num_baldes = TP_BALDES_INICIAIS;
+    invertida->baldes = (int*)malloc(invertida->num_baldes * sizeof(int));
+    if (!invertida->baldes) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar os baldes da tabela de paginas invertida.\n");
+        free(invertida);
+        return NULL;
+    }
+    for (int b = 0; b < invertida->num_baldes; b++) {
+        invertida->baldes[b] = -1;
+    }
+    invertida->livre = -1;
+    return invertida;
+}
+
+void destruir_tabela_invertida(TabelaInvertida *invertida) {
+    if (invertida) {
+        for (int i = 0; i < invertida->num_blocos; i++) {
+            free(invertida->blocos[i]);
+        }
+        free(invertida->blocos);
+        free(invertida->baldes);
+        free(invertida);
+    }
+}
+
+size_t bytes_tabela_invertida(TabelaInvertida *invertida) {
+    return (size_t)invertida->num_blocos * TP_NOS_POR_BLOCO_INVERTIDA * sizeof(NoTabelaInvertida) +
+           (size_t)invertida->num_baldes * sizeof(int);
+}
+
+// Dobra o número de baldes quando a carga média passa de dois nós por balde
+static void redimensionar_invertida(TabelaInvertida *invertida) {
+    int novo_num = invertida->num_baldes * 2;
+    int *novos = (int*)malloc(novo_num * sizeof(int));
+    if (!novos) {
+        return; // Continua com os baldes atuais, apenas mais carregados
+    }
+    for (int b = 0; b < novo_num; b++) {
+        novos[b] = -1;
+    }
+
+    int *antigos = invertida->baldes;
+    int num_antigos = invertida->num_baldes;
+    invertida->baldes = novos;
+    invertida->num_baldes = novo_num;
+    for (int b = 0; b < num_antigos; b++) {
+        int i = antigos[b];
+        while (i != -1) {
+            NoTabelaInvertida *no = no_invertida(invertida, i);
+            int prox = no->prox;
+            int balde = balde_invertida(invertida, no->pid, no->pagina);
+            no->prox = novos[balde];
+            novos[balde] = i;
+            i = prox;
+        }
+    }
+    free(antigos);
+}
+
+static NoTabelaInvertida* buscar_invertida(TabelaInvertida *invertida, int pid, int pagina) {
+    for (int i = invertida->baldes[balde_invertida(invertida, pid, pagina)]; i != -1; ) {
+        NoTabelaInvertida *no = no_invertida(invertida, i);
+        if (no->pid == pid && no->pagina == pagina) {
+            return no;
+        }
+        i = no->prox;
+    }
+    return NULL;
+}
+
+static NoTabelaInvertida* inserir_invertida(TabelaInvertida *invertida, int pid, int pagina) {
+    if (invertida->livre == -1) {
+        // Acrescenta um bloco de nós e os coloca na lista de livres
+        NoTabelaInvertida **blocos = (NoTabelaInvertida**)realloc(invertida->blocos,
+                                         (invertida->num_blocos + 1) * sizeof(NoTabelaInvertida*));
+        if (!blocos) {
+            return NULL;
+        }
+        invertida->blocos = blocos;
+        NoTabelaInvertida *bloco = (NoTabelaInvertida*)malloc(TP_NOS_POR_BLOCO_INVERTIDA * sizeof(NoTabelaInvertida));
+        if (!bloco) {
+            return NULL;
+        }
+        int base = invertida->num_blocos * TP_NOS_POR_BLOCO_INVERTIDA;
+        invertida->blocos[invertida->num_blocos++] = bloco;
+        for (int k = TP_NOS_POR_BLOCO_INVERTIDA - 1; k >= 0; k--) {
+            bloco[k].pid = -1;
+            bloco[k].prox = invertida->livre;
+            invertida->livre = base + k;
+        }
+    }
+
+    int i = invertida->livre;
+    NoTabelaInvertida *no = no_invertida(invertida, i);
+    invertida->livre = no->prox;
+
+    no->pid = pid;
+    no->pagina = pagina;
+    inicializar_entrada(&no->entrada);
+    int balde = balde_invertida(invertida, pid, pagina);
+    no->prox = invertida->baldes[balde];
+    invertida->baldes[balde] = i;
+    invertida->usados++;
+
+    if (invertida->usados > 2 * invertida->num_baldes) {
+        redimensionar_invertida(invertida);
+    }
+    return no;
+}
+
+static void remover_invertida(TabelaInvertida *invertida, int pid, int pagina) {
+    int *elo = &invertida->baldes[balde_invertida(invertida, pid, pagina)];
+    while (*elo != -1) {
+        int i = *elo;
+        NoTabelaInvertida *no = no_invertida(invertida, i);
+        if (no->pid == pid && no->pagina == pagina) {
+            *elo = no->prox;
+            no->pid = -1;
+            no->prox = invertida->livre;
+            invertida->livre = i;
+            invertida->usados--;
+            return;
+        }
+        elo = &no->prox;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Interface comum
+// ---------------------------------------------------------------------------
+
+int criar_tabela_paginas(TabelaPaginas *tabela, TipoTabelaPaginas tipo, int num_paginas, TabelaInvertida *invertida, int asid) {
+    tabela->tipo = tipo;
+    tabela->num_paginas = num_paginas;
+    tabela->entradas_em_uso = 0;
+    tabela->linear = NULL;
+    tabela->diretorio = NULL;
+    tabela->num_diretorio = 0;
+    tabela->invertida = NULL;
+    tabela->asid = asid;
+
+    switch (tipo) {
+        case TABELA_LINEAR:
+            tabela->linear = (EntradaTabelaPagina*)malloc(num_paginas * sizeof(EntradaTabelaPagina));
+            if (!tabela->linear) {
+                return 0;
+            }
+            for (int i = 0; i < num_paginas; i++) {
+                inicializar_entrada(&tabela->linear[i]);
+            }
+            tabela->entradas_em_uso = num_paginas;
+            return 1;
+
+        case TABELA_DOIS_NIVEIS:
+            // Só o diretório é alocado; as tabelas de segundo nível surgem no primeiro mapeamento
+            tabela->num_diretorio = (num_paginas + TP_ENTRADAS_SEGUNDO_NIVEL - 1) / TP_ENTRADAS_SEGUNDO_NIVEL;
+            tabela->diretorio = (EntradaTabelaPagina**)calloc(tabela->num_diretorio, sizeof(EntradaTabelaPagina*));
+            return tabela->diretorio != NULL;
+
+        case TABELA_INVERTIDA:
+            if (!invertida) {
+                return 0;
+            }
+            tabela->invertida = invertida;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+void destruir_tabela_paginas(TabelaPaginas *tabela) {
+    switch (tabela->tipo) {
+        case TABELA_LINEAR:
+            free(tabela->linear);
+            tabela->linear = NULL;
+            break;
+
+        case TABELA_DOIS_NIVEIS:
+            for (int d = 0; d < tabela->num_diretorio && tabela->diretorio; d++) {
+                free(tabela->diretorio[d]);
+            }
+            free(tabela->diretorio);
+            tabela->diretorio = NULL;
+            tabela->num_diretorio = 0;
+            break;
+
+        case TABELA_INVERTIDA:
+            if (tabela->invertida) {
+                // Percorre os nós da tabela compartilhada, cujo total é proporcional às
+                // páginas mapeadas, e não ao tamanho do espaço de endereçamento
+                TabelaInvertida *invertida = tabela->invertida;
+                int total = invertida->num_blocos * TP_NOS_POR_BLOCO_INVERTIDA;
+                for (int i = 0; i < total && tabela->entradas_em_uso > 0; i++) {
+                    NoTabelaInvertida *no = no_invertida(invertida, i);
+                    if (no->pid == tabela->asid) {
+                        remover_invertida(invertida, no->pid, no->pagina);
+                        tabela->entradas_em_uso--;
+                    }
+                }
+            }
+            tabela->invertida = NULL;
+            break;
+    }
+    tabela->entradas_em_uso = 0;
+    tabela->num_paginas = 0;
+}
+
+EntradaTabelaPagina* buscar_entrada_pagina(TabelaPaginas *tabela, int pagina) {
+    if (pagina < 0 || pagina >= tabela->num_paginas) {
+        return NULL;
+    }
+
+    switch (tabela->tipo) {
+        case TABELA_LINEAR:
+            return &tabela->linear[pagina];
+
+        case TABELA_DOIS_NIVEIS: {
+            EntradaTabelaPagina *segundo_nivel = tabela->diretorio[pagina >> TP_BITS_SEGUNDO_NIVEL];
+            if (!segundo_nivel) {
+                return NULL;
+            }
+            return &segundo_nivel[pagina & (TP_ENTRADAS_SEGUNDO_NIVEL - 1)];
+        }
+
+        case TABELA_INVERTIDA: {
+            NoTabelaInvertida *no = buscar_invertida(tabela->invertida, tabela->asid, pagina);
+            return no ? &no->entrada : NULL;
+        }
+
+        default:
+            return NULL;
+    }
+}
+
+EntradaTabelaPagina* obter_entrada_pagina(TabelaPaginas *tabela, int pagina) {
+    EntradaTabelaPagina *entrada = buscar_entrada_pagina(tabela, pagina);
+    if (entrada || pagina < 0 || pagina >= tabela->num_paginas) {
+        return entrada;
+    }
+
+    if (tabela->tipo == TABELA_DOIS_NIVEIS) {
+        int d = pagina >> TP_BITS_SEGUNDO_NIVEL;
+        EntradaTabelaPagina *segundo_nivel = (EntradaTabelaPagina*)malloc(TP_ENTRADAS_SEGUNDO_NIVEL * sizeof(EntradaTabelaPagina));
+        if (!segundo_nivel) {
+            RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar tabela de segundo nivel.\n");
+            return NULL;
+        }
+        for (int i = 0; i < TP_ENTRADAS_SEGUNDO_NIVEL; i++) {
+            inicializar_entrada(&segundo_nivel[i]);
+        }
+        tabela->diretorio[d] = segundo_nivel;
+        tabela->entradas_em_uso++;
+        return &segundo_nivel[pagina & (TP_ENTRADAS_SEGUNDO_NIVEL - 1)];
+    }
+
+    if (tabela->tipo == TABELA_INVERTIDA) {
+        NoTabelaInvertida *no = inserir_invertida(tabela->invertida, tabela->asid, pagina);
+        if (!no) {
+            RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao inserir entrada na tabela de paginas invertida.\n");
+            return NULL;
+        }
+        tabela->entradas_em_uso++;
+        return &no->entrada;
+    }
+
+    return NULL;
+}
+
+size_t bytes_tabela_paginas(TabelaPaginas *tabela) {
+    switch (tabela->tipo) {
+        case TABELA_LINEAR:
+            return (size_t)tabela->num_paginas * sizeof(EntradaTabelaPagina);
+        case TABELA_DOIS_NIVEIS:
+            return (size_t)tabela->num_diretorio * sizeof(EntradaTabelaPagina*) +
+                   (size_t)tabela->entradas_em_uso * TP_ENTRADAS_SEGUNDO_NIVEL * sizeof(EntradaTabelaPagina);
+        case TABELA_INVERTIDA:
+            return (size_t)tabela->entradas_em_uso * sizeof(NoTabelaInvertida);
+        default:
+            return 0;
+    }
+}
+
+const char* nome_tipo_tabela_paginas(TipoTabelaPaginas tipo) {
+    switch (tipo) {
+        case TABELA_LINEAR:      return "linear";
+        case TABELA_DOIS_NIVEIS: return "dois niveis";
+        case TABELA_INVERTIDA:   return "invertida (hash)";
+        default:                 return "desconhecida";
+    }
+}
@@ -0,0 +1,180 @@
+#ifndef TABELA_PAGINAS_H
+#define TABELA_PAGINAS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Bits do número da página usados para indexar uma tabela de segundo nível
+#define TP_BITS_SEGUNDO_NIVEL 10
+#define TP_ENTRADAS_SEGUNDO_NIVEL (1 << TP_BITS_SEGUNDO_NIVEL)
+
+// Nós da tabela invertida são alocados em blocos que nunca mudam de lugar,
+// para que os ponteiros para entradas continuem válidos quando a tabela cresce
+#define TP_BITS_BLOCO_INVERTIDA 12
+#define TP_NOS_POR_BLOCO_INVERTIDA (1 << TP_BITS_BLOCO_INVERTIDA)
+
+// Entrada da tabela de páginas compactada em 32 bits:
+//   bits 0-6  : bits de estado e de proteção (TP_PRESENTE, TP_MODIFICADA, ...)
+//   bits 7-31 : número do quadro físico (TP_SEM_QUADRO se a página não tem quadro)
+// O número de quadros endereçáveis é, portanto, limitado a TP_SEM_QUADRO (2^25 - 1):
+// criar_memoria_fisica_mapeada recusa memórias maiores, então todo quadro
+// alocado cabe no campo e entrada_definir_quadro nunca perde bits.
+typedef uint32_t EntradaTabelaPagina;
+
+#define TP_PRESENTE          (1u << 0) // Página presente na memória física
+#define TP_MODIFICADA        (1u << 1) // Página escrita desde que foi carregada
+#define TP_REFERENCIADA      (1u << 2) // Página acessada desde a última vez que o bit foi zerado
+#define TP_EM_MEMORIA_LOGICA (1u << 3) // A memória lógica guarda o conteúdo; caso contrário ele é gerado
+#define TP_LEITURA           (1u << 4) // Leitura permitida
+#define TP_ESCRITA           (1u << 5) // Escrita permitida
+#define TP_COPIA_NA_ESCRITA  (1u << 6) // Quadro compartilhado por fork: a primeira escrita copia a página
+
+#define TP_BITS_ESTADO 7
+#define TP_MASCARA_ESTADO ((1u << TP_BITS_ESTADO) - 1)
+#define TP_SEM_QUADRO ((1u << (32 - TP_BITS_ESTADO)) - 1)
+
+// Entrada de uma página ainda não mapeada: sem quadro, com leitura e escrita permitidas
+#define TP_ENTRADA_VAZIA ((TP_SEM_QUADRO << TP_BITS_ESTADO) | TP_LEITURA | TP_ESCRITA)
+
+// Quadro físico mapeado pela entrada, ou -1 se não houver
+static inline int entrada_quadro(EntradaTabelaPagina entrada) {
+    uint32_t quadro = entrada >> TP_BITS_ESTADO;
+    return quadro == TP_SEM_QUADRO ? -1 : (int)quadro;
+}
+
+// Define o quadro físico da entrada (-1 para nenhum, senão abaixo de TP_SEM_QUADRO), preservando os bits de estado
+static inline void entrada_definir_quadro(EntradaTabelaPagina *entrada, int quadro) {
+    uint32_t campo = quadro < 0 ? TP_SEM_QUADRO : (uint32_t)quadro;
+    *entrada = (campo << TP_BITS_ESTADO) | (*entrada & TP_MASCARA_ESTADO);
+}
+
+// 1 se algum dos bits indicados está ligado
+static inline int entrada_tem(EntradaTabelaPagina entrada, uint32_t bits) {
+    return (entrada & bits) != 0;
+}
+
+static inline void entrada_ativar(EntradaTabelaPagina *entrada, uint32_t bits) {
+    *entrada |= bits;
+}
+
+static inline void entrada_desativar(EntradaTabelaPagina *entrada, uint32_t bits) {
+    *entrada &= ~bits;
+}
+
+// Representações disponíveis para a tabela de páginas de um processo
+typedef enum {
+    TABELA_LINEAR = 0,                // Vetor com uma entrada por página, alocado na criação
+    TABELA_DOIS_NIVEIS = 1,           // Diretório + tabelas de segundo nível criadas sob demanda
+    TABELA_INVERTIDA = 2              // Tabela hash (pid, página) compartilhada por todos os processos
+} TipoTabelaPaginas;
+
+// Nó da tabela invertida
+typedef struct {
+    int pid;                          // Processo dono da entrada (-1 se o nó está livre)
+    int pagina;                       // Número da página virtual
+    int prox;                         // Próximo nó do mesmo balde, ou da lista de livres (-1 se fim)
+    EntradaTabelaPagina entrada;      // Entrada propriamente dita
+} NoTabelaInvertida;
+
+// Tabela invertida (hash) compartilhada pelos processos de um gerenciador
+typedef struct {
+    NoTabelaInvertida **blocos;       // Blocos de TP_NOS_POR_BLOCO_INVERTIDA nós
+    int num_blocos;                   // Número de blocos alocados
+    int livre;                        // Primeiro nó da lista de nós livres (-1 se vazia)
+    int usados;                       // Número de nós em uso
+    int *baldes;                      // Primeiro nó de cada balde (-1 se vazio)
+    int num_baldes;                   // Número de baldes (potência de dois)
+} TabelaInvertida;
+
+// Tabela de páginas de um processo, independente da representação
+typedef struct {
+    TipoTabelaPaginas tipo;           // Representação usada
+    int num_paginas;                  // Número de páginas do espaço de endereçamento
+    int entradas_em_uso;              // Entradas materializadas (tabelas de 2º nível ou nós da invertida)
+    EntradaTabelaPagina *linear;      // TABELA_LINEAR: vetor de entradas
+    EntradaTabelaPagina **diretorio;  // TABELA_DOIS_NIVEIS: tabelas de segundo nível (NULL se ausente)
+    int num_diretorio;                // TABELA_DOIS_NIVEIS: entradas do diretório
+    TabelaInvertida *invertida;       // TABELA_INVERTIDA: tabela compartilhada
+    int asid;                         // TABELA_INVERTIDA: processo dono das entradas
+} TabelaPaginas;
+
+/**
+ * @brief Cria a tabela de páginas de um processo.
+ *
+ * @param tabela Ponteiro para a tabela a ser inicializada.
+ * @param tipo Representação desejada.
+ * @param num_paginas Número de páginas do espaço de endereçamento.
+ * @param invertida Tabela invertida compartilhada (usada apenas com TABELA_INVERTIDA).
+ * @param asid ID do processo dono da tabela.
+ * @return 1 se sucesso, 0 se falhar.
+ */
+int criar_tabela_paginas(TabelaPaginas *tabela, TipoTabelaPaginas tipo, int num_paginas, TabelaInvertida *invertida, int asid);
+
+/**
+ * @brief Libera a tabela de páginas de um processo.
+ *
+ * @param tabela Ponteiro para a tabela.
+ */
+void destruir_tabela_paginas(TabelaPaginas *tabela);
+
+/**
+ * @brief Procura a entrada de uma página sem criá-la.
+ *
+ * @param tabela Ponteiro para a tabela.
+ * @param pagina Número da página.
+ * @return Ponteiro para a entrada, ou NULL se ela ainda não existe (página nunca mapeada).
+ */
+EntradaTabelaPagina* buscar_entrada_pagina(TabelaPaginas *tabela, int pagina);
+
+/**
+ * @brief Retorna a entrada de uma página, criando-a (ausente) se necessário.
+ *
+ * @param tabela Ponteiro para a tabela.
+ * @param pagina Número da página.
+ * @return Ponteiro para a entrada, ou NULL se faltar memória.
+ */
+EntradaTabelaPagina* obter_entrada_pagina(TabelaPaginas *tabela, int pagina);
+
+/**
+ * @brief Calcula a memória ocupada pela tabela de páginas de um processo.
+ *
+ * Para a tabela invertida, conta apenas os nós do processo; os baldes
+ * compartilhados são contados em bytes_tabela_invertida.
+ *
+ * @param tabela Ponteiro para a tabela.
+ * @return Tamanho em bytes.
+ */
+size_t bytes_tabela_paginas(TabelaPaginas *tabela);
+
+/**
+ * @brief Retorna o nome legível de uma representação de tabela de páginas.
+ *
+ * @param tipo A representação.
+ * @return Nome da representação.
+ */
+const char* nome_tipo_tabela_paginas(TipoTabelaPaginas tipo);
+
+/**
+ * @brief Cria uma tabela invertida vazia.
+ *
+ * @return Ponteiro para a tabela, ou NULL em caso de erro.
+ */
+TabelaInvertida* criar_tabela_invertida(void);
+
+/**
+ * @brief Libera uma tabela invertida.
+ *
+ * @param invertida Ponteiro para a tabela.
+ */
+void destruir_tabela_invertida(TabelaInvertida *invertida);
+
+/**
+ * @brief Calcula a memória total ocupada pela tabela invertida (nós e baldes).
+ *
+ * @param invertida Ponteiro para a tabela.
+ * @return Tamanho em bytes.
+ */
+size_t bytes_tabela_invertida(TabelaInvertida *invertida);
+
+#endif // TABELA_PAGINAS_H
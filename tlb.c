@@ -0,0 +1,137 @@
+#include "tlb.h"
+#include "erros.h"
+
+TLB* criar_tlb(int num_entradas, int associatividade, int limpar_na_troca) {
+    if (num_entradas <= 0 || associatividade <= 0 || num_entradas % associatividade != 0) {
+        RELATAR_ERRO(ERRO_PARAMETRO_INVALIDO, "Configuracao de TLB invalida (%d entradas, associatividade %d).\n",
+                     num_entradas, associatividade);
+        return NULL;
+    }
+
+    TLB *tlb = (TLB*)calloc(1, sizeof(TLB));
+    if (!tlb) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar a TLB.\n");
+        return NULL;
+    }
+
+    tlb->entradas = (EntradaTLB*)calloc(num_entradas, sizeof(EntradaTLB));
+    if (!tlb->entradas) {
+        RELATAR_ERRO(ERRO_SEM_MEMORIA, "Falha ao alocar as entradas da TLB.\n");
+        free(tlb);
+        return NULL;
+    }
+
+    tlb->num_conjuntos = num_entradas / associatividade;
+    tlb->associatividade = associatividade;
+    tlb->limpar_na_troca = limpar_na_troca ? 1 : 0;
+    tlb->asid_atual = -1;
+
+    REGISTRAR_INFO("TLB criada: %d entradas, %d conjuntos de %d vias, %s na troca de contexto.\n",
+                   num_entradas, tlb->num_conjuntos, associatividade,
+                   tlb->limpar_na_troca ? "esvaziada" : "mantida (ASID)");
+    return tlb;
+}
+
+void destruir_tlb(TLB *tlb) {
+    if (tlb) {
+        free(tlb->entradas);
+        free(tlb);
+    }
+}
+
+// Primeira entrada do conjunto ao qual a página pertence
+static EntradaTLB* conjunto_da_pagina(TLB *tlb, int pagina) {
+    return &tlb->entradas[(pagina % tlb->num_conjuntos) * tlb->associatividade];
+}
+
+int tlb_buscar(TLB *tlb, int asid, int pagina) {
+    EntradaTLB *conjunto = conjunto_da_pagina(tlb, pagina);
+    tlb->relogio++;
+
+    for (int via = 0; via < tlb->associatividade; via++) {
+        EntradaTLB *entrada = &conjunto[via];
+        if (entrada->valida && entrada->asid == asid && entrada->pagina == pagina) {
+            entrada->ultimo_uso = tlb->relogio;
+            tlb->acertos++;
+            return entrada->quadro;
+        }
+    }
+
+    tlb->faltas++;
+    return -1;
+}
+
+void tlb_inserir(TLB *tlb, int asid, int pagina, int quadro) {
+    EntradaTLB *conjunto = conjunto_da_pagina(tlb, pagina);
+
+    // Usa uma via livre ou, se todas estiverem ocupadas, a menos usada recentemente
+    EntradaTLB *vitima = &conjunto[0];
+    for (int via = 0; via < tlb->associatividade; via++) {
+        EntradaTLB *entrada = &conjunto[via];
+        if (!entrada->valida) {
+            vitima = entrada;
+            break;
+        }
+        if (entrada->ultimo_uso < vitima->ultimo_uso) {
+            vitima = entrada;
+        }
+    }
+
+    vitima->valida = 1;
+    vitima->asid = asid;
+    vitima->pagina = pagina;
+    vitima->quadro = quadro;
+    vitima->ultimo_uso = tlb->relogio;
+}
+
+void tlb_invalidar(TLB *tlb, int asid, int pagina) {
+    EntradaTLB *conjunto = conjunto_da_pagina(tlb, pagina);
+    for (int via = 0; via < tlb->associatividade; via++) {
+        if (conjunto[via].valida && conjunto[via].asid == asid && conjunto[via].pagina == pagina) {
+            conjunto[via].valida = 0;
+        }
+    }
+}
+
+void tlb_invalidar_asid(TLB *tlb, int asid) {
+    int total = tlb->num_conjuntos * tlb->associatividade;
+    for (int i = 0; i < total; i++) {
+        if (tlb->entradas[i].asid == asid) {
+            tlb->entradas[i].valida = 0;
+        }
+    }
+}
+
+void tlb_limpar(TLB *tlb) {
+    int total = tlb->num_conjuntos * tlb->associatividade;
+    for (int i = 0; i < total; i++) {
+        tlb->entradas[i].valida = 0;
+    }
+    tlb->limpezas++;
+}
+
+void tlb_trocar_contexto(TLB *tlb, int asid) {
+    if (asid == tlb->asid_atual) {
+        return;
+    }
+    tlb->asid_atual = asid;
+    tlb->trocas_contexto++;
+    if (tlb->limpar_na_troca) {
+        tlb_limpar(tlb);
+    }
+}
+
+void exibir_estatisticas_tlb(TLB *tlb) {
+    long long consultas = tlb->acertos + tlb->faltas;
+
+    printf("\n=== ESTATISTICAS DA TLB ===\n");
+    printf("Entradas: %d (%d conjuntos x %d vias)\n",
+           tlb->num_conjuntos * tlb->associatividade, tlb->num_conjuntos, tlb->associatividade);
+    printf("Troca de contexto: %s\n", tlb->limpar_na_troca ? "esvazia a TLB" : "mantem entradas (ASID)");
+    printf("Consultas: %lld\n", consultas);
+    printf("Acertos: %lld\n", tlb->acertos);
+    printf("Faltas: %lld\n", tlb->faltas);
+    printf("Taxa de acertos: %.2f%%\n", consultas > 0 ? (double)tlb->acertos / consultas * 100 : 0.0);
+    printf("Trocas de contexto: %lld, esvaziamentos: %lld\n", tlb->trocas_contexto, tlb->limpezas);
+    printf("===========================\n\n");
+}
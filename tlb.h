@@ -0,0 +1,106 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Entrada da TLB: mapeamento página -> quadro de um espaço de endereçamento
+typedef struct {
+    int valida;                       // 1 se a entrada está em uso
+    int asid;                         // Identificador do espaço de endereçamento (ID do processo)
+    int pagina;                       // Número da página virtual
+    int quadro;                       // Quadro físico mapeado
+    long long ultimo_uso;             // Instante do último uso, para o LRU dentro do conjunto
+} EntradaTLB;
+
+// TLB associativa por conjuntos
+typedef struct {
+    EntradaTLB *entradas;             // num_conjuntos * associatividade entradas
+    int num_conjuntos;                // Número de conjuntos
+    int associatividade;              // Entradas (vias) por conjunto
+    int limpar_na_troca;              // 1 se a TLB é esvaziada a cada troca de contexto
+    int asid_atual;                   // Processo cujo espaço está ativo (-1 se nenhum)
+    long long relogio;                // Contador de acessos usado como carimbo de LRU
+    long long acertos;                // Traduções resolvidas pela TLB
+    long long faltas;                 // Traduções que precisaram consultar a tabela de páginas
+    long long trocas_contexto;        // Número de trocas de contexto observadas
+    long long limpezas;               // Número de vezes em que a TLB foi esvaziada
+} TLB;
+
+/**
+ * @brief Cria uma TLB associativa por conjuntos.
+ *
+ * @param num_entradas Número total de entradas (múltiplo da associatividade).
+ * @param associatividade Entradas por conjunto (1 = mapeamento direto, num_entradas = totalmente associativa).
+ * @param limpar_na_troca 1 para esvaziar a TLB a cada troca de contexto, 0 para manter as entradas marcadas por ASID.
+ * @return Ponteiro para a TLB, ou NULL em caso de erro.
+ */
+TLB* criar_tlb(int num_entradas, int associatividade, int limpar_na_troca);
+
+/**
+ * @brief Libera a TLB.
+ *
+ * @param tlb Ponteiro para a TLB.
+ */
+void destruir_tlb(TLB *tlb);
+
+/**
+ * @brief Procura a tradução de uma página.
+ *
+ * @param tlb Ponteiro para a TLB.
+ * @param asid ID do processo.
+ * @param pagina Número da página virtual.
+ * @return O quadro mapeado, ou -1 se a tradução não estiver na TLB.
+ */
+int tlb_buscar(TLB *tlb, int asid, int pagina);
+
+/**
+ * @brief Insere uma tradução, substituindo a entrada menos usada do conjunto se necessário.
+ *
+ * @param tlb Ponteiro para a TLB.
+ * @param asid ID do processo.
+ * @param pagina Número da página virtual.
+ * @param quadro Quadro físico mapeado.
+ */
+void tlb_inserir(TLB *tlb, int asid, int pagina, int quadro);
+
+/**
+ * @brief Invalida a tradução de uma página (por exemplo, após um despejo).
+ *
+ * @param tlb Ponteiro para a TLB.
+ * @param asid ID do processo.
+ * @param pagina Número da página virtual.
+ */
+void tlb_invalidar(TLB *tlb, int asid, int pagina);
+
+/**
+ * @brief Invalida todas as traduções de um processo.
+ *
+ * @param tlb Ponteiro para a TLB.
+ * @param asid ID do processo.
+ */
+void tlb_invalidar_asid(TLB *tlb, int asid);
+
+/**
+ * @brief Esvazia a TLB.
+ *
+ * @param tlb Ponteiro para a TLB.
+ */
+void tlb_limpar(TLB *tlb);
+
+/**
+ * @brief Informa à TLB qual processo está executando, esvaziando-a se configurada para isso.
+ *
+ * @param tlb Ponteiro para a TLB.
+ * @param asid ID do processo que passa a executar.
+ */
+void tlb_trocar_contexto(TLB *tlb, int asid);
+
+/**
+ * @brief Exibe a configuração e os contadores de acertos e faltas da TLB.
+ *
+ * @param tlb Ponteiro para a TLB.
+ */
+void exibir_estatisticas_tlb(TLB *tlb);
+
+#endif // TLB_H